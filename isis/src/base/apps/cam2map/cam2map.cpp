@@ -1,12 +1,19 @@
 #include "cam2map.h"
 
+#include <cmath>
+
+#include <QMutexLocker>
+#include <QVector>
+
 #include "Camera.h"
 #include "CubeAttribute.h"
 #include "IException.h"
 #include "IString.h"
+#include "NaifStatus.h"
 #include "ProjectionFactory.h"
 #include "PushFrameCameraDetectorMap.h"
 #include "Pvl.h"
+#include "PvlKeyword.h"
 #include "Target.h"
 #include "TProjection.h"
 
@@ -307,6 +314,11 @@ namespace Isis {
     // We will need a transform class
     Transform *transform = 0;
 
+    // The reverse transform can be approximated with a grid. Band dependent
+    // cameras need the exact transform since it changes with the band.
+    bool approximate = ui.GetBoolean("APPROXIMATE") && incam->IsBandIndependent();
+    cam2mapApproximate *approximation = NULL;
+
     // Okay we need to decide how to apply the rubbersheeting for the transform
     // Does the user want to define how it is done?
     if (ui.GetString("WARPALGORITHM") == "FORWARDPATCH") {
@@ -316,7 +328,9 @@ namespace Isis {
                                      samples,
                                      lines,
                                      outmap,
-                                     trim);
+                                     trim,
+                                     icube,
+                                     ocube);
 
       int patchSize = ui.GetInteger("PATCHSIZE");
       if (patchSize <= 1) {
@@ -330,7 +344,12 @@ namespace Isis {
     else if (ui.GetString("WARPALGORITHM") == "REVERSEPATCH") {
       transform = new cam2mapReverse(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
-                                     outmap, trim, occlusion);
+                                     outmap, trim, occlusion, icube, ocube);
+      if (approximate) {
+        approximation = new cam2mapApproximate(transform, icube->sampleCount(),
+                                               icube->lineCount(), ui.GetDouble("TOLERANCE"));
+        transform = approximation;
+      }
 
       int patchSize = ui.GetInteger("PATCHSIZE");
       int minPatchSize = 4;
@@ -348,22 +367,29 @@ namespace Isis {
     else if (incam->GetCameraType() == Camera::Framing) {
       transform = new cam2mapReverse(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
-                                     outmap, trim, occlusion);
+                                     outmap, trim, occlusion, icube, ocube);
+      if (approximate) {
+        approximation = new cam2mapApproximate(transform, icube->sampleCount(),
+                                               icube->lineCount(), ui.GetDouble("TOLERANCE"));
+        transform = approximation;
+      }
       p.SetTiling(4, 4);
       p.StartProcess(*transform, *interp);
     }
 
     // The user didn't want to override the program smarts.
     // Handle linescan cameras.  Always process using the forward
-    // driven patch option. Faster and we get better orthorectification
+    // driven patch option. Faster and we get better orthorectification.
+    // If the user wants the approximation, fall through to the reverse
+    // driven system below since the grid approximates the reverse transform.
     //
     // TODO:  For now use the default patch size.  Need to modify
     // to determine patch size based on 1) if the limb is in the file
     // or 2) if the DTM is much coarser than the image
-    else if (incam->GetCameraType() == Camera::LineScan) {
+    else if (incam->GetCameraType() == Camera::LineScan && !approximate) {
       transform = new cam2mapForward(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
-                                     outmap, trim);
+                                     outmap, trim, icube, ocube);
 
       p.processPatchTransform(*transform, *interp);
     }
@@ -380,7 +406,7 @@ namespace Isis {
     else if (incam->GetCameraType() == Camera::PushFrame) {
       transform = new cam2mapForward(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
-                                     outmap, trim);
+                                     outmap, trim, icube, ocube);
 
       // Get the frame height
       PushFrameCameraDetectorMap *dmap = (PushFrameCameraDetectorMap *) incam->DetectorMap();
@@ -419,7 +445,12 @@ namespace Isis {
     else {
       transform = new cam2mapReverse(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
-                                     outmap, trim, occlusion);
+                                     outmap, trim, occlusion, icube, ocube);
+      if (approximate) {
+        approximation = new cam2mapApproximate(transform, icube->sampleCount(),
+                                               icube->lineCount(), ui.GetDouble("TOLERANCE"));
+        transform = approximation;
+      }
 
       int tileStart, tileEnd;
       incam->GetGeometricTilingHint(tileStart, tileEnd);
@@ -434,6 +465,9 @@ namespace Isis {
     // add mapping to print.prt
     if(log) {
       log->addLogGroup(cleanMapping);
+      if (approximation) {
+        log->addLogGroup(approximation->statistics());
+      }
     }
 
     // Cleanup
@@ -446,7 +480,7 @@ namespace Isis {
   cam2mapForward::cam2mapForward(const int inputSamples, const int inputLines,
                                  Camera *incam, const int outputSamples,
                                  const int outputLines, TProjection *outmap,
-                                 bool trim) {
+                                 bool trim, Cube *incube, Cube *outcube) {
     p_inputSamples = inputSamples;
     p_inputLines = inputLines;
     p_incam = incam;
@@ -456,11 +490,52 @@ namespace Isis {
     p_outmap = outmap;
 
     p_trim = trim;
+
+    p_incube = incube;
+    p_outcube = outcube;
+    p_ownsCameraAndMap = false;
+
+    // Cameras that evaluate cached SPICE without NAIF do not need the NAIF lock
+    p_naifMutex = incam->evaluatesWithoutNaif() ? NULL : NaifStatus::mutex();
+  }
+
+  // Transform object destructor, clones delete their camera and projection
+  cam2mapForward::~cam2mapForward() {
+    if (p_ownsCameraAndMap) {
+      delete p_incam;
+      delete p_outmap;
+    }
+  }
+
+  // Copy the transform with its own camera and projection so another thread can use it
+  Transform *cam2mapForward::clone() const {
+    if (!p_incube || !p_outcube) {
+      return NULL;
+    }
+
+    TProjection *outmap = (TProjection *) ProjectionFactory::CreateFromCube(*p_outcube);
+    Camera *incam = NULL;
+    try {
+      incam = p_incam->clone(*p_incube);
+    }
+    catch (IException &e) {
+      delete outmap;
+      throw;
+    }
+
+    cam2mapForward *copy = new cam2mapForward(p_inputSamples, p_inputLines, incam,
+                                              p_outputSamples, p_outputLines, outmap,
+                                              p_trim, p_incube, p_outcube);
+    copy->p_ownsCameraAndMap = true;
+    return copy;
   }
 
   // Transform method mapping input line/samps to lat/lons to output line/samps
   bool cam2mapForward::Xform(double &outSample, double &outLine,
                              const double inSample, const double inLine) {
+    // Clones are evaluated on several threads, so cameras that still use NAIF hold its lock
+    QMutexLocker naifLocker(p_naifMutex);
+
     // See if the input image coordinate converts to a lat/lon
     if (!p_incam->SetImage(inSample,inLine)) {
       return false;
@@ -506,7 +581,7 @@ namespace Isis {
   cam2mapReverse::cam2mapReverse(const int inputSamples, const int inputLines,
                                  Camera *incam, const int outputSamples,
                                  const int outputLines, TProjection *outmap,
-                                 bool trim, bool occlusion) {
+                                 bool trim, bool occlusion, Cube *incube, Cube *outcube) {
     p_inputSamples = inputSamples;
     p_inputLines = inputLines;
     p_incam = incam;
@@ -517,11 +592,52 @@ namespace Isis {
 
     p_trim = trim;
     p_occlusion = occlusion;
+
+    p_incube = incube;
+    p_outcube = outcube;
+    p_ownsCameraAndMap = false;
+
+    // Cameras that evaluate cached SPICE without NAIF do not need the NAIF lock
+    p_naifMutex = incam->evaluatesWithoutNaif() ? NULL : NaifStatus::mutex();
+  }
+
+  // Transform object destructor, clones delete their camera and projection
+  cam2mapReverse::~cam2mapReverse() {
+    if (p_ownsCameraAndMap) {
+      delete p_incam;
+      delete p_outmap;
+    }
+  }
+
+  // Copy the transform with its own camera and projection so another thread can use it
+  Transform *cam2mapReverse::clone() const {
+    if (!p_incube || !p_outcube) {
+      return NULL;
+    }
+
+    TProjection *outmap = (TProjection *) ProjectionFactory::CreateFromCube(*p_outcube);
+    Camera *incam = NULL;
+    try {
+      incam = p_incam->clone(*p_incube);
+    }
+    catch (IException &e) {
+      delete outmap;
+      throw;
+    }
+
+    cam2mapReverse *copy = new cam2mapReverse(p_inputSamples, p_inputLines, incam,
+                                              p_outputSamples, p_outputLines, outmap,
+                                              p_trim, p_occlusion, p_incube, p_outcube);
+    copy->p_ownsCameraAndMap = true;
+    return copy;
   }
 
   // Transform method mapping output line/samps to lat/lons to input line/samps
   bool cam2mapReverse::Xform(double &inSample, double &inLine,
                              const double outSample, const double outLine) {
+    // Clones are evaluated on several threads, so cameras that still use NAIF hold its lock
+    QMutexLocker naifLocker(p_naifMutex);
+
     // See if the output image coordinate converts to lat/lon
     if (!p_outmap->SetWorld(outSample, outLine)) return false;
 
@@ -569,6 +685,287 @@ namespace Isis {
     return p_outputLines;
   }
 
+  //! The grid of exact input coordinates over one block of the output image
+  struct cam2mapApproximate::Block {
+    int startSample; //!< The first output sample of the block
+    int startLine;   //!< The first output line of the block
+    int spacing;     //!< The number of output pixels between nodes
+    int cellSamples; //!< The number of grid cells across the block
+    int cellLines;   //!< The number of grid cells down the block
+    //! Input samples at the nodes, with a ring of nodes outside the block
+    QVector<double> nodeSamples;
+    //! Input lines at the nodes, with a ring of nodes outside the block
+    QVector<double> nodeLines;
+    //! Whether each cell uses the exact transform
+    QVector<bool> exactCells;
+  };
+
+  //! The blocks of a cam2mapApproximate, shared with its clones
+  struct cam2mapApproximate::Grid {
+    int outputSamples;       //!< The number of output samples
+    int outputLines;         //!< The number of output lines
+    int blockSamples;        //!< The number of blocks across the output image
+    int blockLines;          //!< The number of blocks down the output image
+    QVector<Block> blocks;   //!< The blocks in line major order
+    double maximumError;     //!< The largest spot check error of an interpolated cell
+    BigInt exactEvaluations; //!< The number of exact transforms to build the grid
+    BigInt interpolatedCells; //!< The number of cells that are interpolated
+    BigInt exactCells;       //!< The number of cells that use the exact transform
+  };
+
+  // Transform object constructor, builds the grid with the exact transform
+  cam2mapApproximate::cam2mapApproximate(Transform *exact, const int inputSamples,
+                                         const int inputLines, const double tolerance) {
+    if (tolerance <= 0.0) {
+      QString msg = "The approximation tolerance [" + toString(tolerance) +
+                    "] must be greater than zero";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    p_exact = exact;
+    p_inputSamples = inputSamples;
+    p_inputLines = inputLines;
+    p_tolerance = tolerance;
+
+    p_grid = QSharedPointer<Grid>(new Grid);
+    p_grid->outputSamples = exact->OutputSamples();
+    p_grid->outputLines = exact->OutputLines();
+    p_grid->blockSamples = (p_grid->outputSamples + s_blockSize - 1) / s_blockSize;
+    p_grid->blockLines = (p_grid->outputLines + s_blockSize - 1) / s_blockSize;
+    p_grid->maximumError = 0.0;
+    p_grid->exactEvaluations = 0;
+    p_grid->interpolatedCells = 0;
+    p_grid->exactCells = 0;
+
+    p_grid->blocks.resize(p_grid->blockSamples * p_grid->blockLines);
+    for (int blockLine = 0; blockLine < p_grid->blockLines; blockLine++) {
+      for (int blockSample = 0; blockSample < p_grid->blockSamples; blockSample++) {
+        Block &block = p_grid->blocks[blockLine * p_grid->blockSamples + blockSample];
+        block.startSample = blockSample * s_blockSize + 1;
+        block.startLine = blockLine * s_blockSize + 1;
+        buildBlock(block,
+                   qMin(s_blockSize, p_grid->outputSamples - block.startSample + 1),
+                   qMin(s_blockSize, p_grid->outputLines - block.startLine + 1));
+      }
+    }
+  }
+
+  // Constructor for clones, which share the grid
+  cam2mapApproximate::cam2mapApproximate(Transform *exact, const int inputSamples,
+                                         const int inputLines, const double tolerance,
+                                         QSharedPointer<Grid> grid) {
+    p_exact = exact;
+    p_inputSamples = inputSamples;
+    p_inputLines = inputLines;
+    p_tolerance = tolerance;
+    p_grid = grid;
+  }
+
+  // Transform object destructor, deletes the exact transform
+  cam2mapApproximate::~cam2mapApproximate() {
+    delete p_exact;
+  }
+
+  // Copy the transform with a copy of the exact transform so another thread can use it
+  Transform *cam2mapApproximate::clone() const {
+    Transform *exact = p_exact->clone();
+    if (!exact) {
+      return NULL;
+    }
+
+    return new cam2mapApproximate(exact, p_inputSamples, p_inputLines, p_tolerance, p_grid);
+  }
+
+  /**
+   * Builds the grid of one block, halving the node spacing until the spot
+   * check at the center of every cell is within the tolerance or the
+   * spacing reaches its minimum.
+   *
+   * @param block The block to build, with its start sample and line set
+   * @param blockSamples The number of output samples in the block
+   * @param blockLines The number of output lines in the block
+   */
+  void cam2mapApproximate::buildBlock(Block &block, int blockSamples, int blockLines) {
+    for (int spacing = s_maximumSpacing; ; spacing /= 2) {
+      block.spacing = spacing;
+      block.cellSamples = (blockSamples + spacing - 1) / spacing;
+      block.cellLines = (blockLines + spacing - 1) / spacing;
+
+      // Compute the exact transform at the nodes, including a ring of nodes
+      // around the block for the bicubic interpolation of its edge cells
+      int nodeSamples = block.cellSamples + 3;
+      int nodeLines = block.cellLines + 3;
+      block.nodeSamples.fill(0.0, nodeSamples * nodeLines);
+      block.nodeLines.fill(0.0, nodeSamples * nodeLines);
+      QVector<bool> validNodes(nodeSamples * nodeLines, false);
+      for (int j = 0; j < nodeLines; j++) {
+        for (int i = 0; i < nodeSamples; i++) {
+          int node = j * nodeSamples + i;
+          validNodes[node] = p_exact->Xform(block.nodeSamples[node], block.nodeLines[node],
+                                            block.startSample + (i - 1) * spacing,
+                                            block.startLine + (j - 1) * spacing);
+          p_grid->exactEvaluations++;
+        }
+      }
+
+      // Spot check the center of each cell against the exact transform
+      block.exactCells.fill(false, block.cellSamples * block.cellLines);
+      QVector<double> errors(block.cellSamples * block.cellLines, 0.0);
+      bool refine = false;
+      for (int j = 0; j < block.cellLines; j++) {
+        for (int i = 0; i < block.cellSamples; i++) {
+          int cell = j * block.cellSamples + i;
+
+          bool nodesValid = true;
+          for (int nj = j; nj < j + 4 && nodesValid; nj++) {
+            for (int ni = i; ni < i + 4 && nodesValid; ni++) {
+              nodesValid = validNodes[nj * nodeSamples + ni];
+            }
+          }
+
+          double exactSample, exactLine;
+          if (nodesValid) {
+            p_grid->exactEvaluations++;
+            nodesValid = p_exact->Xform(exactSample, exactLine,
+                                        block.startSample + (i + 0.5) * spacing,
+                                        block.startLine + (j + 0.5) * spacing);
+          }
+          if (!nodesValid) {
+            block.exactCells[cell] = true;
+            continue;
+          }
+
+          double inSample, inLine;
+          interpolate(block, i, j, 0.5, 0.5, inSample, inLine);
+          errors[cell] = sqrt((inSample - exactSample) * (inSample - exactSample) +
+                              (inLine - exactLine) * (inLine - exactLine));
+          if (errors[cell] > p_tolerance) {
+            block.exactCells[cell] = true;
+            refine = true;
+          }
+        }
+      }
+
+      if (refine && spacing > s_minimumSpacing) {
+        continue;
+      }
+
+      for (int cell = 0; cell < block.exactCells.size(); cell++) {
+        if (block.exactCells[cell]) {
+          p_grid->exactCells++;
+        }
+        else {
+          p_grid->interpolatedCells++;
+          p_grid->maximumError = qMax(p_grid->maximumError, errors[cell]);
+        }
+      }
+      return;
+    }
+  }
+
+  /**
+   * Interpolates the input coordinate in a grid cell with Catmull-Rom
+   * bicubic interpolation of the 4x4 nodes around it.
+   *
+   * @param block The block the cell is in
+   * @param cellSample The cell's index across the block
+   * @param cellLine The cell's index down the block
+   * @param sampleFraction The fraction of the way across the cell
+   * @param lineFraction The fraction of the way down the cell
+   * @param inSample The interpolated input sample
+   * @param inLine The interpolated input line
+   */
+  void cam2mapApproximate::interpolate(const Block &block, int cellSample, int cellLine,
+                                       double sampleFraction, double lineFraction,
+                                       double &inSample, double &inLine) const {
+    double sampleWeights[4];
+    double lineWeights[4];
+    double *weights[2] = {sampleWeights, lineWeights};
+    double fractions[2] = {sampleFraction, lineFraction};
+    for (int k = 0; k < 2; k++) {
+      double t = fractions[k];
+      weights[k][0] = ((-t + 2.0) * t - 1.0) * t / 2.0;
+      weights[k][1] = ((3.0 * t - 5.0) * t * t + 2.0) / 2.0;
+      weights[k][2] = ((-3.0 * t + 4.0) * t + 1.0) * t / 2.0;
+      weights[k][3] = (t - 1.0) * t * t / 2.0;
+    }
+
+    int nodeSamples = block.cellSamples + 3;
+    inSample = 0.0;
+    inLine = 0.0;
+    for (int j = 0; j < 4; j++) {
+      double rowSample = 0.0;
+      double rowLine = 0.0;
+      int node = (cellLine + j) * nodeSamples + cellSample;
+      for (int i = 0; i < 4; i++) {
+        rowSample += sampleWeights[i] * block.nodeSamples[node + i];
+        rowLine += sampleWeights[i] * block.nodeLines[node + i];
+      }
+      inSample += lineWeights[j] * rowSample;
+      inLine += lineWeights[j] * rowLine;
+    }
+  }
+
+  // Transform method interpolating output line/samps to input line/samps
+  bool cam2mapApproximate::Xform(double &inSample, double &inLine,
+                                 const double outSample, const double outLine) {
+    // Pixels outside the output image are not in the grid
+    if (outSample < 0.5 || outLine < 0.5 ||
+        outSample > p_grid->outputSamples + 0.5 || outLine > p_grid->outputLines + 0.5) {
+      return p_exact->Xform(inSample, inLine, outSample, outLine);
+    }
+
+    int blockSample = qBound(0, (int) floor((outSample - 0.5) / s_blockSize),
+                             p_grid->blockSamples - 1);
+    int blockLine = qBound(0, (int) floor((outLine - 0.5) / s_blockSize),
+                           p_grid->blockLines - 1);
+    const Block &block = p_grid->blocks[blockLine * p_grid->blockSamples + blockSample];
+
+    double cellSample = (outSample - block.startSample) / block.spacing;
+    double cellLine = (outLine - block.startLine) / block.spacing;
+    int i = qBound(0, (int) floor(cellSample), block.cellSamples - 1);
+    int j = qBound(0, (int) floor(cellLine), block.cellLines - 1);
+    if (block.exactCells[j * block.cellSamples + i]) {
+      return p_exact->Xform(inSample, inLine, outSample, outLine);
+    }
+
+    interpolate(block, i, j, cellSample - i, cellLine - j, inSample, inLine);
+
+    // Make sure the point is inside the input image
+    if (inSample < 0.5) return false;
+    if (inLine < 0.5) return false;
+    if (inSample > p_inputSamples + 0.5) return false;
+    if (inLine > p_inputLines + 0.5) return false;
+
+    return true;
+  }
+
+  int cam2mapApproximate::OutputSamples() const {
+    return p_grid->outputSamples;
+  }
+
+  int cam2mapApproximate::OutputLines() const {
+    return p_grid->outputLines;
+  }
+
+  /**
+   * Reports how well the grid approximates the exact transform.
+   *
+   * @return PvlGroup An Approximation group with the tolerance, the largest
+   *                  spot check error of the interpolated cells, the number
+   *                  of exact transforms the grid took and the number of
+   *                  interpolated and exact cells.
+   */
+  PvlGroup cam2mapApproximate::statistics() const {
+    PvlGroup results("Approximation");
+    results += PvlKeyword("Tolerance", toString(p_tolerance), "pixels");
+    results += PvlKeyword("MaximumSpotCheckError", toString(p_grid->maximumError), "pixels");
+    results += PvlKeyword("ExactEvaluations", toString(p_grid->exactEvaluations));
+    results += PvlKeyword("InterpolatedCells", toString(p_grid->interpolatedCells));
+    results += PvlKeyword("ExactCells", toString(p_grid->exactCells));
+    return results;
+  }
+
   void bandChange(const int band) {
     // band dependant band change
     incam->SetBand(band);
@@ -1,7 +1,12 @@
 #ifndef cam2map_h
 #define cam2map_h
 
+#include <QSharedPointer>
+
+class QRecursiveMutex;
+
 #include "Application.h"
+#include "PvlGroup.h"
 #include "TProjection.h"
 #include "Transform.h"
 #include "UserInterface.h"
@@ -31,6 +36,10 @@ namespace Isis {
       bool p_occlusion;
       int p_outputSamples;
       int p_outputLines;
+      Cube *p_incube;
+      Cube *p_outcube;
+      bool p_ownsCameraAndMap;
+      QRecursiveMutex *p_naifMutex;
 
     public:
       // constructor
@@ -39,16 +48,19 @@ namespace Isis {
                      const int outputSamples, const int outputLines,
                      TProjection *outmap,
                      bool trim,
-                     bool occlusion=false);
+                     bool occlusion=false,
+                     Cube *incube=NULL,
+                     Cube *outcube=NULL);
 
       // destructor
-      ~cam2mapReverse() {};
+      ~cam2mapReverse();
 
       // Implementations for parent's pure virtual members
       bool Xform(double &inSample, double &inLine,
                  const double outSample, const double outLine);
       int OutputSamples() const;
       int OutputLines() const;
+      Transform *clone() const;
   };
 
   /**
@@ -65,6 +77,10 @@ namespace Isis {
       bool p_trim;
       int p_outputSamples;
       int p_outputLines;
+      Cube *p_incube;
+      Cube *p_outcube;
+      bool p_ownsCameraAndMap;
+      QRecursiveMutex *p_naifMutex;
 
     public:
       // constructor
@@ -72,16 +88,80 @@ namespace Isis {
                      Camera *incam,
                      const int outputSamples, const int outputLines,
                      TProjection *outmap,
-                     bool trim);
+                     bool trim,
+                     Cube *incube=NULL,
+                     Cube *outcube=NULL);
 
       // destructor
-      ~cam2mapForward() {};
+      ~cam2mapForward();
 
       // Implementations for parent's pure virtual members
       bool Xform(double &outSample, double &outLine,
                  const double inSample, const double inLine);
       int OutputSamples() const;
       int OutputLines() const;
+      Transform *clone() const;
+  };
+
+  /**
+   * Approximates an output to input transform, such as cam2mapReverse, by
+   * bicubic interpolation between exact input coordinates computed at the
+   * nodes of a grid over the output image.
+   *
+   * The output image is split into blocks and each block gets its own grid.
+   * A block's node spacing starts at 64 output pixels and is halved, down to
+   * 4 pixels, until the interpolation at the center of every grid cell is
+   * within the tolerance of the exact transform. Cells that still miss the
+   * tolerance, and cells whose spot check or neighboring nodes the exact
+   * transform cannot compute, use the exact transform for every pixel.
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class cam2mapApproximate : public Transform {
+    public:
+      // constructor
+      cam2mapApproximate(Transform *exact, const int inputSamples,
+                         const int inputLines, const double tolerance);
+
+      // destructor
+      ~cam2mapApproximate();
+
+      // Implementations for parent's pure virtual members
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine);
+      int OutputSamples() const;
+      int OutputLines() const;
+      Transform *clone() const;
+
+      PvlGroup statistics() const;
+
+    private:
+      struct Block;
+      struct Grid;
+
+      cam2mapApproximate(Transform *exact, const int inputSamples,
+                         const int inputLines, const double tolerance,
+                         QSharedPointer<Grid> grid);
+
+      void buildBlock(Block &block, int blockSamples, int blockLines);
+      void interpolate(const Block &block, int cellSample, int cellLine,
+                       double sampleFraction, double lineFraction,
+                       double &inSample, double &inLine) const;
+
+      Transform *p_exact;
+      int p_inputSamples;
+      int p_inputLines;
+      double p_tolerance;
+      QSharedPointer<Grid> p_grid;
+
+      //! Number of output pixels on a side of a block
+      static const int s_blockSize = 256;
+      //! Node spacing each block starts with
+      static const int s_maximumSpacing = 64;
+      //! Smallest node spacing a block is refined to
+      static const int s_minimumSpacing = 4;
   };
 }
 
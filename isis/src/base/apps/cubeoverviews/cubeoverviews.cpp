@@ -0,0 +1,103 @@
+#include "cubeoverviews.h"
+
+#include <algorithm>
+
+#include "Brick.h"
+#include "IException.h"
+#include "Progress.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  void cubeoverviews(UserInterface &ui) {
+    Cube cube;
+    cube.open(ui.GetCubeName("FROM"), "rw");
+
+    cubeoverviews(&cube, ui);
+    cube.close();
+  }
+
+
+  void cubeoverviews(Cube *cube, UserInterface &ui) {
+    int minimumSize = ui.GetInteger("MINIMUMSIZE");
+
+    // Rebuild every level so none of them are stale
+    cube->deleteOverviews();
+
+    int largestDimension = max(cube->sampleCount(), cube->lineCount());
+    QList<int> reductionFactors;
+    for (int reductionFactor = 2; largestDimension / reductionFactor >= minimumSize;
+         reductionFactor *= 2) {
+      reductionFactors.append(reductionFactor);
+    }
+
+    if (reductionFactors.isEmpty()) {
+      QString msg = "The cube [" + ui.GetCubeName("FROM") + "] is too small to have overviews "
+                    "of at least [" + toString(minimumSize) + "] pixels";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    Progress progress;
+    progress.SetText("Building overviews");
+    progress.SetMaximumSteps(reductionFactors.size() * cube->bandCount());
+    progress.CheckStatus();
+
+    // Each level averages 2x2 blocks of the previous level, so every level
+    //   reads a quarter of the pixels the one before it did.
+    int fromFactor = 1;
+    int fromSamples = cube->sampleCount();
+    int fromLines = cube->lineCount();
+    int bands = cube->bandCount();
+
+    foreach (int reductionFactor, reductionFactors) {
+      cube->addOverview(reductionFactor);
+      int samples = cube->overviewSampleCount(reductionFactor);
+      int lines = cube->overviewLineCount(reductionFactor);
+
+      Brick in(fromSamples, fromLines, bands, fromSamples, 2, 1, cube->pixelType());
+      Brick out(samples, lines, bands, samples, 1, 1, cube->pixelType());
+
+      for (int band = 1; band <= bands; band++) {
+        for (int line = 1; line <= lines; line++) {
+          // Lines past the end of the previous level are read as NULLs
+          in.SetBasePosition(1, 2 * line - 1, band);
+          if (fromFactor == 1) {
+            cube->read(in);
+          }
+          else {
+            cube->read(in, fromFactor);
+          }
+
+          for (int sample = 0; sample < samples; sample++) {
+            double sum = 0.0;
+            int validCount = 0;
+
+            for (int blockLine = 0; blockLine < 2; blockLine++) {
+              for (int blockSample = 2 * sample;
+                   blockSample < min(2 * sample + 2, fromSamples); blockSample++) {
+                double dn = in[blockLine * fromSamples + blockSample];
+                if (!IsSpecial(dn)) {
+                  sum += dn;
+                  validCount++;
+                }
+              }
+            }
+
+            out[sample] = (validCount > 0) ? sum / validCount : Null;
+          }
+
+          out.SetBasePosition(1, line, band);
+          cube->write(out, reductionFactor);
+        }
+
+        progress.CheckStatus();
+      }
+
+      fromFactor = reductionFactor;
+      fromSamples = samples;
+      fromLines = lines;
+    }
+  }
+}
@@ -0,0 +1,13 @@
+#ifndef cubeoverviews_h
+#define cubeoverviews_h
+
+#include "Cube.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void cubeoverviews(UserInterface &ui);
+
+  extern void cubeoverviews(Cube *cube, UserInterface &ui);
+}
+
+#endif
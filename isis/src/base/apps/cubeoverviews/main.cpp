@@ -0,0 +1,13 @@
+#include "Isis.h"
+
+#include "cubeoverviews.h"
+
+#include "Application.h"
+
+using namespace std;
+using namespace Isis;
+
+void IsisMain() {
+  UserInterface &ui = Application::GetUserInterface();
+  cubeoverviews(ui);
+}
@@ -1,8 +1,7 @@
 #include "Isis.h"
 #include "ProcessByBoxcar.h"
+#include "RankWindow.h"
 #include "SpecialPixel.h"
-#include <algorithm>
-#include <vector>
 
 using namespace std;
 using namespace Isis;
@@ -17,9 +16,9 @@ double high;
 bool propagate;
 unsigned int  minimum;
 
-void FilterAll(Buffer &in, double &v);
-void FilterValid(Buffer &in, double &v);
-void FilterInvalid(Buffer &in, double &v);
+void FilterAll(RankWindow &window, double &v);
+void FilterValid(RankWindow &window, double &v);
+void FilterInvalid(RankWindow &window, double &v);
 
 void IsisMain() {
   //Set up ProcessByBoxcar
@@ -65,15 +64,15 @@ void IsisMain() {
 
   //Check for filter style, and process accordingly
   if(ui.GetString("FILTER") == "ALL") {
-    p.StartProcess(FilterAll);
+    p.StartProcess(FilterAll, low, high);
     p.EndProcess();
   }
   else if(ui.GetString("FILTER") == "INSIDE") {
-    p.StartProcess(FilterValid);
+    p.StartProcess(FilterValid, low, high);
     p.EndProcess();
   }
   else if(ui.GetString("FILTER") == "OUTSIDE") {
-    p.StartProcess(FilterInvalid);
+    p.StartProcess(FilterInvalid, low, high);
     p.EndProcess();
   }
 }
@@ -81,8 +80,8 @@ void IsisMain() {
 //Function which loops through every pixel in the boxcar,
 //and outputs the median value to the center pixel, if
 //the center pixel is valid.
-void FilterValid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
+void FilterValid(RankWindow &window, double &v) {
+  double centerPixel = window.center();
 
   //Check if the center pixel is a Special Pixel type to be
   //filtered. If not, ignore the pixel and move on
@@ -113,21 +112,11 @@ void FilterValid(Buffer &in, double &v) {
     return;
   }
 
-  //Build a vector containing the non-Special pixel values
-  //from the input buffer. If there are not enough to meet
-  //the minimum requirements, write a user-selected value
-  //to the center. If there are, sort the vector and write
-  //the median value to the center.
-  std::vector<double> boxdata(0);
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  //If there are not enough valid pixels in the window to
+  //meet the minimum requirements, write a user-selected value
+  //to the center. If there are, write the median value of
+  //the window to the center.
+  if((unsigned int) window.count() < minimum || window.count() == 0) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -137,15 +126,14 @@ void FilterValid(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  v = window.median();
 }
 
 //Function to loop through the boxcar and find and write
 //the median value to the center pixel, but only if the
 //center pixel is invalid
-void FilterInvalid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
+void FilterInvalid(RankWindow &window, double &v) {
+  double centerPixel = window.center();
 
   //Check for Special Pixels and handle according to user
   //input.
@@ -176,21 +164,10 @@ void FilterInvalid(Buffer &in, double &v) {
     return;
   }
 
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
+  //Find the median value of the valid pixels in the window.
   //If there aren't enough to meet the minimum requirements,
   //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  if((unsigned int) window.count() < minimum || window.count() == 0) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -200,15 +177,14 @@ void FilterInvalid(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  v = window.median();
 }
 
 //Function to find the median value of the boxcar and
 //write it to the center, regardless of the validity
 //of the center pixel value
-void FilterAll(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
+void FilterAll(RankWindow &window, double &v) {
+  double centerPixel = window.center();
 
   //Check for Special Pixels and handle according to user
   //input.
@@ -235,21 +211,10 @@ void FilterAll(Buffer &in, double &v) {
     }
   }
 
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
+  //Find the median value of the valid pixels in the window.
   //If there aren't enough to meet the minimum requirements,
   //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  if((unsigned int) window.count() < minimum || window.count() == 0) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -259,7 +224,6 @@ void FilterAll(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  v = window.median();
 }
 
@@ -93,15 +93,6 @@ namespace Isis {
     double trans;
     double trans0;
     double transs;
-    double rho;
-    double dpo;
-    double q;
-    double dpm;
-    double firsterm;
-    double secondterm;
-    double thirdterm;
-    double fourthterm;
-    double fifthterm;
 
     static double old_phase = -9999;
     static double old_incidence = -9999;
@@ -129,16 +120,85 @@ namespace Isis {
     GetAtmosModel()->CalcAtmEffect(phase, incidence, emission, &pstd, &trans, &trans0, &p_normSbar,
                                    &transs);
 
+    albedo = NrmAlbedo(pstd, trans, trans0, p_normSbar, psurf, ahInterp, munot, dn);
+  }
+
+
+  /**
+   * Computes the terms of the normalization that do not depend on the DN, for
+   * the local angles equal to the ellipsoid angles. They are the atmospheric
+   * pstd, trans, trans0 and sbar, the surface albedo psurf and the hemispheric
+   * albedo ahInterp, in that order.
+   *
+   * @param phase The phase angle
+   * @param incidence The incidence angle
+   * @param emission The emission angle
+   * @param terms Returns the six terms
+   */
+  void AlbedoAtm::CalcGeometryTerms(double phase, double incidence, double emission,
+                                    double *terms) {
+    double transs;
+    GetAtmosModel()->CalcAtmEffect(phase, incidence, emission, &terms[0], &terms[1], &terms[2],
+                                   &terms[3], &transs);
+    terms[4] = GetPhotoModel()->CalcSurfAlbedo(phase, incidence, emission);
+    terms[5] = (GetAtmosModel()->AtmosAhSpline()).Evaluate(incidence,
+                                                           NumericalApproximation::Extrapolate);
+  }
+
+
+  /**
+   * Performs the normalization from the terms CalcGeometryTerms computed.
+   *
+   * @param incidence The incidence angle
+   * @param terms The six terms of the angles
+   * @param dn The DN value
+   * @param albedo Returns the normalized albedo
+   */
+  void AlbedoAtm::CalcNrmAlbedoFromTerms(double incidence, const double *terms, double dn,
+                                         double &albedo) {
+    albedo = NrmAlbedo(terms[0], terms[1], terms[2], terms[3], terms[4], terms[5],
+                       cos(incidence * (PI / 180.0)), dn);
+  }
+
+
+  /**
+   * Solves for rho at the actual geometry and computes the albedo at the
+   * reference geometry from it.
+   *
+   * @param pstd The pure atmospheric albedo
+   * @param trans The transmission of light that must be subtracted from the flat surface model
+   * @param trans0 The transmission of light that must be subtracted from the flat surface model
+   * @param sbar The illumination of the ground by the sky
+   * @param psurf The surface albedo
+   * @param ahInterp The hemispheric albedo at the incidence angle
+   * @param munot The cosine of the incidence angle
+   * @param dn The DN value
+   *
+   * @return double The normalized albedo
+   */
+  double AlbedoAtm::NrmAlbedo(double pstd, double trans, double trans0, double sbar,
+                              double psurf, double ahInterp, double munot, double dn) {
+    double rho;
+    double dpo;
+    double q;
+    double dpm;
+    double firsterm;
+    double secondterm;
+    double thirdterm;
+    double fourthterm;
+    double fifthterm;
+    AtmosModel *atmosModel = GetAtmosModel();
+
     // With model at actual geometry, calculate rho from dn
     dpo = dn - pstd;
     dpm = (psurf - ahInterp * munot) * trans0;
-    q = ahInterp * munot * trans + GetAtmosModel()->AtmosAb() * p_normSbar * dpo + dpm;
+    q = ahInterp * munot * trans + atmosModel->AtmosAb() * sbar * dpo + dpm;
 
-    if(dpo <= 0.0 && GetAtmosModel()->AtmosNulneg()) {
+    if(dpo <= 0.0 && atmosModel->AtmosNulneg()) {
       rho = 0.0;
     }
     else {
-      firsterm = GetAtmosModel()->AtmosAb() * p_normSbar;
+      firsterm = atmosModel->AtmosAb() * sbar;
       secondterm = dpo * dpm;
       thirdterm = firsterm * secondterm;
       fourthterm = pow(q, 2.0) - 4.0 * thirdterm;
@@ -155,16 +215,14 @@ namespace Isis {
     }
 
     // Now use rho and reference geometry to calculate output dnout
-    if((1.0 - rho * GetAtmosModel()->AtmosAb()*p_normSbar) <= 0.0) {
+    if((1.0 - rho * atmosModel->AtmosAb()*sbar) <= 0.0) {
       QString msg = "Divide by zero (math) encountered";
       throw IException(IException::Unknown, msg, _FILEINFO_);
     }
-    else {
-      albedo = p_normPstdref + rho * (p_normAhref * p_normMunotref *
-                                      p_normTransref / (1.0 - rho * GetAtmosModel()->AtmosAb() *
-                                          p_normSbar) + (p_normPsurfref - p_normAhref *
-                                              p_normMunotref) * p_normTrans0ref);
-    }
+    return p_normPstdref + rho * (p_normAhref * p_normMunotref *
+                                  p_normTransref / (1.0 - rho * atmosModel->AtmosAb() *
+                                      sbar) + (p_normPsurfref - p_normAhref *
+                                          p_normMunotref) * p_normTrans0ref);
   }
 
   /**
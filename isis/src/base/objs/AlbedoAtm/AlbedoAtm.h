@@ -33,6 +33,8 @@ namespace Isis {
    *  @history 2010-11-30 Janet Barrett - Added ability to use photometric angles
    *                          from the ellipsoid and the DEM
    *  @history 2017-07-03 Makayla Shepherd - Updated documentation. References #4807.
+   *  @history 2026-10-16 Isis Development Team - Added the geometry terms so that
+   *                          Photometry::CreateLookupTable can tabulate them.
    *
    */
   class AlbedoAtm : public NormModel {
@@ -41,6 +43,19 @@ namespace Isis {
       //! Empty Destructor
       virtual ~AlbedoAtm() {};
 
+      //! The atmospheric correction makes the albedo a nonlinear function of the DN
+      virtual bool IsLinearInDn() const {
+        return false;
+      }
+
+      //! The atmosphere and surface terms pstd, trans, trans0, sbar, psurf and ahInterp
+      virtual int GeometryTermCount() const {
+        return 6;
+      }
+      virtual void CalcGeometryTerms(double pha, double inc, double ema, double *terms);
+      virtual void CalcNrmAlbedoFromTerms(double inc, const double *terms, double dn,
+                                          double &albedo);
+
     protected:
       /**
        * Performs the normalization.
@@ -64,6 +79,8 @@ namespace Isis {
       void SetNormPharef(const double pharef);
       void SetNormIncref(const double incref);
       void SetNormEmaref(const double emaref);
+      double NrmAlbedo(double pstd, double trans, double trans0, double sbar, double psurf,
+                       double ahInterp, double munot, double dn);
 
       double p_normPsurfref;  //!< ???
       double p_normPharef;    //!< The reference phase angle
@@ -1046,6 +1046,45 @@ namespace Isis {
       }
     }
 
+    MatchWindow(sChip, pChip, fChip, startSamp, endSamp, startLine, endLine);
+
+    // Save off information about the best fit
+    for(int line = startLine; line <= endLine; line++) {
+      for(int samp = startSamp; samp <= endSamp; samp++) {
+        double fit = fChip.GetValue(samp, line);
+        if(fit != Isis::Null) {
+          if((p_bestFit == Isis::Null) || CompareFits(fit, p_bestFit)) {
+            p_bestFit = fit;
+            p_bestSamp = samp;
+            p_bestLine = line;
+          }
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Fills the fit chip with the goodness of fit of the pattern chip at every
+   * position from start sample to end sample and start line to end line of
+   * the search chip. The fit chip comes in full of nulls and positions
+   * without a fit are left null.
+   *
+   * This extracts a sub-search chip at each position and calls
+   * MatchAlgorithm. Algorithms that can compute the whole window at once
+   * override it; they must skip positions whose sub-search chip does not
+   * have the SubsearchValidPercent, like this does.
+   *
+   * @param sChip Search chip
+   * @param pChip Pattern chip
+   * @param fChip Fit chip, the same size as the search chip
+   * @param startSamp Start sample
+   * @param endSamp End sample
+   * @param startLine Start line
+   * @param endLine End line
+   */
+  void AutoReg::MatchWindow(Chip &sChip, Chip &pChip, Chip &fChip,
+                            int startSamp, int endSamp, int startLine, int endLine) {
     // Create a chip the same size as the pattern chip.
     Chip subsearch(pChip.Samples(), pChip.Lines());
 
@@ -1060,14 +1099,9 @@ namespace Isis {
         // Try to match the two subchips
         double fit = MatchAlgorithm(pChip, subsearch);
 
-        // If we had a fit save off information about that fit
+        // If we had a fit save it in the fit chip
         if(fit != Isis::Null) {
           fChip.SetValue(samp, line, fit);
-          if((p_bestFit == Isis::Null) || CompareFits(fit, p_bestFit)) {
-            p_bestFit = fit;
-            p_bestSamp = samp;
-            p_bestLine = line;
-          }
         }
       }
     }
@@ -1206,6 +1240,28 @@ namespace Isis {
     return (AlgorithmStatistics(pvl));
   }
 
+
+  /**
+   * Adds the registration statistics accumulated by another AutoReg to the
+   * statistics of this one. This is used to combine the statistics of
+   * AutoRegs created from the same template that registered different
+   * measures, for example on different threads.
+   *
+   * @param other The AutoReg whose statistics are added to this one
+   */
+  void AutoReg::AddStatistics(const AutoReg &other) {
+    p_totalRegistrations += other.p_totalRegistrations;
+    p_pixelSuccesses += other.p_pixelSuccesses;
+    p_subpixelSuccesses += other.p_subpixelSuccesses;
+    p_patternChipNotEnoughValidDataCount += other.p_patternChipNotEnoughValidDataCount;
+    p_patternZScoreNotMetCount += other.p_patternZScoreNotMetCount;
+    p_fitChipNoDataCount += other.p_fitChipNoDataCount;
+    p_fitChipToleranceNotMetCount += other.p_fitChipToleranceNotMetCount;
+    p_surfaceModelNotEnoughValidDataCount += other.p_surfaceModelNotEnoughValidDataCount;
+    p_surfaceModelSolutionInvalidCount += other.p_surfaceModelSolutionInvalidCount;
+    p_surfaceModelDistanceInvalidCount += other.p_surfaceModelDistanceInvalidCount;
+  }
+
   /**
    * This function returns the keywords that this object was
    * created from.
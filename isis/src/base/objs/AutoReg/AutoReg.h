@@ -363,6 +363,7 @@ namespace Isis {
       }
 
       Pvl RegistrationStatistics();
+      virtual void AddStatistics(const AutoReg &other);
 
       /**
        * Minimum tolerance specific to algorithm
@@ -446,6 +447,9 @@ namespace Isis {
        */
       virtual double MatchAlgorithm(Chip &pattern, Chip &subsearch) = 0;
 
+      virtual void MatchWindow(Chip &sChip, Chip &pChip, Chip &fChip,
+                               int startSamp, int endSamp, int startLine, int endLine);
+
       PvlObject p_template; //!< AutoRegistration object that created this projection
 
       /**
@@ -219,50 +219,79 @@ namespace Isis {
     if(map >= 0) {
       p_currentMap = map;
 
-      if(!p_reverse) {
-        int sampDimension = (p_maxSamps / p_sinc);
-        if (p_maxSamps % p_sinc)
-          sampDimension++;
+      int sample = 0;
+      int line = 0;
+      int band = 0;
+      mapPosition(map, sample, line, band);
 
-        p_currentSample = (map % sampDimension) * p_sinc + 1;
-        map /= sampDimension;
+      p_currentSample = sample - p_soff;
+      p_currentLine = line - p_loff;
+      p_currentBand = band - p_boff;
 
-        int lineDimension = (p_maxLines / p_linc);
-        if (p_maxLines % p_linc)
-          lineDimension++;
+      SetBasePosition(sample, line, band);
+    }
+    else {
+      string message = "Invalid value for argument [map]";
+      throw IException(IException::Programmer, message, _FILEINFO_);
+    }
 
-        p_currentLine = (map % lineDimension) * p_linc + 1;
-        map /= lineDimension;
+    return !end();
+  }
 
-        p_currentBand = map * p_binc + 1;
-      }
-      else {
-        int bandDimension = (p_maxBands / p_binc);
-        if (p_maxBands % p_binc)
-          bandDimension++;
 
-        p_currentBand = (map % bandDimension) * p_binc + 1;
-        map /= bandDimension;
+  /**
+   * Computes where the shape buffer would be positioned by setpos(map)
+   * without moving it. This lets callers look ahead in the traversal order,
+   * for example to prefetch cube data that will be needed soon.
+   *
+   * @param map Shape buffer position value
+   * @param sample (output) The sample the shape would start at
+   * @param line (output) The line the shape would start at
+   * @param band (output) The band the shape would start at
+   */
+  void BufferManager::mapPosition(BigInt map, int &sample, int &line,
+                                  int &band) const {
+    int currentSample = 0;
+    int currentLine = 0;
+    int currentBand = 0;
+
+    if(!p_reverse) {
+      int sampDimension = (p_maxSamps / p_sinc);
+      if (p_maxSamps % p_sinc)
+        sampDimension++;
 
-        int lineDimension = (p_maxLines / p_linc);
-        if (p_maxLines % p_linc)
-          lineDimension++;
+      currentSample = (map % sampDimension) * p_sinc + 1;
+      map /= sampDimension;
 
-        p_currentLine = (map % lineDimension) * p_linc + 1;
-        map /= lineDimension;
+      int lineDimension = (p_maxLines / p_linc);
+      if (p_maxLines % p_linc)
+        lineDimension++;
 
-        p_currentSample = map * p_sinc + 1;
-      }
+      currentLine = (map % lineDimension) * p_linc + 1;
+      map /= lineDimension;
 
-      SetBasePosition(p_currentSample + p_soff,
-                      p_currentLine + p_loff,
-                      p_currentBand + p_boff);
+      currentBand = map * p_binc + 1;
     }
     else {
-      string message = "Invalid value for argument [map]";
-      throw IException(IException::Programmer, message, _FILEINFO_);
+      int bandDimension = (p_maxBands / p_binc);
+      if (p_maxBands % p_binc)
+        bandDimension++;
+
+      currentBand = (map % bandDimension) * p_binc + 1;
+      map /= bandDimension;
+
+      int lineDimension = (p_maxLines / p_linc);
+      if (p_maxLines % p_linc)
+        lineDimension++;
+
+      currentLine = (map % lineDimension) * p_linc + 1;
+      map /= lineDimension;
+
+      currentSample = map * p_sinc + 1;
     }
 
-    return !end();
+    sample = currentSample + p_soff;
+    line = currentLine + p_loff;
+    band = currentBand + p_boff;
   }
 } // end namespace isis
@@ -118,6 +118,26 @@ namespace Isis {
 
       bool setpos(BigInt map);
 
+      /**
+       * Returns the current shape buffer position (see setpos method).
+       *
+       * @return BigInt
+       */
+      BigInt currentMap() const {
+        return (p_currentMap);
+      }
+
+      /**
+       * Returns the total number of shape buffer positions in the cube.
+       *
+       * @return BigInt
+       */
+      BigInt mapCount() const {
+        return (p_nmaps);
+      }
+
+      void mapPosition(BigInt map, int &sample, int &line, int &band) const;
+
       void swap(BufferManager &other);
 
       BufferManager &operator=(const BufferManager &rhs);
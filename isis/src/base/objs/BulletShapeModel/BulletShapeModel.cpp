@@ -203,6 +203,50 @@ namespace Isis {
     return ( success );
   }
 
+
+  /**
+   * Intersects many rays with the target body at once. Each ray is cast like
+   * intersectSurface(observerPos, lookDirection), but only its intersection
+   * point is kept, so no intercept or normal is saved for every ray. The
+   * shape model is left without an intersection.
+   *
+   * @note The Bullet world is not safe to ray cast from several threads, so
+   *       the rays are cast one after another.
+   *
+   * @param observerPositions The body-fixed origin of each ray in kilometers
+   * @param lookDirections The body-fixed direction of each ray
+   *
+   * @return @b std::vector<SurfacePoint> The intersection of each ray. Rays
+   *                                      that miss the target get an invalid
+   *                                      SurfacePoint.
+   */
+  std::vector<SurfacePoint> BulletShapeModel::intersectSurfaces(
+      const std::vector< std::vector<double> > &observerPositions,
+      const std::vector< std::vector<double> > &lookDirections) {
+    if (observerPositions.size() != lookDirections.size()) {
+      QString msg = "Cannot intersect rays with [" + toString((int)observerPositions.size()) +
+                    "] observer positions and [" + toString((int)lookDirections.size()) +
+                    "] look directions";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    clearSurfacePoint();
+
+    std::vector<SurfacePoint> intersections(observerPositions.size());
+    for (size_t i = 0; i < observerPositions.size(); i++) {
+      btVector3 observer(observerPositions[i][0], observerPositions[i][1],
+                         observerPositions[i][2]);
+      btVector3 lookdir(lookDirections[i][0], lookDirections[i][1], lookDirections[i][2]);
+      btVector3 rayEnd = castLookDir(observer, lookdir);
+      BulletClosestRayCallback result(observer, rayEnd);
+      if ( m_model->raycast(observer, rayEnd, result) && result.isValid() ) {
+        intersections[i] = makeSurfacePoint(result.point());
+      }
+    }
+
+    return ( intersections );
+  }
+
 /**
  * Compute the intersection at a specified latitude and longitude. The
  * intersection can also be checked for occlusion from an observer.
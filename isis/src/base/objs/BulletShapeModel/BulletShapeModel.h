@@ -56,6 +56,9 @@ namespace Isis {
       virtual bool intersectSurface(const SurfacePoint &surfpt, 
                                     const std::vector<double> &observerPos,
                                     const bool &checkOcclusion = true);
+      virtual std::vector<SurfacePoint> intersectSurfaces(
+          const std::vector< std::vector<double> > &observerPositions,
+          const std::vector< std::vector<double> > &lookDirections);
 
       virtual void setSurfacePoint(const SurfacePoint &surfacePoint);
       virtual void clearSurfacePoint();
@@ -0,0 +1,725 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "CalculatorProgram.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#include "IException.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Rounds a value to the nearest integer the same way the Calculator does
+   * before its integer operators.
+   *
+   * @param a The value to round
+   *
+   * @return int The rounded value
+   */
+  static inline int roundToInt(double a) {
+    return (a > 0) ? (int)(a + 0.5) : (int)(a - 0.5);
+  }
+
+
+  /**
+   * Maps an ISIS special pixel to the value the Calculator operates on. Null
+   * becomes NaN, the high saturation values become positive infinity and the
+   * low saturation values become negative infinity.
+   *
+   * @param d The pixel value
+   *
+   * @return double The value to calculate with
+   */
+  static inline double toCalculatorValue(double d) {
+    if (IsSpecial(d)) {
+      if (IsNullPixel(d)) {
+        return NAN;
+      }
+      if (IsHrsPixel(d) || IsHisPixel(d)) {
+        return numeric_limits<double>::infinity();
+      }
+      return -numeric_limits<double>::infinity();
+    }
+    return d;
+  }
+
+
+  /**
+   * Applies a unary function to a block of values.
+   *
+   * @param a The operand block
+   * @param out The result block
+   * @param count The number of values in the block
+   * @param function The function to apply
+   */
+  template <typename Function>
+  static inline void unaryBlock(const double *a, double *out, int count, Function function) {
+    for (int i = 0; i < count; i++) {
+      out[i] = function(a[i]);
+    }
+  }
+
+
+  /**
+   * Applies a binary function to a pair of blocks of values.
+   *
+   * @param a The first operand block
+   * @param b The second operand block
+   * @param out The result block
+   * @param count The number of values in the blocks
+   * @param function The function to apply
+   */
+  template <typename Function>
+  static inline void binaryBlock(const double *a, const double *b, double *out, int count,
+                                 Function function) {
+    for (int i = 0; i < count; i++) {
+      out[i] = function(a[i], b[i]);
+    }
+  }
+
+
+  //! Constructs an empty CalculatorProgram.
+  CalculatorProgram::CalculatorProgram() {
+    m_valid = true;
+  }
+
+
+  //! Destroys the CalculatorProgram.
+  CalculatorProgram::~CalculatorProgram() {
+  }
+
+
+  /**
+   * Removes every node and input from the program.
+   */
+  void CalculatorProgram::clear() {
+    m_nodes.clear();
+    m_compileStack.clear();
+    m_inputs.clear();
+    m_valid = true;
+  }
+
+
+  /**
+   * Appends a scalar constant to the program.
+   *
+   * @param value The constant
+   */
+  void CalculatorProgram::pushConstant(double value) {
+    Node node;
+    node.op = Constant;
+    node.left = -1;
+    node.right = -1;
+    node.first = m_nodes.size();
+    node.input = -1;
+    node.constant = value;
+
+    m_compileStack.push_back(m_nodes.size());
+    m_nodes.push_back(node);
+  }
+
+
+  /**
+   * Appends an input to the program. The data for the input is bound with
+   * setInput() before each evaluation. The same input may be used by more than
+   * one node.
+   *
+   * @param input The index of the input
+   *
+   * @throws IException::Programmer "Invalid calculator program input"
+   */
+  void CalculatorProgram::pushInput(int input) {
+    if (input < 0) {
+      QString msg = "Invalid calculator program input [" + QString::number(input) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (input >= (int)m_inputs.size()) {
+      m_inputs.resize(input + 1);
+    }
+
+    Node node;
+    node.op = Input;
+    node.left = -1;
+    node.right = -1;
+    node.first = m_nodes.size();
+    node.input = input;
+    node.constant = 0.0;
+
+    m_compileStack.push_back(m_nodes.size());
+    m_nodes.push_back(node);
+  }
+
+
+  /**
+   * Appends an operator to the program. The operator takes its operands from
+   * the previously pushed data and operators, exactly as the stack based
+   * Calculator would. If there are not enough operands the program becomes
+   * invalid.
+   *
+   * @param op The operator
+   *
+   * @throws IException::Programmer "Constants and inputs are not operators"
+   */
+  void CalculatorProgram::pushOperator(Operator op) {
+    if (op == Constant || op == Input) {
+      QString msg = "Constants and inputs are not operators";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int operands = isUnary(op) ? 1 : 2;
+    if ((int)m_compileStack.size() < operands) {
+      m_valid = false;
+      return;
+    }
+
+    Node node;
+    node.op = op;
+    node.right = -1;
+    node.input = -1;
+    node.constant = 0.0;
+
+    if (operands == 2) {
+      node.right = m_compileStack.back();
+      m_compileStack.pop_back();
+    }
+    node.left = m_compileStack.back();
+    m_compileStack.pop_back();
+    node.first = m_nodes[node.left].first;
+
+    m_compileStack.push_back(m_nodes.size());
+    m_nodes.push_back(node);
+  }
+
+
+  /**
+   * Checks that the program is a complete equation: every operator had its
+   * operands and exactly one result remains.
+   *
+   * @return bool True if the program can be evaluated
+   */
+  bool CalculatorProgram::isValid() const {
+    return m_valid && m_compileStack.size() == 1;
+  }
+
+
+  /**
+   * Returns the number of inputs the program uses.
+   *
+   * @return int The number of inputs
+   */
+  int CalculatorProgram::inputCount() const {
+    return m_inputs.size();
+  }
+
+
+  /**
+   * Binds a scalar to an input.
+   *
+   * @param input The index of the input
+   * @param value The value of the input
+   *
+   * @throws IException::Programmer "Invalid calculator program input"
+   */
+  void CalculatorProgram::setInput(int input, double value) {
+    if (input < 0 || input >= (int)m_inputs.size()) {
+      QString msg = "Invalid calculator program input [" + QString::number(input) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    InputData &inputData = m_inputs[input];
+    inputData.data = NULL;
+    inputData.size = 1;
+    inputData.mapSpecials = false;
+    inputData.value = value;
+  }
+
+
+  /**
+   * Binds an array to an input. The data is not copied and must remain valid
+   * until evaluate() returns.
+   *
+   * @param input The index of the input
+   * @param data The values of the input
+   * @param size The number of values
+   * @param mapSpecials If true, ISIS special pixels in the data are mapped to
+   *                    the IEEE values the Calculator uses for them
+   *
+   * @throws IException::Programmer "Invalid calculator program input"
+   */
+  void CalculatorProgram::setInput(int input, const double *data, int size, bool mapSpecials) {
+    if (input < 0 || input >= (int)m_inputs.size()) {
+      QString msg = "Invalid calculator program input [" + QString::number(input) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    InputData &inputData = m_inputs[input];
+    inputData.data = data;
+    inputData.size = size;
+    inputData.mapSpecials = mapSpecials;
+    inputData.value = 0.0;
+  }
+
+
+  /**
+   * Evaluates the program with the currently bound inputs.
+   *
+   * @return QVector<double> The result of the equation, with ISIS special pixels
+   *
+   * @throws IException::Programmer "The calculator program is not a complete equation"
+   */
+  QVector<double> CalculatorProgram::evaluate() {
+    if (!isValid()) {
+      QString msg = "The calculator program is not a complete equation";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int nodeCount = m_nodes.size();
+    m_states.assign(nodeCount, Pending);
+    m_lengths.resize(nodeCount);
+    m_scalars.resize(nodeCount);
+    m_wholeData.resize(nodeCount);
+    m_blockData.resize(nodeCount);
+    if ((int)m_wholeBuffers.size() < nodeCount) {
+      m_wholeBuffers.resize(nodeCount);
+    }
+    if ((int)m_scratch.size() < nodeCount * s_blockSize) {
+      m_scratch.resize(nodeCount * s_blockSize);
+    }
+
+    for (int i = 0; i < nodeCount; i++) {
+      prepareNode(i);
+    }
+
+    int root = nodeCount - 1;
+    QVector<double> results(m_lengths[root]);
+
+    if (m_states[root] == Pending) {
+      evaluateBlocks(m_nodes[root].first, root, m_lengths[root], results.data());
+    }
+    else {
+      const double *values = (m_states[root] == Scalar) ? &m_scalars[root] : m_wholeData[root];
+      copy(values, values + m_lengths[root], results.begin());
+    }
+
+    for (int i = 0; i < results.size(); i++) {
+      if (std::isnan(results[i])) {
+        results[i] = Isis::Null;
+      }
+      else if (results[i] > DBL_MAX) {
+        results[i] = Isis::Hrs;
+      }
+      else if (results[i] < -DBL_MAX) {
+        results[i] = Isis::Lrs;
+      }
+    }
+
+    return results;
+  }
+
+
+  /**
+   * Checks whether an operator takes a single operand.
+   *
+   * @param op The operator
+   *
+   * @return bool True for unary operators
+   */
+  bool CalculatorProgram::isUnary(Operator op) {
+    return (op >= Negative && op <= ArctangentH) || op == MinimumLine || op == MaximumLine;
+  }
+
+
+  /**
+   * Determines the length of a node's values and folds it if it is a scalar.
+   * Operators that need all of an operand's values are materialized here.
+   * Nodes must be prepared in order.
+   *
+   * @param index The index of the node
+   *
+   * @throws IException::Programmer "The stack based calculator cannot operate on vectors of
+   *                                 differing sizes."
+   * @throws IException::Unknown "When trying to do a shift calculation, a non-scalar shift value
+   *                              was encountered. Shifting requires scalars."
+   * @throws IException::Unknown "When trying to do a shift calculation, a shift value greater
+   *                              than the data size was encountered."
+   */
+  void CalculatorProgram::prepareNode(int index) {
+    const Node &node = m_nodes[index];
+
+    if (node.op == Constant) {
+      m_lengths[index] = 1;
+      m_scalars[index] = node.constant;
+      m_states[index] = Scalar;
+    }
+    else if (node.op == Input) {
+      const InputData &inputData = m_inputs[node.input];
+      m_lengths[index] = inputData.size;
+      if (inputData.size == 1) {
+        double value = inputData.data ? inputData.data[0] : inputData.value;
+        m_scalars[index] = inputData.mapSpecials ? toCalculatorValue(value) : value;
+        m_states[index] = Scalar;
+      }
+    }
+    else if (node.op == MinimumLine || node.op == MaximumLine) {
+      int length = m_lengths[node.left];
+      double result = NAN;
+      if (length > 0) {
+        const double *values = wholeValues(node.left);
+        result = values[0];
+        for (int i = 0; i < length; i++) {
+          if (!IsSpecial(values[i])) {
+            result = (node.op == MinimumLine) ? min(result, values[i]) : max(result, values[i]);
+          }
+        }
+      }
+      consume(node.left);
+
+      m_lengths[index] = 1;
+      m_scalars[index] = result;
+      m_states[index] = Scalar;
+    }
+    else if (node.op == LeftShift || node.op == RightShift) {
+      QString direction = (node.op == LeftShift) ? "left" : "right";
+      if (m_lengths[node.right] != 1) {
+        QString msg = "When trying to do a " + direction + " shift calculation, a non-scalar "
+                      "shift value was encountered. Shifting requires scalars.";
+        throw IException(IException::Unknown, msg, _FILEINFO_);
+      }
+
+      int length = m_lengths[node.left];
+      int shift = (int)m_scalars[node.right];
+      if (shift > length) {
+        QString msg = "When trying to do a " + direction + " shift calculation, a shift "
+                      "value greater than the data size was encountered. "
+                      "Shifting by this value would erase all of the data.";
+        throw IException(IException::Unknown, msg, _FILEINFO_);
+      }
+      if (node.op == RightShift) {
+        shift = -shift;
+      }
+
+      const double *values = wholeValues(node.left);
+      double *result = &m_scalars[index];
+      if (length != 1) {
+        m_wholeBuffers[index].resize(length);
+        result = m_wholeBuffers[index].data();
+      }
+      for (int i = 0; i < length; i++) {
+        int source = i + shift;
+        result[i] = (source >= 0 && source < length) ? values[source] : NAN;
+      }
+      consume(node.left);
+
+      m_lengths[index] = length;
+      m_wholeData[index] = result;
+      m_states[index] = (length == 1) ? Scalar : Materialized;
+    }
+    else if (isUnary(node.op)) {
+      m_lengths[index] = m_lengths[node.left];
+      if (m_lengths[index] == 1) {
+        computeNode(index, &m_scalars[node.left], NULL, &m_scalars[index], 1);
+        m_states[index] = Scalar;
+      }
+    }
+    else {
+      int leftLength = m_lengths[node.left];
+      int rightLength = m_lengths[node.right];
+
+      if (node.op == LogicalAnd || node.op == LogicalOr) {
+        if (leftLength != rightLength) {
+          QString msg = "Failed performing logical ";
+          msg += (node.op == LogicalAnd) ? "and" : "or";
+          msg += " operation, input vectors are of differnet lengths.";
+          throw IException(IException::Unknown, msg, _FILEINFO_);
+        }
+      }
+      else if (leftLength != 1 && rightLength != 1 && leftLength != rightLength) {
+        QString msg = "The stack based calculator cannot operate on vectors "
+                      "of differing sizes.";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+
+      m_lengths[index] = (leftLength == 0 || rightLength == 0) ? 0 : max(leftLength, rightLength);
+      if (m_lengths[index] == 1) {
+        computeNode(index, &m_scalars[node.left], &m_scalars[node.right], &m_scalars[index], 1);
+        m_states[index] = Scalar;
+      }
+    }
+  }
+
+
+  /**
+   * Returns all of the values of a prepared node, evaluating its subtree if
+   * it has not been evaluated yet.
+   *
+   * @param index The index of the node
+   *
+   * @return const double* The node's values
+   */
+  const double *CalculatorProgram::wholeValues(int index) {
+    if (m_states[index] == Scalar) {
+      return &m_scalars[index];
+    }
+    if (m_states[index] == Materialized) {
+      return m_wholeData[index];
+    }
+
+    const Node &node = m_nodes[index];
+    if (node.op == Input && !m_inputs[node.input].mapSpecials) {
+      return m_inputs[node.input].data;
+    }
+
+    vector<double> &buffer = m_wholeBuffers[index];
+    buffer.resize(m_lengths[index]);
+    evaluateBlocks(node.first, index, m_lengths[index], buffer.data());
+    return buffer.data();
+  }
+
+
+  /**
+   * Marks a node and its subtree as evaluated once their values have been
+   * used by a materializing operator.
+   *
+   * @param index The index of the node
+   */
+  void CalculatorProgram::consume(int index) {
+    for (int i = m_nodes[index].first; i <= index; i++) {
+      m_states[i] = Consumed;
+    }
+  }
+
+
+  /**
+   * Evaluates the nodes [first, last] block by block and copies the values of
+   * the last node into out.
+   *
+   * @param first The index of the first node of the subtree
+   * @param last The index of the subtree's root
+   * @param length The number of values of the root
+   * @param out Receives the values of the root
+   */
+  void CalculatorProgram::evaluateBlocks(int first, int last, int length, double *out) {
+    for (int i = first; i <= last; i++) {
+      if (m_states[i] == Scalar) {
+        double *block = scratch(i);
+        fill(block, block + s_blockSize, m_scalars[i]);
+        m_blockData[i] = block;
+      }
+    }
+
+    for (int start = 0; start < length; start += s_blockSize) {
+      int count = min(s_blockSize, length - start);
+
+      for (int i = first; i <= last; i++) {
+        if (m_states[i] == Materialized) {
+          m_blockData[i] = m_wholeData[i] + start;
+        }
+        else if (m_states[i] == Pending) {
+          const Node &node = m_nodes[i];
+          if (node.op == Input) {
+            const InputData &inputData = m_inputs[node.input];
+            if (inputData.mapSpecials) {
+              double *block = scratch(i);
+              for (int j = 0; j < count; j++) {
+                block[j] = toCalculatorValue(inputData.data[start + j]);
+              }
+              m_blockData[i] = block;
+            }
+            else {
+              m_blockData[i] = inputData.data + start;
+            }
+          }
+          else {
+            double *block = scratch(i);
+            computeNode(i, m_blockData[node.left],
+                        (node.right < 0) ? NULL : m_blockData[node.right], block, count);
+            m_blockData[i] = block;
+          }
+        }
+      }
+
+      copy(m_blockData[last], m_blockData[last] + count, out + start);
+    }
+  }
+
+
+  /**
+   * Applies a node's operator to blocks of its operands' values.
+   *
+   * @param index The index of the node
+   * @param a The first operand's values
+   * @param b The second operand's values, NULL for unary operators
+   * @param out Receives the results
+   * @param count The number of values
+   *
+   * @throws IException::Programmer "Operator cannot be applied to a block"
+   */
+  void CalculatorProgram::computeNode(int index, const double *a, const double *b,
+                                      double *out, int count) {
+    switch (m_nodes[index].op) {
+      case Negative:
+        unaryBlock(a, out, count, [](double x) { return -1 * x; });
+        break;
+      case AbsoluteValue:
+        unaryBlock(a, out, count, [](double x) { return fabs(x); });
+        break;
+      case SquareRoot:
+        unaryBlock(a, out, count, [](double x) { return sqrt(x); });
+        break;
+      case Log:
+        unaryBlock(a, out, count, [](double x) { return log(x); });
+        break;
+      case Log10:
+        unaryBlock(a, out, count, [](double x) { return log10(x); });
+        break;
+      case Sine:
+        unaryBlock(a, out, count, [](double x) { return sin(x); });
+        break;
+      case Cosine:
+        unaryBlock(a, out, count, [](double x) { return cos(x); });
+        break;
+      case Tangent:
+        unaryBlock(a, out, count, [](double x) { return tan(x); });
+        break;
+      case Secant:
+        unaryBlock(a, out, count, [](double x) { return 1.0 / cos(x); });
+        break;
+      case Cosecant:
+        unaryBlock(a, out, count, [](double x) { return 1.0 / sin(x); });
+        break;
+      case Cotangent:
+        unaryBlock(a, out, count, [](double x) { return 1.0 / tan(x); });
+        break;
+      case Arcsine:
+        unaryBlock(a, out, count, [](double x) { return asin(x); });
+        break;
+      case Arccosine:
+        unaryBlock(a, out, count, [](double x) { return acos(x); });
+        break;
+      case Arctangent:
+        unaryBlock(a, out, count, [](double x) { return atan(x); });
+        break;
+      case SineH:
+        unaryBlock(a, out, count, [](double x) { return sinh(x); });
+        break;
+      case CosineH:
+        unaryBlock(a, out, count, [](double x) { return cosh(x); });
+        break;
+      case TangentH:
+        unaryBlock(a, out, count, [](double x) { return tanh(x); });
+        break;
+      case ArcsineH:
+        unaryBlock(a, out, count, [](double x) { return asinh(x); });
+        break;
+      case ArccosineH:
+        unaryBlock(a, out, count, [](double x) { return acosh(x); });
+        break;
+      case ArctangentH:
+        unaryBlock(a, out, count, [](double x) { return atanh(x); });
+        break;
+      case Add:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x + y; });
+        break;
+      case Subtract:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x - y; });
+        break;
+      case Multiply:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x * y; });
+        break;
+      case Divide:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x / y; });
+        break;
+      case Modulus:
+        binaryBlock(a, b, out, count, [](double x, double y) {
+          return (double)(roundToInt(x) % roundToInt(y));
+        });
+        break;
+      case FloatModulus:
+        binaryBlock(a, b, out, count, [](double x, double y) { return fmod(x, y); });
+        break;
+      case Exponent:
+        binaryBlock(a, b, out, count, [](double x, double y) { return pow(x, y); });
+        break;
+      case Arctangent2:
+        binaryBlock(a, b, out, count, [](double x, double y) { return atan2(x, y); });
+        break;
+      // The Calculator passes the top of the stack first to min and max, which
+      // decides which NaN is kept.
+      case MinimumPixel:
+        binaryBlock(b, a, out, count, [](double x, double y) {
+          if (std::isnan(x)) return x;
+          if (std::isnan(y)) return y;
+          return (x < y) ? x : y;
+        });
+        break;
+      case MaximumPixel:
+        binaryBlock(b, a, out, count, [](double x, double y) {
+          if (std::isnan(x)) return x;
+          if (std::isnan(y)) return y;
+          return (x > y) ? x : y;
+        });
+        break;
+      case GreaterThan:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x > y ? 1.0 : 0.0; });
+        break;
+      case LessThan:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x < y ? 1.0 : 0.0; });
+        break;
+      case GreaterThanOrEqual:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x >= y ? 1.0 : 0.0; });
+        break;
+      case LessThanOrEqual:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x <= y ? 1.0 : 0.0; });
+        break;
+      case Equal:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x == y ? 1.0 : 0.0; });
+        break;
+      case NotEqual:
+        binaryBlock(a, b, out, count, [](double x, double y) { return x != y ? 1.0 : 0.0; });
+        break;
+      case And:
+        binaryBlock(a, b, out, count, [](double x, double y) {
+          return (double)(roundToInt(x) & roundToInt(y));
+        });
+        break;
+      case Or:
+        binaryBlock(a, b, out, count, [](double x, double y) {
+          return (double)(roundToInt(x) | roundToInt(y));
+        });
+        break;
+      case LogicalAnd:
+        binaryBlock(a, b, out, count, [](double x, double y) { return (x && y) ? 1.0 : 0.0; });
+        break;
+      case LogicalOr:
+        binaryBlock(a, b, out, count, [](double x, double y) { return (x || y) ? 1.0 : 0.0; });
+        break;
+      default: {
+        QString msg = "Operator cannot be applied to a block";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+    }
+  }
+
+
+  /**
+   * Returns the scratch block reserved for a node.
+   *
+   * @param index The index of the node
+   *
+   * @return double* The node's scratch block
+   */
+  double *CalculatorProgram::scratch(int index) {
+    return &m_scratch[index * s_blockSize];
+  }
+}
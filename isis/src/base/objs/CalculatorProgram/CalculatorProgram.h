@@ -0,0 +1,173 @@
+#ifndef CalculatorProgram_h
+#define CalculatorProgram_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <vector>
+
+#include <QVector>
+
+namespace Isis {
+  /**
+   * @brief Compiled form of a postfix calculator equation
+   *
+   * A CalculatorProgram is built from the same postfix sequence of data and
+   * operators that drives the stack based Calculator, but instead of
+   * interpreting the sequence with a stack of vectors it records a typed
+   * expression tree (stored in postfix order, each node referencing its
+   * operands). Evaluating the program walks the tree in fixed-size blocks of
+   * samples, writing every node into a preallocated scratch block, so no
+   * vectors are allocated per operator and the per-element loops are simple
+   * enough for the compiler to vectorize.
+   *
+   * Scalar operands are folded once per evaluation and broadcast into the
+   * blocks. Operators that need an entire operand before producing a value
+   * (linemin, linemax, << and >>) materialize their operand into a reusable
+   * buffer first and then act as inputs to the rest of the tree.
+   *
+   * Special pixels follow the Calculator conventions exactly: inputs flagged
+   * for mapping convert Null to NaN and the high and low saturation values to
+   * positive and negative infinity, the arithmetic is carried out in IEEE
+   * double precision and the final result maps NaN back to Null and the
+   * infinities to Hrs and Lrs.
+   *
+   * @ingroup Math
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class CalculatorProgram {
+    public:
+      //! The operations a node in the program can perform.
+      enum Operator {
+        Constant,           //!< A scalar constant.
+        Input,              //!< Data supplied at evaluation time with setInput().
+        Negative,           //!< -a
+        AbsoluteValue,      //!< abs(a)
+        SquareRoot,         //!< sqrt(a)
+        Log,                //!< Natural log of a.
+        Log10,              //!< Base 10 log of a.
+        Sine,               //!< sin(a)
+        Cosine,             //!< cos(a)
+        Tangent,            //!< tan(a)
+        Secant,             //!< 1 / cos(a)
+        Cosecant,           //!< 1 / sin(a)
+        Cotangent,          //!< 1 / tan(a)
+        Arcsine,            //!< asin(a)
+        Arccosine,          //!< acos(a)
+        Arctangent,         //!< atan(a)
+        SineH,              //!< sinh(a)
+        CosineH,            //!< cosh(a)
+        TangentH,           //!< tanh(a)
+        ArcsineH,           //!< asinh(a)
+        ArccosineH,         //!< acosh(a)
+        ArctangentH,        //!< atanh(a)
+        Add,                //!< a + b
+        Subtract,           //!< a - b
+        Multiply,           //!< a * b
+        Divide,             //!< a / b
+        Modulus,            //!< Integer modulus of a and b rounded to integers.
+        FloatModulus,       //!< fmod(a, b)
+        Exponent,           //!< pow(a, b)
+        Arctangent2,        //!< atan2(a, b)
+        MinimumPixel,       //!< Pixel by pixel minimum of a and b.
+        MaximumPixel,       //!< Pixel by pixel maximum of a and b.
+        GreaterThan,        //!< 1 if a > b, 0 otherwise.
+        LessThan,           //!< 1 if a < b, 0 otherwise.
+        GreaterThanOrEqual, //!< 1 if a >= b, 0 otherwise.
+        LessThanOrEqual,    //!< 1 if a <= b, 0 otherwise.
+        Equal,              //!< 1 if a == b, 0 otherwise.
+        NotEqual,           //!< 1 if a != b, 0 otherwise.
+        And,                //!< Bitwise and of a and b rounded to integers.
+        Or,                 //!< Bitwise or of a and b rounded to integers.
+        LogicalAnd,         //!< a && b, requires operands of the same size.
+        LogicalOr,          //!< a || b, requires operands of the same size.
+        MinimumLine,        //!< Minimum valid value of a.
+        MaximumLine,        //!< Maximum valid value of a.
+        LeftShift,          //!< a shifted left by the scalar b.
+        RightShift          //!< a shifted right by the scalar b.
+      };
+
+      CalculatorProgram();
+      ~CalculatorProgram();
+
+      void clear();
+
+      void pushConstant(double value);
+      void pushInput(int input);
+      void pushOperator(Operator op);
+
+      bool isValid() const;
+      int inputCount() const;
+
+      void setInput(int input, double value);
+      void setInput(int input, const double *data, int size, bool mapSpecials = false);
+
+      QVector<double> evaluate();
+
+    private:
+      //! Number of samples each node processes at a time.
+      static const int s_blockSize = 256;
+
+      //! The evaluation state of a node.
+      enum NodeState {
+        Pending,      //!< Computed block by block.
+        Scalar,       //!< A single value, folded before the blocks are evaluated.
+        Materialized, //!< All of its values are held in a whole buffer.
+        Consumed      //!< Already evaluated as part of a materialized operand.
+      };
+
+      /**
+       * A node of the expression tree. Operands always precede the node, and
+       * the nodes of its subtree occupy the indices [first, this node].
+       */
+      struct Node {
+        Operator op;     //!< The operation of the node.
+        int left;        //!< Index of the first operand, or -1.
+        int right;       //!< Index of the second operand, or -1.
+        int first;       //!< Index of the first node in this node's subtree.
+        int input;       //!< Input index for Input nodes.
+        double constant; //!< Value of Constant nodes.
+      };
+
+      /**
+       * Data bound to an input for the next evaluation.
+       */
+      struct InputData {
+        const double *data; //!< The values, or the scalar value when size is one.
+        int size;           //!< Number of values.
+        bool mapSpecials;   //!< Whether ISIS special pixels must be mapped to IEEE values.
+        double value;       //!< Storage for scalar inputs.
+      };
+
+      static bool isUnary(Operator op);
+
+      void prepareNode(int index);
+      const double *wholeValues(int index);
+      void consume(int index);
+      void evaluateBlocks(int first, int last, int length, double *out);
+      void computeNode(int index, const double *a, const double *b, double *out, int count);
+      double *scratch(int index);
+
+      std::vector<Node> m_nodes;        //!< The expression tree in postfix order.
+      std::vector<int> m_compileStack;  //!< Operand stack used while building the tree.
+      bool m_valid;                     //!< False once an operator lacked operands.
+
+      std::vector<InputData> m_inputs;  //!< Data bound to the inputs.
+
+      std::vector<NodeState> m_states;  //!< Per node evaluation state.
+      std::vector<int> m_lengths;       //!< Per node number of values.
+      std::vector<double> m_scalars;    //!< Per node value of Scalar nodes.
+      std::vector<const double *> m_wholeData; //!< Per node values of Materialized nodes.
+      std::vector<const double *> m_blockData; //!< Per node values for the current block.
+      std::vector< std::vector<double> > m_wholeBuffers; //!< Per node materialization storage.
+      std::vector<double> m_scratch;    //!< One block of storage for every node.
+  };
+}
+
+#endif
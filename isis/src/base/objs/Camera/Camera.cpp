@@ -25,6 +25,7 @@ find files of those names at the top level of this repository. **/
 #include "Angle.h"
 #include "Constants.h"
 #include "CameraDetectorMap.h"
+#include "CameraFactory.h"
 #include "CameraFocalPlaneMap.h"
 #include "CameraDistortionMap.h"
 #include "CameraGroundMap.h"
@@ -35,7 +36,6 @@ find files of those names at the top level of this repository. **/
 #include "iTime.h"
 #include "Latitude.h"
 #include "Longitude.h"
-#include "NaifStatus.h"
 #include "Projection.h"
 #include "ProjectionFactory.h"
 #include "RingPlaneProjection.h"
@@ -145,6 +145,87 @@ namespace Isis {
   }
 
 
+  /**
+   * @brief Creates another camera for the same cube that can be evaluated independently.
+   *
+   * SetImage, SetGround, and the other evaluation methods change the state of a camera, so a
+   * camera cannot be shared between threads. A clone is created through the CameraFactory and
+   * has its own Spice state, detector, focal plane, distortion, and ground maps, so it can be
+   * handed to another thread.
+   *
+   * The clone's rotations and positions are replaced with copies of this camera's, which share
+   * this camera's cached SPICE tables instead of holding their own, and its focal plane map and
+   * distortion map use this camera's transforms and coefficients. The clone therefore evaluates
+   * exactly like this camera, including any changes made to this camera's pointing.
+   *
+   * If evaluatesWithoutNaif() is true, evaluating the clone makes no NAIF calls that use NAIF's
+   * global state, so clones can be evaluated from several threads at once without holding
+   * NaifStatus::mutex(). Otherwise threads evaluating clones must hold the mutex while they do
+   * so.
+   *
+   * The clone is set to the same band as this camera, and ignores the map projection and the
+   * elevation model if this camera does. Its image and ground points are not set.
+   *
+   * Clones should be created and deleted from a single thread, or under NaifStatus::mutex(),
+   * because creating and deleting a camera may load and unload NAIF kernels and open the DEM
+   * cube.
+   *
+   * @param cube The cube this camera was created from.
+   *
+   * @throws IException::Programmer "Cannot clone the camera with a cube it was not created from."
+   *
+   * @return @b Camera* A new camera that the caller takes ownership of.
+   */
+  Camera *Camera::clone(Cube &cube) {
+    if (cube.sampleCount() != Samples() || cube.lineCount() != Lines() ||
+        cube.bandCount() != Bands() ||
+        cube.label()->findGroup("Instrument", Pvl::Traverse)["InstrumentId"][0] !=
+            instrumentId()) {
+      QString msg = "Cannot clone the camera with a cube it was not created from.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    Camera *copy = CameraFactory::Create(cube);
+
+    copy->SetBand(Band());
+    copy->IgnoreProjection(p_ignoreProjection);
+
+    if (target()->shape()->name() == "Ellipsoid" &&
+        copy->target()->shape()->name() != "Ellipsoid") {
+      copy->IgnoreElevationModel(true);
+    }
+
+    copy->shareCaches(*this);
+
+    if (p_focalPlaneMap && copy->p_focalPlaneMap) {
+      copy->p_focalPlaneMap->CopyTransforms(*p_focalPlaneMap);
+    }
+
+    if (p_distortionMap && copy->p_distortionMap) {
+      copy->p_distortionMap->CopyDistortion(*p_distortionMap);
+    }
+
+    return copy;
+  }
+
+
+  /**
+   * Returns whether evaluating this camera, or clones of it, only reads cached SPICE and makes no
+   * NAIF calls that use NAIF's kernel pool, error state, or traceback. That is the case when the
+   * Spice is cached without NAIF (see Spice::isCachedWithoutNaif()) and the shape model is an
+   * ellipsoid or a DEM. The CSPICE vector routines that remain on the evaluation path keep no
+   * state, so clones of such a camera can be evaluated from several threads without holding
+   * NaifStatus::mutex().
+   *
+   * @return @b bool True if clones of this camera can be evaluated without the NAIF mutex
+   */
+  bool Camera::evaluatesWithoutNaif() {
+    QString shape = target()->shape()->name();
+    return isCachedWithoutNaif() &&
+           (shape == "Ellipsoid" || shape == "DemShape" || shape == "EquatorialCylindricalShape");
+  }
+
+
   /**
    * @brief Sets the sample/line values of the image to get the lat/lon values.
    *
@@ -2079,8 +2160,6 @@ namespace Isis {
     // method is done
     bool computed = p_pointComputed;
 
-    NaifStatus::CheckErrors();
-
     // Get the azimuth's origin point (the current position) and its radius
     SpiceDouble azimuthOrigin[3];
     Coordinate(azimuthOrigin);
@@ -2205,8 +2284,6 @@ namespace Isis {
     if (azimuth < 0.0) azimuth += 360.0;
     if (azimuth > 360.0) azimuth -= 360.0;
 
-    NaifStatus::CheckErrors();
-
     // computed is true if the sample/line or lat/lon were reset in this method
     // to find the location of the point of interest
     // If so, reset "state" of camera to the original sample/line
@@ -231,6 +231,9 @@ namespace Isis {
    *   @history 2021-03-04 Victor Silva - Made changes to GetLocalNormal to calculate local normal
    *                           accurately for LRO by changing 4 corner surrounding points from adding
    *                           0.5 to line and sample and wrapping value with nexttoward.Fixes #4018.
+   *   @history 2026-10-16 Isis Development Team - Added clone(), which creates a camera that shares
+   *                           this camera's cached SPICE for use on another thread, and
+   *                           evaluatesWithoutNaif().
    */
 
   class Camera : public Sensor {
@@ -242,6 +245,9 @@ namespace Isis {
       //! Destroys the Camera Object
       virtual ~Camera();
 
+      Camera *clone(Cube &cube);
+      bool evaluatesWithoutNaif();
+
       // Methods
       virtual bool SetImage(const double sample, const double line);
       virtual bool SetImage(const double sample, const double line, const double deltaT);
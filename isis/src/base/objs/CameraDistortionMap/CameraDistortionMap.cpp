@@ -64,6 +64,20 @@ namespace Isis {
   }
 
 
+  /**
+   * Copies the distortion coefficients and z direction of another distortion
+   * map of the same type, such as the map of the camera a camera was cloned
+   * from. Distortion maps that keep coefficients of their own can reimplement
+   * this method to copy them too.
+   *
+   * @param map The distortion map to copy the distortion of
+   */
+  void CameraDistortionMap::CopyDistortion(const CameraDistortionMap &map) {
+    p_odk = map.p_odk;
+    p_zDirection = map.p_zDirection;
+  }
+
+
   /**
    * Compute undistorted focal plane x/y
    *
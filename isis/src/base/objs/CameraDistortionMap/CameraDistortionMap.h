@@ -37,12 +37,14 @@ namespace Isis {
    *   @history 2017-09-04 Kristin Berry - Made SetDistortion virtual so that
    *                           individual camera model distortion maps can
    *                           set the values.
+   *   @history 2026-10-16 Isis Development Team - Added CopyDistortion() for cloned cameras.
    */
   class CameraDistortionMap {
     public:
       CameraDistortionMap(Camera *parent, double zDirection = 1.0);
 
       virtual void SetDistortion(int naifIkCode);
+      virtual void CopyDistortion(const CameraDistortionMap &map);
 
       virtual ~CameraDistortionMap();
 
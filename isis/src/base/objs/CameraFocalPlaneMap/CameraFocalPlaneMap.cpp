@@ -392,6 +392,27 @@ namespace Isis {
   }
 
 
+  /**
+   * Copies the affine coefficients and the detector origin and offset of another
+   * focal plane map, such as the map of the camera a camera was cloned from.
+   *
+   * @param map The focal plane map to copy the transforms of
+   */
+  void CameraFocalPlaneMap::CopyTransforms(const CameraFocalPlaneMap &map) {
+    for (int i = 0; i < 3; i++) {
+      p_transx[i] = map.p_transx[i];
+      p_transy[i] = map.p_transy[i];
+      p_itranss[i] = map.p_itranss[i];
+      p_itransl[i] = map.p_itransl[i];
+    }
+
+    p_detectorSampleOrigin = map.p_detectorSampleOrigin;
+    p_detectorLineOrigin = map.p_detectorLineOrigin;
+    p_detectorSampleOffset = map.p_detectorSampleOffset;
+    p_detectorLineOffset = map.p_detectorLineOffset;
+  }
+
+
   /**
    * @return The affine coefficients for converting detector (sample,line) to a distorted X
    */
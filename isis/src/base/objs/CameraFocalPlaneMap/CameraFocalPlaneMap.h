@@ -80,6 +80,7 @@ namespace Isis {
    *                           required for non-NAIF instruments such as
    *                           Aerial photos.
    *   @history 2017-08-30 Summer Stapleton - Updated documentation. References #4807.
+   *   @history 2026-10-16 Isis Development Team - Added CopyTransforms() for cloned cameras.
    *  
    */
   class CameraFocalPlaneMap {
@@ -110,6 +111,7 @@ namespace Isis {
       void SetTransS(const QVector<double> transS);
       void SetTransX(const QVector<double> transX);
       void SetTransY(const QVector<double> transY);
+      void CopyTransforms(const CameraFocalPlaneMap &map);
 
       const double *TransL() const;
       const double *TransS() const;
@@ -15,7 +15,6 @@ find files of those names at the top level of this repository. **/
 #include "IException.h"
 #include "Latitude.h"
 #include "Longitude.h"
-#include "NaifStatus.h"
 #include "SurfacePoint.h"
 #include "Target.h"
 
@@ -48,8 +47,6 @@ namespace Isis {
    * @return @b bool If conversion was successful
    */
   bool CameraGroundMap::SetFocalPlane(const double ux, const double uy, const double uz) {
-    NaifStatus::CheckErrors();
-
     SpiceDouble lookC[3];
     lookC[0] = ux;
     lookC[1] = uy;
@@ -58,8 +55,6 @@ namespace Isis {
     SpiceDouble unitLookC[3];
     vhat_c(lookC, unitLookC);
 
-    NaifStatus::CheckErrors();
-
     bool result = p_camera->SetLookDirection(unitLookC);
     return result;
   }
@@ -73,6 +73,8 @@ namespace Isis {
    *  @history 2018-07-26 Kris Becker - Move all local variables  and methods to
    *                         protected scope so derived objects can be developed
    *                         properly
+   *  @history 2026-10-16 Isis Development Team - SetFocalPlane() no longer checks the NAIF error
+   *                          state, because unitizing the look direction cannot signal an error.
    */
   class CameraGroundMap {
     public:
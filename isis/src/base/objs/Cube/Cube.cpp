@@ -6,6 +6,7 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Cube.h"
 
+#include <algorithm>
 #include <sstream>
 #include <unistd.h>
 
@@ -13,14 +14,21 @@ find files of those names at the top level of this repository. **/
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QFuture>
 #include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtConcurrentMap>
 
 #include "Application.h"
 #include "Blob.h"
+#include "BufferManager.h"
 #include "Camera.h"
 #include "CameraFactory.h"
 #include "CubeAttribute.h"
 #include "CubeBsqHandler.h"
+#include "CubeCompressedTileHandler.h"
 #include "CubeTileHandler.h"
 #include "CubeStretch.h"
 #include "Endian.h"
@@ -35,6 +43,7 @@ find files of those names at the top level of this repository. **/
 #include "OriginalXmlLabel.h"
 #include "Preference.h"
 #include "ProgramLauncher.h"
+#include "Progress.h"
 #include "Projection.h"
 #include "SpecialPixel.h"
 #include "Statistics.h"
@@ -162,6 +171,9 @@ namespace Isis {
     delete m_mutex;
     m_mutex = NULL;
 
+    delete m_overviewHandlers;
+    m_overviewHandlers = NULL;
+
     delete m_camera;
     m_camera = NULL;
 
@@ -560,6 +572,10 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                        dataAlreadyOnDisk);
     }
+    else if (m_format == CompressedTile) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+                                                  realDataFileLabel(), dataAlreadyOnDisk);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                         dataAlreadyOnDisk);
@@ -755,6 +771,10 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
     }
+    else if (m_format == CompressedTile) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+          realDataFileLabel(), true);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
@@ -828,7 +848,8 @@ namespace Isis {
 
   /**
    * This method will read a buffer of data from the cube as specified by the
-   * contents of the Buffer object.
+   * contents of the Buffer object. This is thread-safe; for cubes opened
+   * read-only, reads from different threads do not block each other.
    *
    * @param bufferToFill Buffer to be loaded
    */
@@ -838,11 +859,90 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
+    // Read-only cubes can be read from many threads at once without
+    //   serializing on the cube.
+    if (m_ioHandler->supportsConcurrentReads()) {
+      m_ioHandler->read(bufferToFill);
+      return;
+    }
+
     QMutexLocker locker(m_mutex);
     m_ioHandler->read(bufferToFill);
   }
 
 
+  /**
+   * This method will read a buffer of data from an overview of the cube. The
+   * buffer's positions are in the overview, which has
+   * overviewSampleCount(reductionFactor) samples,
+   * overviewLineCount(reductionFactor) lines and the bands of the cube. This
+   * is thread-safe like read(Buffer &).
+   *
+   * @param bufferToFill Buffer to be loaded
+   * @param reductionFactor The reduction factor of the overview to read
+   *
+   * @throws IException::Programmer The cube has no overview with the reduction factor
+   */
+  void Cube::read(Buffer &bufferToFill, int reductionFactor) const {
+    if (!isOpen()) {
+      string msg = "Try opening a file before you read it";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    CubeIoHandler *handler = NULL;
+    {
+      QMutexLocker locker(m_mutex);
+      handler = overviewHandler(reductionFactor);
+    }
+
+    if (handler->supportsConcurrentReads()) {
+      handler->read(bufferToFill);
+      return;
+    }
+
+    QMutexLocker locker(m_mutex);
+    QMutexLocker locker2(m_ioHandler->dataFileMutex());
+    handler->read(bufferToFill);
+  }
+
+
+  /**
+   * Hint that the positions following the current position of a buffer
+   * manager are about to be read, so that their cube data can be loaded in the
+   * background while the current buffer is processed. This is intended to be
+   * called once per position of a traversal, right after reading the current
+   * position. Every call hints the next count positions, wherever the
+   * traversal started or jumped to, and the chunks that are already cached or
+   * being loaded are skipped.
+   *
+   * This only has an effect on cubes opened read-only, and never changes what
+   * is read.
+   *
+   * @param upcoming The buffer manager that is walking the cube
+   * @param count How many positions to look ahead
+   */
+  void Cube::prefetch(const BufferManager &upcoming, int count) const {
+    if (!isOpen() || !m_ioHandler->supportsConcurrentReads()) {
+      return;
+    }
+
+    BigInt current = upcoming.currentMap();
+    BigInt first = current + 1;
+    BigInt last = qMin(current + count, upcoming.mapCount() - 1);
+
+    for (BigInt map = first; map <= last; map++) {
+      int sample = 0;
+      int line = 0;
+      int band = 0;
+      upcoming.mapPosition(map, sample, line, band);
+
+      m_ioHandler->prefetch(sample, upcoming.SampleDimension(),
+                            line, upcoming.LineDimension(),
+                            band, upcoming.BandDimension());
+    }
+  }
+
+
   /**
    * Read the History from the Cube.
    *
@@ -1140,10 +1240,221 @@ namespace Isis {
     }
 
     QMutexLocker locker(m_mutex);
+
+    // The overviews were reduced from the old DNs
+    if (m_label->hasObject("Overview")) {
+      QMutexLocker locker2(m_ioHandler->dataFileMutex());
+      removeOverviews();
+    }
+
     m_ioHandler->write(bufferToWrite);
   }
 
 
+  /**
+   * This method will write a buffer of data to an overview of the cube. The
+   * buffer's positions are in the overview, see read(Buffer &, int).
+   *
+   * @param bufferToWrite Buffer to be written
+   * @param reductionFactor The reduction factor of the overview to write
+   *
+   * @throws IException::Programmer The cube has no overview with the reduction factor
+   */
+  void Cube::write(Buffer &bufferToWrite, int reductionFactor) {
+    if (!isOpen()) {
+      string msg = "Tried to write to a cube before opening/creating it";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (isReadOnly()) {
+      QString msg = "Cannot write to the cube [" + (QString)QFileInfo(fileName()).fileName() +
+          "] because it is opened read-only";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QMutexLocker locker(m_mutex);
+    QMutexLocker locker2(m_ioHandler->dataFileMutex());
+    overviewHandler(reductionFactor)->write(bufferToWrite);
+  }
+
+
+  /**
+   * Adds an overview to the cube. An overview is a reduced resolution copy of
+   * the cube's DN data, which lets programs read coarse data without
+   * resampling the whole cube. Its sample and line counts are the cube's
+   * divided by the reduction factor, rounded up, and it has the cube's bands,
+   * pixel type, base and multiplier.
+   *
+   * The overview is stored tiled in the data file, after the cube data, in
+   * the first space not used by a blob or another overview, and described by
+   * an Overview object in the labels. It starts out with every DN zero;
+   * write the reduced data to it with write(Buffer &, int). Writing to the
+   * cube's own DNs removes every overview, because they no longer match.
+   *
+   * @param reductionFactor The reduction factor of the overview, at least 2
+   *
+   * @throws IException::Programmer The reduction factor is less than 2 or
+   *                                already has an overview
+   * @throws IException::User The cube does not store its own DN data
+   * @throws IException::Io The data file could not be extended
+   */
+  void Cube::addOverview(int reductionFactor) {
+    if (!isOpen()) {
+      string msg = "Tried to add an overview to a cube before opening/creating it";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (isReadOnly()) {
+      QString msg = "Cannot add an overview to the cube [" +
+          (QString)QFileInfo(fileName()).fileName() + "] because it is opened read-only";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (!m_storesDnData) {
+      QString msg = "The cube [" + QFileInfo(fileName()).fileName() +
+          "] does not support overviews because it is using an external file for DNs";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    if (reductionFactor < 2) {
+      QString msg = "Overview reduction factors must be at least 2, not [" +
+          toString(reductionFactor) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (hasOverview(reductionFactor)) {
+      QString msg = "The cube [" + QFileInfo(fileName()).fileName() +
+          "] already has an overview reduced by a factor of [" + toString(reductionFactor) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int samples = (sampleCount() + reductionFactor - 1) / reductionFactor;
+    int lines = (lineCount() + reductionFactor - 1) / reductionFactor;
+    int tileSamples = std::min(samples, 256);
+    int tileLines = std::min(lines, 256);
+
+    BigInt bytes = (BigInt)((samples + tileSamples - 1) / tileSamples) *
+                   (BigInt)((lines + tileLines - 1) / tileLines) *
+                   (BigInt)m_bands * tileSamples * tileLines * SizeOf(m_pixelType);
+
+    QMutexLocker locker(m_mutex);
+    QMutexLocker locker2(m_ioHandler->dataFileMutex());
+
+    BigInt startByte = overviewStartByte(bytes);
+    BigInt fileBytes = dataFile()->size();
+    if (startByte + bytes > fileBytes && !dataFile()->resize(startByte + bytes)) {
+      QString msg = "Unable to make room for an overview in [" + dataFile()->fileName() + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    // Space left by deleted overviews or blobs still has their data
+    if (startByte < fileBytes) {
+      BigInt reusedBytes = std::min(bytes, fileBytes - startByte);
+      QByteArray zeros(std::min(reusedBytes, (BigInt)(1024 * 1024)), '\0');
+      bool zeroed = dataFile()->seek(startByte);
+      for (BigInt zeroedBytes = 0; zeroed && zeroedBytes < reusedBytes;
+           zeroedBytes += zeros.size()) {
+        qint64 chunkBytes = std::min((BigInt)zeros.size(), reusedBytes - zeroedBytes);
+        zeroed = (dataFile()->write(zeros.constData(), chunkBytes) == chunkBytes);
+      }
+
+      if (!zeroed) {
+        QString msg = "Unable to clear the space for an overview in [" +
+                      dataFile()->fileName() + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+    }
+
+    PvlObject overviewObject("Overview");
+    overviewObject += PvlKeyword("Name", "Overview" + toString(reductionFactor));
+    overviewObject += PvlKeyword("ReductionFactor", toString(reductionFactor));
+    overviewObject += PvlKeyword("StartByte", toString(startByte + 1));
+    overviewObject += PvlKeyword("Bytes", toString(bytes));
+    overviewObject += PvlKeyword("Samples", toString(samples));
+    overviewObject += PvlKeyword("Lines", toString(lines));
+    overviewObject += PvlKeyword("Bands", toString(m_bands));
+    overviewObject += PvlKeyword("TileSamples", toString(tileSamples));
+    overviewObject += PvlKeyword("TileLines", toString(tileLines));
+    m_label->addObject(overviewObject);
+  }
+
+
+  /**
+   * Removes every overview from the cube's labels. Their space at the end of
+   * the data file is truncated, and addOverview reuses the rest.
+   */
+  void Cube::deleteOverviews() {
+    if (isReadOnly()) {
+      QString msg = "Cannot delete the overviews of the cube [" +
+          (QString)QFileInfo(fileName()).fileName() + "] because it is opened read-only";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QMutexLocker locker(m_mutex);
+    QMutexLocker locker2(m_ioHandler->dataFileMutex());
+    removeOverviews();
+  }
+
+
+  /**
+   * Check to see if the cube has an overview with the given reduction factor.
+   *
+   * @param reductionFactor The reduction factor to look for
+   *
+   * @return bool True if the cube has the overview
+   */
+  bool Cube::hasOverview(int reductionFactor) const {
+    return overviewReductionFactors().contains(reductionFactor);
+  }
+
+
+  /**
+   * Returns the reduction factors of the cube's overviews, from the finest
+   * to the coarsest.
+   *
+   * @return QList<int> The reduction factors of the overviews
+   */
+  QList<int> Cube::overviewReductionFactors() const {
+    QList<int> reductionFactors;
+
+    if (m_label) {
+      for (int i = 0; i < m_label->objects(); i++) {
+        const PvlObject &obj = m_label->object(i);
+        if (obj.isNamed("Overview")) {
+          reductionFactors.append((int)obj["ReductionFactor"]);
+        }
+      }
+    }
+
+    std::sort(reductionFactors.begin(), reductionFactors.end());
+    return reductionFactors;
+  }
+
+
+  /**
+   * Returns the number of samples in an overview of the cube.
+   *
+   * @param reductionFactor The reduction factor of the overview
+   *
+   * @return int The number of samples in the overview
+   */
+  int Cube::overviewSampleCount(int reductionFactor) const {
+    return overview(reductionFactor)["Samples"];
+  }
+
+
+  /**
+   * Returns the number of lines in an overview of the cube.
+   *
+   * @param reductionFactor The reduction factor of the overview
+   *
+   * @return int The number of lines in the overview
+   */
+  int Cube::overviewLineCount(int reductionFactor) const {
+    return overview(reductionFactor)["Lines"];
+  }
+
+
   /**
    * Used prior to the Create method, this will specify the base and multiplier
    * for converting 8-bit/16-bit back and forth between 32-bit:
@@ -1264,10 +1575,10 @@ namespace Isis {
 
   /**
    * Used prior to the Create method, this will specify the format of the cube,
-   * either band, sequential or tiled.
+   * either band sequential, tiled or compressed tiles.
    * If not invoked, a tiled file will be created.
    *
-   * @param format An enumeration of either Bsq or Tile.
+   * @param format An enumeration of Bsq, Tile or CompressedTile.
    */
   void Cube::setFormat(Format format) {
     openCheck();
@@ -1345,6 +1656,10 @@ namespace Isis {
     if (m_ioHandler) {
       m_ioHandler->setVirtualBands(m_virtualBandList);
     }
+
+    foreach (CubeIoHandler *handler, *m_overviewHandlers) {
+      handler->setVirtualBands(m_virtualBandList);
+    }
   }
 
 
@@ -1583,6 +1898,101 @@ namespace Isis {
   }
 
 
+  /**
+   * Add every line of the given bands to a Statistics or Histogram, using the
+   *   global thread pool. The lines are split into a fixed number of parts,
+   *   each part is added to an empty copy of the result, and the copies are
+   *   merged into the result in part order. Statistics::merge adds the sums of
+   *   the parts with compensated summation. Since the parts do not depend on
+   *   the number of threads, the result is the same on any machine.
+   *
+   * @param result The Statistics or Histogram to add the lines to. Copies of
+   *          it must have the same valid range and bins.
+   * @param bandStart The first band to add
+   * @param bandStop The last band to add
+   * @param progress Progress to report the parts that are done to; the text
+   *          should already be set.
+   */
+  template <typename Accumulator>
+  void Cube::accumulateLines(Accumulator &result, int bandStart, int bandStop,
+                             Progress &progress) const {
+    // Enough parts to keep every thread busy on most machines while keeping
+    //   the number of (possibly large) histogram copies small.
+    const BigInt maxParts = 64;
+
+    BigInt lines = lineCount();
+    BigInt rows = lines * (bandStop - bandStart + 1);
+    int parts = (int)qMin(rows, maxParts);
+
+    QVector<Accumulator *> partials(parts, NULL);
+    QList<int> partIndices;
+    for (int part = 0; part < parts; part++) {
+      partIndices.append(part);
+    }
+
+    QMutex partMutex;
+    QWaitCondition partDone;
+    int partsDone = 0;
+    QList<IException> errors;
+
+    auto accumulatePart = [&](int part) {
+      try {
+        Accumulator *partial = new Accumulator(result);
+        partial->Reset();
+        partials[part] = partial;
+
+        LineManager line(*this);
+        for (BigInt row = rows * part / parts; row < rows * (part + 1) / parts; row++) {
+          line.SetLine(row % lines + 1, bandStart + row / lines);
+          read(line);
+          partial->AddData(line.DoubleBuffer(), line.size());
+        }
+      }
+      catch (IException &e) {
+        QMutexLocker locker(&partMutex);
+        errors.append(e);
+      }
+
+      QMutexLocker locker(&partMutex);
+      partsDone++;
+      partDone.wakeAll();
+    };
+
+    progress.SetMaximumSteps(parts);
+    progress.CheckStatus();
+
+    QFuture<void> future = QtConcurrent::map(partIndices, accumulatePart);
+
+    // Report progress from this thread, sleeping until the next part is done
+    int reportedParts = 0;
+    while (reportedParts < parts) {
+      partMutex.lock();
+      while (partsDone == reportedParts) {
+        partDone.wait(&partMutex);
+      }
+      int doneParts = partsDone;
+      partMutex.unlock();
+
+      for (; reportedParts < doneParts; reportedParts++) {
+        progress.CheckStatus();
+      }
+    }
+    future.waitForFinished();
+
+    for (int part = 0; part < parts; part++) {
+      if (errors.isEmpty()) {
+        result.merge(*partials[part]);
+      }
+      delete partials[part];
+    }
+
+    if (!errors.isEmpty()) {
+      throw errors.first();
+    }
+  }
+  }
+
+
   /**
    * This method returns a pointer to a Histogram object
    * which allows the program to obtain and use various statistics and
@@ -1648,16 +2058,13 @@ namespace Isis {
 
     int bandStart = band;
     int bandStop = band;
-    int maxSteps = lineCount();
     if (band == 0) {
       bandStart = 1;
       bandStop = bandCount();
-      maxSteps = lineCount() * bandCount();
     }
 
     Progress progress;
-    Histogram *hist = new ImageHistogram(*this, band, &progress);
-    LineManager line(*this);
+    ImageHistogram *hist = new ImageHistogram(*this, band, &progress);
 
     // This range is for throwing out data; the default parameters are OK always
     //hist->SetValidRange(validMin, validMax);
@@ -1679,16 +2086,13 @@ namespace Isis {
 
     // Loop and get the histogram
     progress.SetText(msg);
-    progress.SetMaximumSteps(maxSteps);
-    progress.CheckStatus();
 
-    for(int useBand = bandStart ; useBand <= bandStop ; useBand++) {
-      for(int i = 1; i <= lineCount(); i++) {
-        line.SetLine(i, useBand);
-        read(line);
-        hist->AddData(line.DoubleBuffer(), line.size());
-        progress.CheckStatus();
-      }
+    try {
+      accumulateLines(*hist, bandStart, bandStop, progress);
+    }
+    catch (...) {
+      delete hist;
+      throw;
     }
 
     return hist;
@@ -1868,34 +2272,28 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
-    // Construct a line buffer manager and a statistics object
-    LineManager line(*this);
+    // Construct a statistics object
     Statistics *stats = new Statistics();
 
     stats->SetValidRange(validMin, validMax);
 
     int bandStart = band;
     int bandStop = band;
-    int maxSteps = lineCount();
     if (band == 0) {
       bandStart = 1;
       bandStop = bandCount();
-      maxSteps = lineCount() * bandCount();
     }
 
     Progress progress;
     progress.SetText(msg);
-    progress.SetMaximumSteps(maxSteps);
-    progress.CheckStatus();
 
     // Loop and get the statistics for a good minimum/maximum
-    for(int useBand = bandStart ; useBand <= bandStop ; useBand++) {
-      for(int i = 1; i <= lineCount(); i++) {
-        line.SetLine(i, useBand);
-        read(line);
-        stats->AddData(line.DoubleBuffer(), line.size());
-        progress.CheckStatus();
-      }
+    try {
+      accumulateLines(*stats, bandStart, bandStop, progress);
+    }
+    catch (...) {
+      delete stats;
+      throw;
     }
 
     return stats;
@@ -2110,6 +2508,8 @@ namespace Isis {
    * @param removeIt If true, the input cube will be removed from disk
    */
   void Cube::cleanUp(bool removeIt) {
+    deleteOverviewHandlers();
+
     if (m_ioHandler) {
       delete m_ioHandler;
       m_ioHandler = NULL;
@@ -2175,6 +2575,7 @@ namespace Isis {
     m_virtualBandList = NULL;
 
     m_mutex = new QMutex();
+    m_overviewHandlers = new QMap<int, CubeIoHandler *>;
     m_formatTemplateFile =
          new FileName("$ISISROOT/appdata/templates/labels/CubeFormatTemplate.pft");
 
@@ -2196,6 +2597,168 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the label object that describes an overview of the cube.
+   *
+   * @param reductionFactor The reduction factor of the overview
+   *
+   * @throws IException::Programmer The cube has no overview with the reduction factor
+   *
+   * @return const PvlObject& The Overview object of the labels
+   */
+  const PvlObject &Cube::overview(int reductionFactor) const {
+    if (m_label) {
+      for (int i = 0; i < m_label->objects(); i++) {
+        const PvlObject &obj = m_label->object(i);
+        if (obj.isNamed("Overview") && (int)obj["ReductionFactor"] == reductionFactor) {
+          return obj;
+        }
+      }
+    }
+
+    QString msg = "The cube [" + QFileInfo(fileName()).fileName() +
+        "] has no overview reduced by a factor of [" + toString(reductionFactor) + "]";
+    throw IException(IException::Programmer, msg, _FILEINFO_);
+  }
+
+
+  /**
+   * Returns the IO handler of an overview, creating it the first time. The
+   *   handler reads the overview's region of the data file like a tiled cube
+   *   with the dimensions of the overview. The cube's mutex must be locked.
+   *
+   * @param reductionFactor The reduction factor of the overview
+   *
+   * @return CubeIoHandler* The IO handler of the overview
+   */
+  CubeIoHandler *Cube::overviewHandler(int reductionFactor) const {
+    if (m_overviewHandlers->contains(reductionFactor)) {
+      return m_overviewHandlers->value(reductionFactor);
+    }
+
+    const PvlObject &overviewObject = overview(reductionFactor);
+
+    PvlObject core("Core");
+    core += PvlKeyword("StartByte", overviewObject["StartByte"][0]);
+    core += PvlKeyword("Format", "Tile");
+    core += PvlKeyword("TileSamples", overviewObject["TileSamples"][0]);
+    core += PvlKeyword("TileLines", overviewObject["TileLines"][0]);
+
+    PvlGroup dims("Dimensions");
+    dims += PvlKeyword("Samples", overviewObject["Samples"][0]);
+    dims += PvlKeyword("Lines", overviewObject["Lines"][0]);
+    dims += PvlKeyword("Bands", overviewObject["Bands"][0]);
+    core.addGroup(dims);
+
+    // Overviews are only added to cubes that store their own DNs
+    core.addGroup(m_label->findObject("IsisCube").findObject("Core").findGroup("Pixels"));
+
+    PvlObject isisCube("IsisCube");
+    isisCube.addObject(core);
+
+    Pvl overviewLabel;
+    overviewLabel.addObject(isisCube);
+
+    // The overview's region of the data file was allocated by addOverview
+    CubeIoHandler *handler = new CubeTileHandler(dataFile(), m_virtualBandList, overviewLabel,
+                                                 true);
+    m_overviewHandlers->insert(reductionFactor, handler);
+    return handler;
+  }
+
+
+  /**
+   * Returns where a new overview goes in the data file: the first space after
+   *   the cube data that is large enough and is not used by a blob or another
+   *   overview, or else the end of the used space. The cube's mutex and the
+   *   data file mutex must be locked.
+   *
+   * @param bytes The size of the overview
+   *
+   * @return BigInt The 0-based byte of the data file the overview starts at
+   */
+  BigInt Cube::overviewStartByte(BigInt bytes) const {
+    BigInt startByte =
+        (BigInt)m_label->findObject("IsisCube").findObject("Core")["StartByte"] - 1 +
+        m_ioHandler->getDataSize();
+
+    QList< QPair<BigInt, BigInt> > usedSpace = dataFileUsedSpace();
+    std::sort(usedSpace.begin(), usedSpace.end());
+
+    for (int i = 0; i < usedSpace.size(); i++) {
+      if (usedSpace[i].first >= startByte + bytes) {
+        break;
+      }
+
+      startByte = std::max(startByte, usedSpace[i].second);
+    }
+
+    return startByte;
+  }
+
+
+  /**
+   * Returns the space of the data file used by blobs and overviews. Blobs are
+   *   only in the data file when the labels are attached.
+   *
+   * @return QList< QPair<BigInt, BigInt> > The 0-based first byte and the byte
+   *                                        after the end of each
+   */
+  QList< QPair<BigInt, BigInt> > Cube::dataFileUsedSpace() const {
+    QList< QPair<BigInt, BigInt> > usedSpace;
+
+    for (int i = 0; i < m_label->objects(); i++) {
+      const PvlObject &obj = m_label->object(i);
+      if ((m_attached || obj.isNamed("Overview")) &&
+          obj.hasKeyword("StartByte") && obj.hasKeyword("Bytes")) {
+        BigInt startByte = (BigInt)obj["StartByte"] - 1;
+        usedSpace.append(qMakePair(startByte, startByte + (BigInt)obj["Bytes"]));
+      }
+    }
+
+    return usedSpace;
+  }
+
+
+  /**
+   * Removes every overview from the labels and truncates the data file after
+   *   the space that is still used. The cube's mutex and the data file mutex
+   *   must be locked.
+   */
+  void Cube::removeOverviews() {
+    deleteOverviewHandlers();
+
+    for (int i = m_label->objects() - 1; i >= 0; i--) {
+      if (m_label->object(i).isNamed("Overview")) {
+        m_label->deleteObject(i);
+      }
+    }
+
+    BigInt usedBytes =
+        (BigInt)m_label->findObject("IsisCube").findObject("Core")["StartByte"] - 1 +
+        m_ioHandler->getDataSize();
+    QList< QPair<BigInt, BigInt> > usedSpace = dataFileUsedSpace();
+    for (int i = 0; i < usedSpace.size(); i++) {
+      usedBytes = std::max(usedBytes, usedSpace[i].second);
+    }
+
+    if (dataFile()->size() > usedBytes) {
+      dataFile()->resize(usedBytes);
+    }
+  }
+
+
+  /**
+   * Writes the cached overview data to disk and deletes the overview IO handlers.
+   */
+  void Cube::deleteOverviewHandlers() {
+    foreach (CubeIoHandler *handler, *m_overviewHandlers) {
+      delete handler;
+    }
+    m_overviewHandlers->clear();
+  }
+
+
   /**
    * This gets the file name of the file which actually contains the DN data. With ecub's, our
    *    data file name could be another ecub or a detached label, so using m_dataFileName is
@@ -2311,6 +2874,9 @@ namespace Isis {
       if ((QString) core["Format"] == "BandSequential") {
         m_format = Bsq;
       }
+      else if ((QString) core["Format"] == "CompressedTile") {
+        m_format = CompressedTile;
+      }
       else {
         m_format = Tile;
       }
@@ -27,6 +27,7 @@ class QString;
 namespace Isis {
   class Blob;
   class Buffer;
+  class BufferManager;
   class Camera;
   class CubeAttributeOutput;
   class CubeCachingAlgorithm;
@@ -36,6 +37,7 @@ namespace Isis {
   class Projection;
   class Pvl;
   class PvlGroup;
+  class PvlObject;
   class Statistics;
   class Table;
   class Histogram;
@@ -43,6 +45,7 @@ namespace Isis {
   class OriginalLabel;
   class OriginalXmlLabel;
   class ImagePolygon;
+  class Progress;
 
 
   /**
@@ -230,7 +233,15 @@ namespace Isis {
          * The symbol '*' denotes tile boundaries.
          * The symbols '-' and '|' denote cube boundaries.
          */
-        Tile
+        Tile,
+        /**
+         * Cubes are stored as tiles like the Tile format, but each tile is
+         *   zlib compressed and tiles that are entirely NULL are not stored at
+         *   all. The data starts with an index giving the offset and size of
+         *   every tile. This keeps mostly-NULL cubes, like mosaics, small on
+         *   disk.
+         */
+        CompressedTile
       };
 
       void fromIsd(const FileName &fileName, Pvl &label, nlohmann::json &isd, QString access);
@@ -256,6 +267,8 @@ namespace Isis {
       void read(Blob &blob,
                 const std::vector<PvlKeyword> keywords = std::vector<PvlKeyword>()) const;
       void read(Buffer &rbuf) const;
+      void read(Buffer &rbuf, int reductionFactor) const;
+      void prefetch(const BufferManager &upcoming, int count = 16) const;
       OriginalLabel readOriginalLabel(const QString &name="IsisCube") const;
       CubeStretch readCubeStretch(QString name="CubeStretch",
                                   const std::vector<PvlKeyword> keywords = std::vector<PvlKeyword>()) const;
@@ -271,6 +284,14 @@ namespace Isis {
       void write(History &history, const QString &name = "IsisCube");
       void write(const ImagePolygon &polygon);
       void write(Buffer &wbuf);
+      void write(Buffer &wbuf, int reductionFactor);
+
+      void addOverview(int reductionFactor);
+      void deleteOverviews();
+      bool hasOverview(int reductionFactor) const;
+      QList<int> overviewReductionFactors() const;
+      int overviewSampleCount(int reductionFactor) const;
+      int overviewLineCount(int reductionFactor) const;
 
       void setBaseMultiplier(double base, double mult);
       void setMinMax(double min, double max);
@@ -328,6 +349,9 @@ namespace Isis {
 
 
     private:
+      template <typename Accumulator>
+      void accumulateLines(Accumulator &result, int bandStart, int bandStop,
+                           Progress &progress) const;
       void applyVirtualBandsToLabel();
       void cleanUp(bool remove);
 
@@ -335,6 +359,13 @@ namespace Isis {
       QFile *dataFile() const;
       FileName realDataFileName() const;
 
+      const PvlObject &overview(int reductionFactor) const;
+      CubeIoHandler *overviewHandler(int reductionFactor) const;
+      void deleteOverviewHandlers();
+      BigInt overviewStartByte(BigInt bytes) const;
+      QList< QPair<BigInt, BigInt> > dataFileUsedSpace() const;
+      void removeOverviews();
+
       void initialize();
       void initCoreFromLabel(const Pvl &label);
       void initLabelFromFile(FileName labelFileName, bool readWrite);
@@ -451,6 +482,12 @@ namespace Isis {
 
       //! If allocated, converts from physical on-disk band # to virtual band #
       QList<int> *m_virtualBandList;
+
+      /**
+       * The IO handlers of the overviews that have been read or written, by
+       *   reduction factor. They are created when first used.
+       */
+      QMap<int, CubeIoHandler *> *m_overviewHandlers;
   };
 }
 
@@ -0,0 +1,369 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "CubeCompressedTileHandler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <unistd.h>
+
+#include <QFile>
+#include <QtEndian>
+
+#include "CubeTileHandler.h"
+#include "EndianSwapper.h"
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "RawCubeChunk.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Construct a compressed tile handler. New cubes get the same tile size the
+   *   tile format would use and an index where every chunk is NULL.
+   *
+   * @param dataFile The file with cube DN data in it
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   */
+  CubeCompressedTileHandler::CubeCompressedTileHandler(QFile * dataFile,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
+      : CubeIoHandler(dataFile, virtualBandList, labels, alreadyOnDisk) {
+
+    const PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+
+    if (core.hasKeyword("Format")) {
+      if (core.hasKeyword("Compression") &&
+          core["Compression"][0].toUpper() != "ZLIB") {
+        QString msg = "Compression [" + core["Compression"][0] + "] is not "
+            "supported for compressed tile cubes";
+        throw IException(IException::Unknown, msg, _FILEINFO_);
+      }
+
+      setChunkSizes(core["TileSamples"], core["TileLines"], 1);
+    }
+    else {
+      // up to 1MB chunks, the same as the tile format
+      int sampleChunkSize = CubeTileHandler::findGoodSize(
+          512 * 4 / SizeOf(pixelType()), sampleCount());
+      int lineChunkSize = CubeTileHandler::findGoodSize(
+          512 * 4 / SizeOf(pixelType()), lineCount());
+
+      setChunkSizes(sampleChunkSize, lineChunkSize, 1);
+    }
+
+    initNullChunkData(core.findGroup("Pixels")["ByteOrder"][0]);
+
+    int chunkCount = getChunkCountInSampleDimension() *
+                     getChunkCountInLineDimension() *
+                     getChunkCountInBandDimension();
+    m_chunkOffsets.fill(0, chunkCount);
+    m_chunkSizes.fill(0, chunkCount);
+
+    // The data area of new cubes was zero filled by setChunkSizes(), which
+    //   is an index of all NULL chunks.
+    if (alreadyOnDisk) {
+      readChunkIndex();
+    }
+  }
+
+
+  /**
+   * Writes all data from memory to disk.
+   */
+  CubeCompressedTileHandler::~CubeCompressedTileHandler() {
+    clearCache();
+  }
+
+
+  /**
+   * Update the cube labels so that this cube indicates its format, tile size
+   *   and compression.
+   *
+   * @param labels The "Core" object in this Pvl will be updated
+   */
+  void CubeCompressedTileHandler::updateLabels(Pvl &labels) {
+    PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+    core.addKeyword(PvlKeyword("Format", "CompressedTile"),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("TileSamples", toString(getSampleCountInChunk())),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("TileLines", toString(getLineCountInChunk())),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("Compression", "Zlib"),
+                    PvlContainer::Replace);
+  }
+
+
+  /**
+   * The only space reserved after the data start byte is the chunk index; the
+   *   compressed chunks are appended as they are written.
+   *
+   * @return The number of bytes in the chunk index
+   */
+  BigInt CubeCompressedTileHandler::getDataSize() const {
+    return (BigInt)getChunkCountInSampleDimension() *
+           (BigInt)getChunkCountInLineDimension() *
+           (BigInt)getChunkCountInBandDimension() *
+           (BigInt)s_indexEntryBytes;
+  }
+
+
+  void CubeCompressedTileHandler::readRaw(RawCubeChunk &chunkToFill) {
+    int chunkIndex = getChunkIndex(chunkToFill);
+    BigInt startByte = m_chunkOffsets[chunkIndex];
+    BigInt compressedSize = m_chunkSizes[chunkIndex];
+
+    if (compressedSize == 0) {
+      chunkToFill.setRawData(m_nullChunkData);
+      return;
+    }
+
+    bool success = false;
+
+    QFile * dataFile = getDataFile();
+    if (dataFile->seek(startByte)) {
+      QByteArray compressedData = dataFile->read(compressedSize);
+
+      if (compressedData.size() == compressedSize) {
+        uncompressInto(compressedData, chunkToFill);
+        success = true;
+      }
+    }
+
+    if (!success) {
+      IString msg = "Reading from the file [" + dataFile->fileName() + "] "
+          "failed with reading [" + QString::number(compressedSize) +
+          "] bytes at position [" + QString::number(startByte) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  void CubeCompressedTileHandler::writeRaw(const RawCubeChunk &chunkToWrite) {
+    int chunkIndex = getChunkIndex(chunkToWrite);
+    const QByteArray &rawData = chunkToWrite.getRawData();
+
+    BigInt startByte = 0;
+    BigInt compressedSize = 0;
+
+    bool isNull = (rawData.size() == m_nullChunkData.size() &&
+                   memcmp(rawData.constData(), m_nullChunkData.constData(),
+                          rawData.size()) == 0);
+
+    if (!isNull) {
+      QByteArray compressedData = qCompress(rawData);
+      compressedSize = compressedData.size();
+
+      QFile * dataFile = getDataFile();
+
+      // Reuse the chunk's old space if the new data fits in it
+      if (m_chunkSizes[chunkIndex] >= compressedSize) {
+        startByte = m_chunkOffsets[chunkIndex];
+      }
+      else {
+        startByte = dataFile->size();
+      }
+
+      bool success = false;
+      if (dataFile->seek(startByte)) {
+        BigInt dataWritten = dataFile->write(compressedData);
+
+        if (dataWritten == compressedSize) {
+          success = true;
+        }
+      }
+
+      if (!success) {
+        IString msg = "Writing to the file [" + dataFile->fileName() + "] "
+            "failed with writing [" + QString::number(compressedSize) +
+            "] bytes at position [" + QString::number(startByte) + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+    }
+
+    if (m_chunkOffsets[chunkIndex] != startByte ||
+        m_chunkSizes[chunkIndex] != compressedSize) {
+      m_chunkOffsets[chunkIndex] = startByte;
+      m_chunkSizes[chunkIndex] = compressedSize;
+      writeChunkIndexEntry(chunkIndex);
+    }
+  }
+
+
+  /**
+   * Compressed chunks are not at fixed positions, so they can't be views into
+   *   a memory mapping.
+   *
+   * @return false
+   */
+  bool CubeCompressedTileHandler::isMappable() const {
+    return false;
+  }
+
+
+  /**
+   * Read and uncompress a chunk with pread(). The chunk index does not change
+   *   for read-only cubes, so this is safe to call from many threads at once.
+   *
+   * @param chunkToFill The container that needs to be filled with cube data.
+   */
+  void CubeCompressedTileHandler::readRawConcurrently(RawCubeChunk &chunkToFill) const {
+    int chunkIndex = getChunkIndex(chunkToFill);
+    BigInt startByte = m_chunkOffsets[chunkIndex];
+    BigInt compressedSize = m_chunkSizes[chunkIndex];
+
+    if (compressedSize == 0) {
+      chunkToFill.setRawData(m_nullChunkData);
+      return;
+    }
+
+    QFile * dataFile = const_cast<CubeCompressedTileHandler *>(this)->getDataFile();
+    QByteArray compressedData(compressedSize, '\0');
+    BigInt bytesRead = 0;
+
+    while (bytesRead < compressedSize) {
+      ssize_t result = pread(dataFile->handle(), compressedData.data() + bytesRead,
+                             compressedSize - bytesRead, startByte + bytesRead);
+
+      if (result <= 0) {
+        IString msg = "Reading from the file [" + dataFile->fileName() + "] "
+            "failed with reading [" + QString::number(compressedSize) +
+            "] bytes at position [" + QString::number(startByte) + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      bytesRead += result;
+    }
+
+    uncompressInto(compressedData, chunkToFill);
+  }
+
+
+  /**
+   * Read the whole chunk index from the start of the cube data.
+   */
+  void CubeCompressedTileHandler::readChunkIndex() {
+    QFile * dataFile = getDataFile();
+    QByteArray index;
+
+    if (dataFile->seek(getDataStartByte())) {
+      index = dataFile->read(getDataSize());
+    }
+
+    if (index.size() != getDataSize()) {
+      IString msg = "Reading the chunk index from the file [" +
+          dataFile->fileName() + "] failed with reading [" +
+          QString::number(getDataSize()) + "] bytes at position [" +
+          QString::number(getDataStartByte()) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    const uchar *entry = (const uchar *)index.constData();
+    for (int i = 0; i < m_chunkOffsets.size(); i++) {
+      m_chunkOffsets[i] = qFromLittleEndian<qint64>(entry);
+      m_chunkSizes[i] = qFromLittleEndian<qint64>(entry + 8);
+      entry += s_indexEntryBytes;
+    }
+  }
+
+
+  /**
+   * Write one chunk's entry of the chunk index to disk.
+   *
+   * @param chunkIndex The chunk whose entry changed
+   */
+  void CubeCompressedTileHandler::writeChunkIndexEntry(int chunkIndex) {
+    uchar entry[s_indexEntryBytes];
+    qToLittleEndian<qint64>(m_chunkOffsets[chunkIndex], entry);
+    qToLittleEndian<qint64>(m_chunkSizes[chunkIndex], entry + 8);
+
+    BigInt startByte = getDataStartByte() + (BigInt)chunkIndex * s_indexEntryBytes;
+    bool success = false;
+
+    QFile * dataFile = getDataFile();
+    if (dataFile->seek(startByte)) {
+      success = (dataFile->write((const char *)entry, s_indexEntryBytes) ==
+                 s_indexEntryBytes);
+    }
+
+    if (!success) {
+      IString msg = "Writing the chunk index to the file [" +
+          dataFile->fileName() + "] failed at position [" +
+          QString::number(startByte) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Uncompress a chunk's data into the chunk.
+   *
+   * @param compressedData The chunk's data as stored in the file
+   * @param chunkToFill The container that needs to be filled with cube data.
+   */
+  void CubeCompressedTileHandler::uncompressInto(const QByteArray &compressedData,
+                                                 RawCubeChunk &chunkToFill) const {
+    QByteArray rawData = qUncompress(compressedData);
+
+    if (rawData.size() != chunkToFill.getByteCount()) {
+      QString msg = "Chunk [" + QString::number(getChunkIndex(chunkToFill)) +
+          "] of the cube is corrupt; it uncompressed to [" +
+          QString::number(rawData.size()) + "] bytes instead of [" +
+          QString::number(chunkToFill.getByteCount()) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    chunkToFill.setRawData(rawData);
+  }
+
+
+  /**
+   * Compute the raw bytes of a chunk that is entirely NULL. These are what
+   *   chunks with no compressed data read as, and what writeRaw() compares
+   *   against to decide not to store a chunk.
+   *
+   * @param byteOrder The ByteOrder keyword of the cube's Pixels group
+   */
+  void CubeCompressedTileHandler::initNullChunkData(QString byteOrder) {
+    EndianSwapper swapper(byteOrder.toUpper());
+    int pixelCount = getBytesPerChunk() / SizeOf(pixelType());
+    m_nullChunkData.resize(getBytesPerChunk());
+
+    if (pixelType() == Real) {
+      float raw = NULL4;
+      raw = swapper.Float(&raw);
+      std::fill_n((float *)m_nullChunkData.data(), pixelCount, raw);
+    }
+    else if (pixelType() == SignedWord) {
+      short raw = NULL2;
+      raw = swapper.ShortInt(&raw);
+      std::fill_n((short *)m_nullChunkData.data(), pixelCount, raw);
+    }
+    else if (pixelType() == UnsignedWord) {
+      unsigned short raw = NULLU2;
+      raw = swapper.UnsignedShortInt(&raw);
+      std::fill_n((unsigned short *)m_nullChunkData.data(), pixelCount, raw);
+    }
+    else if (pixelType() == UnsignedInteger) {
+      unsigned int raw = NULLUI4;
+      raw = swapper.Uint32_t(&raw);
+      std::fill_n((unsigned int *)m_nullChunkData.data(), pixelCount, raw);
+    }
+    else {
+      m_nullChunkData.fill(NULL1);
+    }
+  }
+}
@@ -0,0 +1,97 @@
+#ifndef CubeCompressedTileHandler_h
+#define CubeCompressedTileHandler_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "CubeIoHandler.h"
+
+#include <QByteArray>
+#include <QVector>
+
+namespace Isis {
+  /**
+   * @brief IO Handler for Isis Cubes using the compressed tile format.
+   *
+   * Chunks are the same tiles the tile format uses, but each one is stored
+   *   zlib compressed. Since compressed tiles vary in size, the cube data
+   *   starts with a chunk index: for every chunk, in chunk index order, the
+   *   byte offset of its compressed data from the start of the file and the
+   *   number of compressed bytes, both as 64-bit little-endian integers. The
+   *   compressed tiles follow in no particular order. A chunk whose index entry
+   *   has zero compressed bytes is entirely NULL and takes no space at all,
+   *   which is what makes mostly-NULL mosaics small.
+   *
+   * The label's Core object has Format = CompressedTile, TileSamples,
+   *   TileLines and Compression = Zlib. Chunks are read at random like any
+   *   other format.
+   *
+   * A tile that is rewritten with compressed data no larger than before is
+   *   overwritten in place; otherwise it is appended to the file and the space
+   *   it used before is not reclaimed.
+   *
+   * @ingroup LowLevelCubeIO
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class CubeCompressedTileHandler : public CubeIoHandler {
+    public:
+      CubeCompressedTileHandler(QFile * dataFile, const QList<int> *virtualBandList,
+          const Pvl &label, bool alreadyOnDisk);
+      ~CubeCompressedTileHandler();
+
+      void updateLabels(Pvl &label);
+
+      BigInt getDataSize() const;
+
+    protected:
+      virtual void readRaw(RawCubeChunk &chunkToFill);
+      virtual void writeRaw(const RawCubeChunk &chunkToWrite);
+
+      virtual bool isMappable() const;
+      virtual void readRawConcurrently(RawCubeChunk &chunkToFill) const;
+
+    private:
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeCompressedTileHandler(const CubeCompressedTileHandler &other);
+
+      /**
+       * Disallow assignments of this object
+       *
+       * @param other The CubeCompressedTileHandler on the right-hand side of the
+       *              assignment that we are copying into *this.
+       * @return A reference to *this.
+       */
+      CubeCompressedTileHandler &operator=(const CubeCompressedTileHandler &other);
+
+      void readChunkIndex();
+      void writeChunkIndexEntry(int chunkIndex);
+      void uncompressInto(const QByteArray &compressedData,
+                          RawCubeChunk &chunkToFill) const;
+      void initNullChunkData(QString byteOrder);
+
+    private:
+      //! The file offset of each chunk's compressed data, by chunk index
+      QVector<BigInt> m_chunkOffsets;
+
+      //! The size of each chunk's compressed data (0 for NULL chunks)
+      QVector<BigInt> m_chunkSizes;
+
+      //! The raw bytes of a chunk full of NULLs
+      QByteArray m_nullChunkData;
+
+      //! Number of bytes in each chunk index entry (offset and size)
+      static const int s_indexEntryBytes = 16;
+  };
+}
+
+#endif
@@ -10,6 +10,9 @@ find files of those names at the top level of this repository. **/
 #include <cmath>
 #include <iomanip>
 
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <QDebug>
 #include <QFile>
 #include <QList>
@@ -70,6 +73,12 @@ namespace Isis {
     m_writeCache = NULL;
     m_ioThreadPool = NULL;
     m_writeThreadMutex = NULL;
+    m_mappedData = NULL;
+    m_useMappedReads = false;
+    m_concurrentReads = false;
+    m_chunkCacheShards = NULL;
+    m_chunkCacheByteBudget = (qint64)s_defaultChunkCacheMegabytes * 1024 * 1024;
+    m_prefetchThreadPool = NULL;
 
     try {
       if (!dataFile) {
@@ -89,6 +98,27 @@ namespace Isis {
         m_ioThreadPool->setMaxThreadCount(1);
       }
 
+      // Memory mapping is only safe when nobody can write to the cube data
+      if (alreadyOnDisk && !dataFile->isWritable() &&
+          performancePrefs.hasKeyword("CubeReadMapping")) {
+        IString cubeReadPerfOpt = performancePrefs["CubeReadMapping"][0];
+        m_useMappedReads = (cubeReadPerfOpt.DownCase() == "readonly");
+      }
+
+      // Nothing can modify chunks of a read-only cube, so readers only need to
+      //   agree on what is cached.
+      if (alreadyOnDisk && !dataFile->isWritable()) {
+        m_concurrentReads = true;
+        m_chunkCacheShards = new ChunkCacheShard[s_chunkCacheShardCount];
+
+        // Every open read-only cube has its own cache, so programs with many
+        //   inputs (mosaics) need this to stay small
+        if (performancePrefs.hasKeyword("CubeReadCache")) {
+          int megabytes = qMax(0, toInt(performancePrefs["CubeReadCache"][0]));
+          m_chunkCacheByteBudget = (qint64)megabytes * 1024 * 1024;
+        }
+      }
+
       m_consecutiveOverflowCount = 0;
       m_lastOperationWasWrite = false;
       m_rawData = new QMap<int, RawCubeChunk *>;
@@ -125,7 +155,7 @@ namespace Isis {
       m_numLines = dimensions.findKeyword("Lines");
       m_numBands = dimensions.findKeyword("Bands");
 
-      m_startByte = (int)core.findKeyword("StartByte") - 1;
+      m_startByte = (BigInt)core.findKeyword("StartByte") - 1;
 
       m_samplesInChunk = -1;
       m_linesInChunk = -1;
@@ -185,6 +215,24 @@ namespace Isis {
       m_rawData = NULL;
     }
 
+    // Prefetchers use the cache, so stop them first. Queued ones are dropped.
+    if (m_prefetchThreadPool) {
+      m_prefetchThreadPool->clear();
+      m_prefetchThreadPool->waitForDone();
+      delete m_prefetchThreadPool;
+      m_prefetchThreadPool = NULL;
+    }
+
+    if (m_chunkCacheShards) {
+      clearConcurrentCache();
+      delete [] m_chunkCacheShards;
+      m_chunkCacheShards = NULL;
+    }
+
+    // Chunks may be views into the mapping, so this must happen after they
+    //   are gone.
+    unmapDataFile();
+
     if (m_writeCache) {
       delete m_writeCache->first;
       m_writeCache->first = NULL;
@@ -224,6 +272,11 @@ namespace Isis {
    * @param bufferToFill The buffer to populate with cube data.
    */
   void CubeIoHandler::read(Buffer &bufferToFill) const {
+    if (m_concurrentReads) {
+      concurrentRead(bufferToFill);
+      return;
+    }
+
     // We need to record the current chunk count size so we can use
     // it to evaluate if the cache should be minimized
     int lastChunkCount = m_rawData->size();
@@ -242,7 +295,9 @@ namespace Isis {
       }
     }
 
-    QMutexLocker lock(m_writeThreadMutex);
+    // Mapped cubes are read-only and never touch the data file while reading,
+    //   so they do not need to wait on (or block) other users of the file.
+    QMutexLocker lock(m_mappedData ? NULL : m_writeThreadMutex);
 
     // NON-THREADED CUBE READ
     QList<RawCubeChunk *> cubeChunks;
@@ -377,6 +432,11 @@ namespace Isis {
    *                           from the write thread.
    */
   void CubeIoHandler::clearCache(bool blockForWriteCache) const {
+    if (m_concurrentReads) {
+      clearConcurrentCache();
+      return;
+    }
+
     if (blockForWriteCache) {
       // Start the rest of the writes
       flushWriteCache(true);
@@ -417,6 +477,9 @@ namespace Isis {
   /**
    * @return the number of bytes that the cube DNs will take up. This includes
    *   padding caused by the cube chunks not aligning with the cube dimensions.
+   *   Children that do not store every chunk at a fixed size must override
+   *   this with the number of bytes they need reserved after the data start
+   *   byte.
    */
   BigInt CubeIoHandler::getDataSize() const {
     return (BigInt)getChunkCountInSampleDimension() *
@@ -456,6 +519,82 @@ namespace Isis {
     return m_writeThreadMutex;
   }
 
+
+  /**
+   * Concurrent reads are supported when the cube data file is read-only. When
+   *   this is true, read() may be called from multiple threads at the same
+   *   time without any external locking; reads of different chunks proceed in
+   *   parallel.
+   *
+   * @return True if read() is thread-safe for this cube
+   */
+  bool CubeIoHandler::supportsConcurrentReads() const {
+    return m_concurrentReads;
+  }
+
+
+  /**
+   * Hint that the given cube area will be read soon. The chunks it needs which
+   *   are not already cached are loaded on a background thread so that the IO
+   *   overlaps with whatever the caller does until then. For memory mapped
+   *   cubes the kernel is asked to read ahead instead.
+   *
+   * This does nothing unless supportsConcurrentReads() is true and never
+   *   changes what read() returns; it only changes how long read() takes.
+   *
+   * @param startSample The starting sample of the cube data
+   * @param numSamples The number of samples of cube data
+   * @param startLine The starting line of the cube data
+   * @param numLines The number of lines of cube data
+   * @param startBand The starting (virtual) band of the cube data
+   * @param numBands The number of bands of cube data
+   */
+  void CubeIoHandler::prefetch(int startSample, int numSamples, int startLine,
+                               int numLines, int startBand, int numBands) const {
+    if (!m_concurrentReads) {
+      return;
+    }
+
+    QList<int> chunkIndices = findCubeChunkIndices(startSample, numSamples,
+        startLine, numLines, startBand, numBands).first;
+
+    if (m_mappedData) {
+      long pageSize = sysconf(_SC_PAGESIZE);
+
+      foreach (int chunkIndex, chunkIndices) {
+        // madvise needs a page aligned address
+        quintptr chunkStart = (quintptr)m_mappedData +
+            (BigInt)chunkIndex * getBytesPerChunk();
+        quintptr alignedStart = chunkStart - chunkStart % pageSize;
+        madvise((void *)alignedStart, chunkStart - alignedStart + getBytesPerChunk(),
+                MADV_WILLNEED);
+      }
+
+      return;
+    }
+
+    foreach (int chunkIndex, chunkIndices) {
+      ChunkCacheShard &shard = m_chunkCacheShards[chunkIndex % s_chunkCacheShardCount];
+      {
+        QMutexLocker locker(&shard.mutex);
+        if (shard.entries.contains(chunkIndex)) {
+          continue;
+        }
+      }
+
+      QMutexLocker locker(&m_prefetchMutex);
+      if (!m_pendingPrefetches.contains(chunkIndex)) {
+        if (!m_prefetchThreadPool) {
+          m_prefetchThreadPool = new QThreadPool;
+          m_prefetchThreadPool->setMaxThreadCount(2);
+        }
+
+        m_pendingPrefetches.insert(chunkIndex);
+        m_prefetchThreadPool->start(new ChunkPrefetcher(this, chunkIndex));
+      }
+    }
+  }
+
   /**
    * @return the number of physical bands in the cube.
    */
@@ -557,6 +696,15 @@ namespace Isis {
   }
 
 
+  /**
+   * @return True if the cube data is memory mapped and chunks are read
+   *   directly from the mapping rather than through readRaw().
+   */
+  bool CubeIoHandler::isMapped() const {
+    return (m_mappedData != NULL);
+  }
+
+
   /**
    * @return the number of lines in the cube. This does not include lines created
    *   by the chunk overflowing the line dimension.
@@ -651,6 +799,10 @@ namespace Isis {
             "offset to the cube data is [" + IString(getDataStartByte()) +
             " bytes]";
       }
+
+      if (success && m_useMappedReads && isMappable()) {
+        mapDataFile();
+      }
     }
     else {
       throw IException(IException::Programmer, msg, _FILEINFO_);
@@ -730,7 +882,35 @@ namespace Isis {
   QPair< QList<RawCubeChunk *>, QList<int> > CubeIoHandler::findCubeChunks(int startSample,
       int numSamples, int startLine, int numLines, int startBand,
       int numBands) const {
+    QPair< QList<int>, QList<int> > chunkIndices = findCubeChunkIndices(
+        startSample, numSamples, startLine, numLines, startBand, numBands);
+
     QList<RawCubeChunk *> results;
+    for (int i = 0; i < chunkIndices.first.size(); i++) {
+      results.append(getChunk(chunkIndices.first[i], true));
+    }
+
+    return QPair< QList<RawCubeChunk *>, QList<int> >(results, chunkIndices.second);
+  }
+
+
+  /**
+   * Get the indices of the cube chunks that correspond to the given cube area.
+   *   This does no IO and does not touch the chunk cache.
+   *
+   * @param startSample The starting sample of the cube data
+   * @param numSamples The number of samples of cube data
+   * @param startLine The starting line of the cube data
+   * @param numLines The number of lines of cube data
+   * @param startBand The starting band of the cube data
+   * @param numBands The number of bands of cube data
+   * @return The chunk indices that correspond to the given cube area, and the
+   *         (virtual) band each one was found for
+   */
+  QPair< QList<int>, QList<int> > CubeIoHandler::findCubeChunkIndices(int startSample,
+      int numSamples, int startLine, int numLines, int startBand,
+      int numBands) const {
+    QList<int> results;
     QList<int> resultBands;
 /************************************************************************CHANGED THIS!!!!!!!!******/
     int lastBand = startBand + numBands - 1;
@@ -839,9 +1019,7 @@ namespace Isis {
               (chunkZPos * getChunkCountInSampleDimension() *
                           getChunkCountInLineDimension());
 
-          RawCubeChunk * newChunk = getChunk(chunkIndex, true);
-
-          results.append(newChunk);
+          results.append(chunkIndex);
           resultBands.append(band);
 
           chunkRect.moveLeft(chunkRect.right() + 1);
@@ -851,7 +1029,7 @@ namespace Isis {
       }
     }
 
-    return QPair< QList<RawCubeChunk *>, QList<int> >(results, resultBands);
+    return QPair< QList<int>, QList<int> >(results, resultBands);
   }
 
 
@@ -1064,11 +1242,22 @@ namespace Isis {
         int endBand;
         getChunkPlacement(chunkIndex, startSample, startLine, startBand,
                           endSample, endLine, endBand);
-        chunk = new RawCubeChunk(startSample, startLine, startBand,
-                                    endSample, endLine, endBand,
-                                    getBytesPerChunk());
 
-        (const_cast<CubeIoHandler *>(this))->readRaw(*chunk);
+        if (m_mappedData) {
+          // The chunk is a view into the mapped file; no read or copy needed.
+          const char *chunkData = (const char *)m_mappedData +
+              (BigInt)chunkIndex * getBytesPerChunk();
+          chunk = new RawCubeChunk(startSample, startLine, startBand,
+                                   endSample, endLine, endBand,
+                                   chunkData, getBytesPerChunk());
+        }
+        else {
+          chunk = new RawCubeChunk(startSample, startLine, startBand,
+                                   endSample, endLine, endBand,
+                                   getBytesPerChunk());
+
+          (const_cast<CubeIoHandler *>(this))->readRaw(*chunk);
+        }
         chunk->setDirty(false);
       }
 
@@ -1376,7 +1565,8 @@ namespace Isis {
     int chunkBandSize = chunkLineSize * chunk.lineCount();
     //double *buffersDoubleBuf = output.p_buf;
     double *buffersDoubleBuf = output.DoubleBuffer();
-    const char *chunkBuf = chunk.getRawData().data();
+    // constData() so that views into a mapped file are never detached/copied
+    const char *chunkBuf = chunk.getRawData().constData();
     char *buffersRawBuf = (char *)output.RawBuffer();
 
     for(int z = startZ; z <= endZ; z++) {
@@ -1825,6 +2015,306 @@ namespace Isis {
   }
 
 
+  /**
+   * Memory map the cube data. Chunks are laid out back to back in chunk index
+   *   order starting at the data start byte, so a chunk's data lives at
+   *   chunkIndex * getBytesPerChunk() into the mapping. If the file cannot be
+   *   mapped (for example, on a file system that does not support it), cube
+   *   data is read through readRaw() as usual.
+   */
+  void CubeIoHandler::mapDataFile() {
+    unmapDataFile();
+
+    if (getDataSize() > 0) {
+      m_mappedData = m_dataFile->map(getDataStartByte(), getDataSize());
+    }
+  }
+
+
+  /**
+   * Release the memory mapping of the cube data, if there is one. No chunk
+   *   which is a view into the mapping may exist when this is called.
+   */
+  void CubeIoHandler::unmapDataFile() {
+    if (m_mappedData) {
+      m_dataFile->unmap(m_mappedData);
+      m_mappedData = NULL;
+    }
+  }
+
+
+  /**
+   * The thread-safe version of read() used for read-only cubes. The chunks
+   *   needed for the buffer are pinned one at a time, copied into the buffer
+   *   and unpinned.
+   *
+   * @param bufferToFill The buffer to populate with cube data.
+   */
+  void CubeIoHandler::concurrentRead(Buffer &bufferToFill) const {
+    // Areas outside of the cube (or its virtual bands) are read as NULLs
+    for (int i = 0; i < bufferToFill.size(); i++) {
+      bufferToFill[i] = Null;
+    }
+
+    QPair< QList<int>, QList<int> > chunkInfo = findCubeChunkIndices(
+        bufferToFill.Sample(), bufferToFill.SampleDimension(),
+        bufferToFill.Line(), bufferToFill.LineDimension(),
+        bufferToFill.Band(), bufferToFill.BandDimension());
+
+    for (int i = 0; i < chunkInfo.first.size(); i++) {
+      int chunkIndex = chunkInfo.first[i];
+      RawCubeChunk *chunk = pinChunk(chunkIndex);
+
+      try {
+        writeIntoDouble(*chunk, bufferToFill, chunkInfo.second[i]);
+      }
+      catch (...) {
+        unpinChunk(chunkIndex);
+        throw;
+      }
+
+      unpinChunk(chunkIndex);
+    }
+  }
+
+
+  /**
+   * Get a chunk from the concurrent read cache, reading it if necessary, and
+   *   pin it so that it cannot be evicted until unpinChunk() is called. The
+   *   shard lock is not held while the chunk is read, so two threads may read
+   *   the same chunk at once; the second one to finish uses the first one's
+   *   chunk and discards its own.
+   *
+   * @param chunkIndex The position of the chunk in the cube
+   * @return The pinned chunk; this is owned by the cache
+   */
+  RawCubeChunk *CubeIoHandler::pinChunk(int chunkIndex) const {
+    ChunkCacheShard &shard = m_chunkCacheShards[chunkIndex % s_chunkCacheShardCount];
+
+    {
+      QMutexLocker locker(&shard.mutex);
+      QHash<int, ChunkCacheEntry>::iterator it = shard.entries.find(chunkIndex);
+
+      if (it != shard.entries.end()) {
+        it->pinCount++;
+        it->lastUse = m_chunkCacheClock.fetchAndAddRelaxed(1);
+        return it->chunk;
+      }
+    }
+
+    RawCubeChunk *newChunk = readChunkConcurrently(chunkIndex);
+    RawCubeChunk *duplicateChunk = NULL;
+    RawCubeChunk *result = NULL;
+
+    {
+      QMutexLocker locker(&shard.mutex);
+      QHash<int, ChunkCacheEntry>::iterator it = shard.entries.find(chunkIndex);
+
+      if (it != shard.entries.end()) {
+        it->pinCount++;
+        it->lastUse = m_chunkCacheClock.fetchAndAddRelaxed(1);
+        result = it->chunk;
+        duplicateChunk = newChunk;
+      }
+      else {
+        ChunkCacheEntry entry;
+        entry.chunk = newChunk;
+        entry.pinCount = 1;
+        entry.lastUse = m_chunkCacheClock.fetchAndAddRelaxed(1);
+        shard.entries.insert(chunkIndex, entry);
+        result = newChunk;
+
+        m_chunkCacheBytes.fetchAndAddRelaxed(chunkCacheCost(*newChunk));
+
+        if (m_chunkCacheBytes.loadRelaxed() > m_chunkCacheByteBudget) {
+          evictUnpinnedChunks(shard);
+        }
+      }
+    }
+
+    delete duplicateChunk;
+    return result;
+  }
+
+
+  /**
+   * Release a pin acquired with pinChunk().
+   *
+   * @param chunkIndex The position of the chunk in the cube
+   */
+  void CubeIoHandler::unpinChunk(int chunkIndex) const {
+    ChunkCacheShard &shard = m_chunkCacheShards[chunkIndex % s_chunkCacheShardCount];
+
+    QMutexLocker locker(&shard.mutex);
+    QHash<int, ChunkCacheEntry>::iterator it = shard.entries.find(chunkIndex);
+
+    if (it != shard.entries.end()) {
+      it->pinCount--;
+    }
+  }
+
+
+  /**
+   * Create the chunk at the given index for the concurrent read cache. This
+   *   is a view into the memory mapping when there is one; otherwise the data
+   *   is read with readRawConcurrently().
+   *
+   * @param chunkIndex The position of the chunk in the cube
+   * @return A new chunk with unswapped raw data from the disk
+   */
+  RawCubeChunk *CubeIoHandler::readChunkConcurrently(int chunkIndex) const {
+    int startSample;
+    int startLine;
+    int startBand;
+    int endSample;
+    int endLine;
+    int endBand;
+    getChunkPlacement(chunkIndex, startSample, startLine, startBand,
+                      endSample, endLine, endBand);
+
+    if (m_mappedData) {
+      return new RawCubeChunk(startSample, startLine, startBand,
+                              endSample, endLine, endBand,
+                              (const char *)m_mappedData +
+                                  (BigInt)chunkIndex * getBytesPerChunk(),
+                              getBytesPerChunk());
+    }
+
+    RawCubeChunk *chunk = new RawCubeChunk(startSample, startLine, startBand,
+                                           endSample, endLine, endBand,
+                                           getBytesPerChunk());
+
+    try {
+      readRawConcurrently(*chunk);
+    }
+    catch (...) {
+      delete chunk;
+      throw;
+    }
+
+    chunk->setDirty(false);
+    return chunk;
+  }
+
+
+  /**
+   * This needs to populate the chunkToFill with unswapped raw bytes from the
+   *   disk, like readRaw(), but must be safe to call from many threads at once.
+   *   It is only used for cubes opened read-only. The default implementation
+   *   reads chunks stored uncompressed and back to back (see isMappable())
+   *   with pread(), which does not use the shared file position.
+   *
+   * @param chunkToFill The container that needs to be filled with cube data.
+   */
+  void CubeIoHandler::readRawConcurrently(RawCubeChunk &chunkToFill) const {
+    char *chunkData = chunkToFill.getRawData().data();
+    BigInt bytesToRead = chunkToFill.getByteCount();
+    BigInt bytesRead = 0;
+    BigInt startByte = getDataStartByte() +
+        (BigInt)getChunkIndex(chunkToFill) * getBytesPerChunk();
+
+    while (bytesRead < bytesToRead) {
+      ssize_t result = pread(m_dataFile->handle(), chunkData + bytesRead,
+                             bytesToRead - bytesRead, startByte + bytesRead);
+
+      if (result <= 0) {
+        IString msg = "Reading from the file [" + m_dataFile->fileName() + "] "
+            "failed with reading [" + QString::number(bytesToRead) +
+            "] bytes at position [" + QString::number(startByte) + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      bytesRead += result;
+    }
+  }
+
+
+  /**
+   * Whether chunk i is stored uncompressed at
+   *   getDataStartByte() + i * getBytesPerChunk(). Only then can the cube data
+   *   be memory mapped and chunks be views into the mapping. Children that
+   *   store chunks any other way must override this to return false.
+   *
+   * @return True if the cube data can be memory mapped
+   */
+  bool CubeIoHandler::isMappable() const {
+    return true;
+  }
+
+
+  /**
+   * The memory a chunk is charged in the concurrent read cache. Views into
+   *   the memory mapping hold no data, but their entries still cost memory,
+   *   so they are charged a nominal amount to keep their number bounded.
+   *
+   * @param chunk A chunk in the concurrent read cache
+   * @return The bytes charged against the cache budget
+   */
+  qint64 CubeIoHandler::chunkCacheCost(const RawCubeChunk &chunk) const {
+    if (chunk.isMapped()) {
+      return s_mappedChunkCost;
+    }
+
+    return chunk.getByteCount();
+  }
+
+
+  /**
+   * Free the least recently used unpinned chunks in the given shard until the
+   *   concurrent read cache is back within its memory budget or the shard has
+   *   nothing left to free. The shard's mutex must be held by the caller.
+   *
+   * @param shard The shard to evict chunks from
+   */
+  void CubeIoHandler::evictUnpinnedChunks(ChunkCacheShard &shard) const {
+    while (m_chunkCacheBytes.loadRelaxed() > m_chunkCacheByteBudget) {
+      QHash<int, ChunkCacheEntry>::iterator oldest = shard.entries.end();
+
+      for (QHash<int, ChunkCacheEntry>::iterator it = shard.entries.begin();
+           it != shard.entries.end(); it++) {
+        if (it->pinCount == 0 &&
+            (oldest == shard.entries.end() || it->lastUse < oldest->lastUse)) {
+          oldest = it;
+        }
+      }
+
+      if (oldest == shard.entries.end()) {
+        break;
+      }
+
+      m_chunkCacheBytes.fetchAndAddRelaxed(-chunkCacheCost(*oldest->chunk));
+
+      delete oldest->chunk;
+      shard.entries.erase(oldest);
+    }
+  }
+
+
+  /**
+   * Free every unpinned chunk in the concurrent read cache. Chunks that are
+   *   pinned by a read in progress are left alone.
+   */
+  void CubeIoHandler::clearConcurrentCache() const {
+    for (int i = 0; i < s_chunkCacheShardCount; i++) {
+      ChunkCacheShard &shard = m_chunkCacheShards[i];
+      QMutexLocker locker(&shard.mutex);
+
+      QHash<int, ChunkCacheEntry>::iterator it = shard.entries.begin();
+      while (it != shard.entries.end()) {
+        if (it->pinCount == 0) {
+          m_chunkCacheBytes.fetchAndAddRelaxed(-chunkCacheCost(*it->chunk));
+
+          delete it->chunk;
+          it = shard.entries.erase(it);
+        }
+        else {
+          it++;
+        }
+      }
+    }
+  }
+
+
   /**
    * Write all NULL cube chunks that have not yet been accessed to disk.
    */
@@ -1945,4 +2435,36 @@ namespace Isis {
     m_buffersToWrite->clear();
     m_ioHandler->m_dataFile->flush();
   }
+
+
+  /**
+   * Create a ChunkPrefetcher. This is auto-deleted by the thread pool.
+   *
+   * @param ioHandler The IO handler whose concurrent read cache gets the chunk
+   * @param chunkIndex The position of the chunk in the cube
+   */
+  CubeIoHandler::ChunkPrefetcher::ChunkPrefetcher(const CubeIoHandler *ioHandler,
+                                                  int chunkIndex) {
+    m_ioHandler = ioHandler;
+    m_chunkIndex = chunkIndex;
+  }
+
+
+  /**
+   * Load the chunk into the cache. Pinning reads the chunk if it isn't cached
+   *   yet; the pin is released right away so the chunk can be evicted normally.
+   *   Errors are ignored here - the read() that needs the chunk will read it
+   *   again and report them.
+   */
+  void CubeIoHandler::ChunkPrefetcher::run() {
+    try {
+      m_ioHandler->pinChunk(m_chunkIndex);
+      m_ioHandler->unpinChunk(m_chunkIndex);
+    }
+    catch (IException &) {
+    }
+
+    QMutexLocker locker(&m_ioHandler->m_prefetchMutex);
+    m_ioHandler->m_pendingPrefetches.remove(m_chunkIndex);
+  }
 }
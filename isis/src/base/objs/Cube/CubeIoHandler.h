@@ -8,6 +8,10 @@ find files of those names at the top level of this repository. **/
 #ifndef CubeIoHandler_h
 #define CubeIoHandler_h
 
+#include <QAtomicInteger>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
 #include <QRunnable>
 #include <QThreadPool>
 
@@ -16,7 +20,6 @@ find files of those names at the top level of this repository. **/
 #include "PixelType.h"
 
 class QFile;
-class QMutex;
 class QTime;
 template <typename A> class QList;
 template <typename A, typename B> class QMap;
@@ -43,6 +46,25 @@ namespace Isis {
    *   guarantees that unwritten cube data ends up read and written as NULLs.
    *   The default caching algorithm is a RegionalCachingAlgorithm.
    *
+   * When the data file is opened read-only and the Performance preference
+   *   CubeReadMapping is ReadOnly, the cube data is memory mapped and cached
+   *   chunks are views into the mapping instead of copies read by readRaw().
+   *   Byte swapping and base/multiplier are still applied when the chunk is
+   *   copied into a Buffer, so this is transparent to children.
+   *
+   * Cubes opened read-only can be read from many threads at once (see
+   *   supportsConcurrentReads()). Their chunks live in a cache that is sharded
+   *   by chunk index; each shard has its own lock which is only held while
+   *   looking up, inserting or evicting chunks - never during IO. Chunks are
+   *   pinned while they are being copied into a Buffer so that eviction by
+   *   another thread cannot free them. Chunks are read with pread() (or taken
+   *   from the memory mapping) so no shared file position is involved. The
+   *   caching algorithms are not used for these cubes; instead the least
+   *   recently used unpinned chunks are evicted once the cache grows past
+   *   its memory budget, the Performance preference CubeReadCache. Views into
+   *   the memory mapping are charged a small fixed cost. These cubes also support prefetch(), which loads
+   *   chunks that will be needed soon on a background thread.
+   *
    * @author 2011-??-?? Jai Rideout and Steven Lambright
    *
    * @internal
@@ -117,7 +139,7 @@ namespace Isis {
 
       void addCachingAlgorithm(CubeCachingAlgorithm *algorithm);
       void clearCache(bool blockForWriteCache = true) const;
-      BigInt getDataSize() const;
+      virtual BigInt getDataSize() const;
       void setVirtualBands(const QList<int> *virtualBandList);
       /**
        * Function to update the labels with a Pvl object
@@ -128,6 +150,11 @@ namespace Isis {
 
       QMutex *dataFileMutex();
 
+      bool supportsConcurrentReads() const;
+
+      void prefetch(int startSample, int numSamples, int startLine, int numLines,
+                    int startBand, int numBands) const;
+
     protected:
       int bandCount() const;
       int getBandCountInChunk() const;
@@ -138,6 +165,7 @@ namespace Isis {
       int getChunkIndex(const RawCubeChunk &)  const;
       BigInt getDataStartByte() const;
       QFile * getDataFile();
+      bool isMapped() const;
       int lineCount() const;
       int getLineCountInChunk() const;
       PixelType pixelType() const;
@@ -146,6 +174,9 @@ namespace Isis {
 
       void setChunkSizes(int numSamples, int numLines, int numBands);
 
+      virtual bool isMappable() const;
+      virtual void readRawConcurrently(RawCubeChunk &chunkToFill) const;
+
       /**
        * This needs to populate the chunkToFill with unswapped raw bytes from
        *   the disk.
@@ -166,6 +197,46 @@ namespace Isis {
       virtual void writeRaw(const RawCubeChunk &chunkToWrite) = 0;
 
     private:
+      /**
+       * A cached chunk in the concurrent read cache.
+       */
+      struct ChunkCacheEntry {
+        //! The cached chunk; owned by the cache
+        RawCubeChunk *chunk;
+        //! The number of readers currently using the chunk
+        int pinCount;
+        //! The value of the cache clock the last time the chunk was pinned
+        quint64 lastUse;
+      };
+
+      /**
+       * One shard of the concurrent read cache. Chunk i lives in shard
+       *   i % s_chunkCacheShardCount.
+       */
+      struct ChunkCacheShard {
+        //! Guards entries; never held while doing IO
+        QMutex mutex;
+        //! The chunks in this shard by chunk index
+        QHash<int, ChunkCacheEntry> entries;
+      };
+
+      /**
+       * This class loads a chunk into the concurrent read cache in the
+       *   background so that a later read() finds it already there.
+       */
+      class ChunkPrefetcher : public QRunnable {
+        public:
+          ChunkPrefetcher(const CubeIoHandler *ioHandler, int chunkIndex);
+
+          void run();
+
+        private:
+          //! The IO Handler instance whose cache the chunk goes into
+          const CubeIoHandler *m_ioHandler;
+          //! The chunk to load
+          int m_chunkIndex;
+      };
+
       /**
        * This class is designed to handle write() asynchronously.
        *
@@ -266,6 +337,20 @@ namespace Isis {
 
       void writeNullDataToDisk() const;
 
+      void mapDataFile();
+      void unmapDataFile();
+
+      void concurrentRead(Buffer &bufferToFill) const;
+      QPair< QList<int>, QList<int> > findCubeChunkIndices(int startSample, int numSamples,
+                                                           int startLine, int numLines,
+                                                           int startBand, int numBands) const;
+      RawCubeChunk *pinChunk(int chunkIndex) const;
+      void unpinChunk(int chunkIndex) const;
+      RawCubeChunk *readChunkConcurrently(int chunkIndex) const;
+      qint64 chunkCacheCost(const RawCubeChunk &chunk) const;
+      void evictUnpinnedChunks(ChunkCacheShard &shard) const;
+      void clearConcurrentCache() const;
+
     private:
       //! The file containing cube data.
       QFile * m_dataFile;
@@ -307,6 +392,51 @@ namespace Isis {
       //! The map from chunk index to chunk for cached data.
       mutable QMap<int, RawCubeChunk *> * m_rawData;
 
+      /**
+       * True if the cube data should be memory mapped once the chunk sizes are
+       *   known. This is only set for cubes that are opened read-only.
+       */
+      bool m_useMappedReads;
+
+      //! The memory mapped cube data (starting at m_startByte), or NULL.
+      uchar *m_mappedData;
+
+      /**
+       * True if this handler reads through the concurrent chunk cache. This is
+       *   only set for cubes that are opened read-only.
+       */
+      bool m_concurrentReads;
+
+      //! The number of shards in the concurrent read cache
+      static const int s_chunkCacheShardCount = 16;
+
+      //! The concurrent read cache shards; NULL unless m_concurrentReads.
+      ChunkCacheShard *m_chunkCacheShards;
+
+      //! The number of bytes allocated by chunks in the concurrent read cache
+      mutable QAtomicInteger<qint64> m_chunkCacheBytes;
+
+      //! The most bytes the concurrent read cache keeps before evicting
+      qint64 m_chunkCacheByteBudget;
+
+      //! The budget of the concurrent read cache without a CubeReadCache preference
+      static const int s_defaultChunkCacheMegabytes = 16;
+
+      //! The bytes each view into the memory mapping is charged in the cache
+      static const qint64 s_mappedChunkCost = 256;
+
+      //! Incremented every time a chunk is pinned; used for LRU eviction
+      mutable QAtomicInteger<quint64> m_chunkCacheClock;
+
+      //! The threads that run ChunkPrefetchers; created on first prefetch()
+      mutable QThreadPool *m_prefetchThreadPool;
+
+      //! Guards m_pendingPrefetches and the creation of m_prefetchThreadPool
+      mutable QMutex m_prefetchMutex;
+
+      //! The chunk indices which have been queued but not yet loaded
+      mutable QSet<int> m_pendingPrefetches;
+
       //! The map from chunk index to on-disk status, all true if not allocated.
       mutable QMap<int, bool> * m_dataIsOnDiskMap;
 
@@ -132,7 +132,7 @@ namespace Isis {
    *     (that is, number of samples or number of lines).
    * @return The tile size that should be used for the dimension
    */
-  int CubeTileHandler::findGoodSize(int maxSize, int dimensionSize) const {
+  int CubeTileHandler::findGoodSize(int maxSize, int dimensionSize) {
     int ideal = 128;
 
     if(dimensionSize <= maxSize) {
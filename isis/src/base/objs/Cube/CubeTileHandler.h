@@ -40,6 +40,8 @@ namespace Isis {
 
       void updateLabels(Pvl &label);
 
+      static int findGoodSize(int maxSize, int dimensionSize);
+
     protected:
       virtual void readRaw(RawCubeChunk &chunkToFill);
       virtual void writeRaw(const RawCubeChunk &chunkToWrite);
@@ -61,7 +63,6 @@ namespace Isis {
        */
       CubeTileHandler &operator=(const CubeTileHandler &other);
 
-      int findGoodSize(int maxSize, int dimensionSize) const;
       BigInt getTileStartByte(const RawCubeChunk &chunk) const;
   };
 }
@@ -27,6 +27,7 @@ namespace Isis {
    */
   RawCubeChunk::RawCubeChunk(const Area3D &placement, int numBytes) {
     m_dirty = false;
+    m_mapped = false;
 
     m_rawBuffer = new QByteArray(numBytes, '\0');
     m_rawBufferInternalPtr = m_rawBuffer->data();
@@ -57,6 +58,7 @@ namespace Isis {
                              int endSample, int endLine, int endBand,
                              int numBytes) {
     m_dirty = false;
+    m_mapped = false;
 
     m_rawBuffer = new QByteArray(numBytes, '\0');
     m_rawBufferInternalPtr = m_rawBuffer->data();
@@ -71,6 +73,43 @@ namespace Isis {
   }
 
 
+  /**
+   * This constructor creates a cube chunk whose raw data is a view into
+   *   memory that is owned elsewhere, typically a memory mapped cube file. No
+   *   copy of the data is made, so the memory must outlive the chunk.
+   *
+   * Chunks created this way are read-only; the setData() methods must not be
+   *   called on them. Calling setRawData() replaces the view with an owned
+   *   copy of the given data.
+   *
+   * @param startSample the starting sample of the chunk (inclusive)
+   * @param startLine the starting line of the chunk (inclusive)
+   * @param startBand the starting band of the chunk (inclusive)
+   * @param endSample the ending sample of the chunk (inclusive)
+   * @param endLine the ending line of the chunk (inclusive)
+   * @param endBand the ending band of the chunk (inclusive)
+   * @param mappedData the first raw data byte of the chunk
+   * @param numBytes the number of raw data bytes in the chunk
+   */
+  RawCubeChunk::RawCubeChunk(int startSample, int startLine, int startBand,
+                             int endSample, int endLine, int endBand,
+                             const char *mappedData, int numBytes) {
+    m_dirty = false;
+    m_mapped = true;
+
+    m_rawBuffer = new QByteArray(QByteArray::fromRawData(mappedData, numBytes));
+    m_rawBufferInternalPtr = NULL;
+
+    m_sampleCount = endSample - startSample + 1;
+    m_lineCount = endLine - startLine + 1;
+    m_bandCount = endBand - startBand + 1;
+
+    m_startSample = startSample;
+    m_startLine = startLine;
+    m_startBand = startBand;
+  }
+
+
   /**
    * The destructor.
    */
@@ -91,6 +130,15 @@ namespace Isis {
   }
 
 
+  /**
+   * @returns true if the raw data is a read-only view into memory owned
+   *   elsewhere (see the memory mapped constructor).
+   */
+  bool RawCubeChunk::isMapped() const {
+    return m_mapped;
+  }
+
+
   /**
    * Sets the chunk's raw data. This size of the new raw data must match that
    *   of the chunk's current raw data buffer.
@@ -105,6 +153,7 @@ namespace Isis {
     }
 
     m_dirty = true;
+    m_mapped = false;
     *m_rawBuffer = rawData;
     m_rawBufferInternalPtr = m_rawBuffer->data();
   }
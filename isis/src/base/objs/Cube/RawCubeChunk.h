@@ -29,8 +29,12 @@ namespace Isis {
       RawCubeChunk(const Area3D &placement, int numBytes);
       RawCubeChunk(int startSample, int startLine, int startBand,
                    int endSample, int endLine, int endBand, int numBytes);
+      RawCubeChunk(int startSample, int startLine, int startBand,
+                   int endSample, int endLine, int endBand,
+                   const char *mappedData, int numBytes);
       virtual ~RawCubeChunk();
       bool isDirty() const;
+      bool isMapped() const;
 
       /**
        * @returns a reference to the raw data in this cube chunk.
@@ -121,6 +125,9 @@ namespace Isis {
       //! This is the internal pointer to the raw buffer for performance.
       char *m_rawBufferInternalPtr;
 
+      //! True if the raw buffer is a read-only view into a memory mapped file.
+      bool m_mapped;
+
       //! The number of samples in the cube chunk.
       int m_sampleCount;
       //! The number of lines in the cube chunk.
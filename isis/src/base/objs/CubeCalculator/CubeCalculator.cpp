@@ -26,6 +26,8 @@ namespace Isis {
     m_cubeStats       = NULL;
     m_cubeCameras     = NULL;
     m_cameraBuffers   = NULL;
+    m_program         = NULL;
+    m_sampleNumbers   = NULL;
 
     m_calculations    = new QVector<Calculations>();
     m_methods         = new QVector<void (Calculator:: *)(void)>();
@@ -33,6 +35,8 @@ namespace Isis {
     m_cubeStats       = new QVector<Statistics *>();
     m_cubeCameras     = new QVector<Camera *>();
     m_cameraBuffers   = new QVector<CameraBuffers *>();
+    m_program         = new CalculatorProgram();
+    m_sampleNumbers   = new QVector<double>();
 
     m_outputSamples = 0;
   }
@@ -48,6 +52,8 @@ namespace Isis {
     delete m_cubeStats;
     delete m_cubeCameras;
     delete m_cameraBuffers;
+    delete m_program;
+    delete m_sampleNumbers;
     
     m_calculations = NULL;
     m_methods = NULL;
@@ -55,6 +61,8 @@ namespace Isis {
     m_cubeStats = NULL;
     m_cubeCameras = NULL;
     m_cameraBuffers = NULL;
+    m_program = NULL;
+    m_sampleNumbers = NULL;
   }
   
   
@@ -97,6 +105,14 @@ namespace Isis {
       }
       m_cameraBuffers->clear();
     }
+
+    if (m_program) {
+      m_program->clear();
+    }
+
+    if (m_sampleNumbers) {
+      m_sampleNumbers->clear();
+    }
   }
 
   
@@ -117,6 +133,91 @@ namespace Isis {
     // For now we'll only process a single line in this method for our results. In order
     //    to do more powerful indexing, passing a list of cubes and the output cube will
     //    be necessary.
+    if (m_program->isValid()) {
+      for (int dataIndex = 0; dataIndex < m_dataDefinitions->size(); dataIndex++) {
+        DataValue &data = (*m_dataDefinitions)[dataIndex];
+        QVector<double> *cameraData = NULL;
+
+        switch (data.type()) {
+          case DataValue::Constant:
+            break;
+          case DataValue::Band:
+            m_program->setInput(dataIndex, curBand);
+            break;
+          case DataValue::Line:
+            m_program->setInput(dataIndex, curLine);
+            break;
+          case DataValue::Sample:
+            m_program->setInput(dataIndex, m_sampleNumbers->constData(), m_sampleNumbers->size());
+            break;
+          case DataValue::CubeData: {
+            Buffer *buffer = cubeData[data.cubeIndex()];
+            m_program->setInput(dataIndex, buffer->DoubleBuffer(), buffer->size(), true);
+            break;
+          }
+          case DataValue::InaData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->inaBuffer(curLine, m_outputSamples,
+                                                                        curBand);
+            break;
+          case DataValue::EmaData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->emaBuffer(curLine, m_outputSamples,
+                                                                        curBand);
+            break;
+          case DataValue::PhaData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->phaBuffer(curLine, m_outputSamples,
+                                                                        curBand);
+            break;
+          case DataValue::InalData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->inalBuffer(curLine, m_outputSamples,
+                                                                         curBand);
+            break;
+          case DataValue::EmalData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->emalBuffer(curLine, m_outputSamples,
+                                                                         curBand);
+            break;
+          case DataValue::PhalData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->phalBuffer(curLine, m_outputSamples,
+                                                                         curBand);
+            break;
+          case DataValue::LatData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->latBuffer(curLine, m_outputSamples,
+                                                                        curBand);
+            break;
+          case DataValue::LonData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->lonBuffer(curLine, m_outputSamples,
+                                                                        curBand);
+            break;
+          case DataValue::ResData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->resBuffer(curLine, m_outputSamples,
+                                                                        curBand);
+            break;
+          case DataValue::RadiusData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->radiusBuffer(curLine,
+                                                                           m_outputSamples,
+                                                                           curBand);
+            break;
+          case DataValue::InacData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->inacBuffer(curLine, m_outputSamples,
+                                                                         curBand);
+            break;
+          case DataValue::EmacData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->emacBuffer(curLine, m_outputSamples,
+                                                                         curBand);
+            break;
+          case DataValue::PhacData:
+            cameraData = (*m_cameraBuffers)[data.cubeIndex()]->phacBuffer(curLine, m_outputSamples,
+                                                                         curBand);
+            break;
+        }
+
+        if (cameraData) {
+          m_program->setInput(dataIndex, cameraData->constData(), cameraData->size());
+        }
+      }
+
+      return m_program->evaluate();
+    }
+
     int methodIndex = 0;
     int dataIndex = 0;
 
@@ -681,6 +782,8 @@ namespace Isis {
         throw IException(IException::Unknown, msg, _FILEINFO_);
       }
     } // while loop
+
+    compileProgram();
   }
 
 
@@ -831,6 +934,90 @@ namespace Isis {
   }
 
 
+  /**
+   * Compiles the prepared calculations into m_program. Each data definition
+   *   becomes an input of the program with the same index, except constants,
+   *   which are folded into the program. The sample numbers are also set up
+   *   here because they do not change from line to line.
+   */
+  void CubeCalculator::compileProgram() {
+    m_program->clear();
+
+    m_sampleNumbers->resize(m_outputSamples);
+    for (int i = 0; i < m_outputSamples; i++) {
+      (*m_sampleNumbers)[i] = i + 1;
+    }
+
+    int methodIndex = 0;
+    int dataIndex = 0;
+
+    for (int currentCalculation = 0; currentCalculation < m_calculations->size();
+        currentCalculation++) {
+      if ((*m_calculations)[currentCalculation] == CallNextMethod) {
+        void (Calculator::*method)() = (*m_methods)[methodIndex];
+        CalculatorProgram::Operator op;
+
+        if (method == &Calculator::Add) op = CalculatorProgram::Add;
+        else if (method == &Calculator::Subtract) op = CalculatorProgram::Subtract;
+        else if (method == &Calculator::Multiply) op = CalculatorProgram::Multiply;
+        else if (method == &Calculator::Divide) op = CalculatorProgram::Divide;
+        else if (method == &Calculator::Modulus) op = CalculatorProgram::Modulus;
+        else if (method == &Calculator::Exponent) op = CalculatorProgram::Exponent;
+        else if (method == &Calculator::Negative) op = CalculatorProgram::Negative;
+        else if (method == &Calculator::LeftShift) op = CalculatorProgram::LeftShift;
+        else if (method == &Calculator::RightShift) op = CalculatorProgram::RightShift;
+        else if (method == &Calculator::MaximumLine) op = CalculatorProgram::MaximumLine;
+        else if (method == &Calculator::MaximumPixel) op = CalculatorProgram::MaximumPixel;
+        else if (method == &Calculator::MinimumLine) op = CalculatorProgram::MinimumLine;
+        else if (method == &Calculator::MinimumPixel) op = CalculatorProgram::MinimumPixel;
+        else if (method == &Calculator::AbsoluteValue) op = CalculatorProgram::AbsoluteValue;
+        else if (method == &Calculator::SquareRoot) op = CalculatorProgram::SquareRoot;
+        else if (method == &Calculator::Log) op = CalculatorProgram::Log;
+        else if (method == &Calculator::Log10) op = CalculatorProgram::Log10;
+        else if (method == &Calculator::Sine) op = CalculatorProgram::Sine;
+        else if (method == &Calculator::Cosine) op = CalculatorProgram::Cosine;
+        else if (method == &Calculator::Tangent) op = CalculatorProgram::Tangent;
+        else if (method == &Calculator::Secant) op = CalculatorProgram::Secant;
+        else if (method == &Calculator::Cosecant) op = CalculatorProgram::Cosecant;
+        else if (method == &Calculator::Cotangent) op = CalculatorProgram::Cotangent;
+        else if (method == &Calculator::Arcsine) op = CalculatorProgram::Arcsine;
+        else if (method == &Calculator::Arccosine) op = CalculatorProgram::Arccosine;
+        else if (method == &Calculator::Arctangent) op = CalculatorProgram::Arctangent;
+        else if (method == &Calculator::Arctangent2) op = CalculatorProgram::Arctangent2;
+        else if (method == &Calculator::SineH) op = CalculatorProgram::SineH;
+        else if (method == &Calculator::CosineH) op = CalculatorProgram::CosineH;
+        else if (method == &Calculator::TangentH) op = CalculatorProgram::TangentH;
+        else if (method == &Calculator::LessThan) op = CalculatorProgram::LessThan;
+        else if (method == &Calculator::GreaterThan) op = CalculatorProgram::GreaterThan;
+        else if (method == &Calculator::LessThanOrEqual) op = CalculatorProgram::LessThanOrEqual;
+        else if (method == &Calculator::GreaterThanOrEqual) {
+          op = CalculatorProgram::GreaterThanOrEqual;
+        }
+        else if (method == &Calculator::Equal) op = CalculatorProgram::Equal;
+        else if (method == &Calculator::NotEqual) op = CalculatorProgram::NotEqual;
+        else {
+          // Leave the stack based calculations to handle this equation
+          m_program->clear();
+          return;
+        }
+
+        m_program->pushOperator(op);
+        methodIndex++;
+      }
+      else {
+        DataValue &data = (*m_dataDefinitions)[dataIndex];
+        if (data.type() == DataValue::Constant) {
+          m_program->pushConstant(data.constant());
+        }
+        else {
+          m_program->pushInput(dataIndex);
+        }
+        dataIndex++;
+      }
+    }
+  }
+
+
   /**
    * Constructs a default DataValue. 
    *
@@ -947,6 +1134,8 @@ namespace Isis {
     m_radiusBuffer = NULL;
 
     m_lastLine = -1;
+    m_lastBand = -1;
+    m_centerBand = -1;
   }
 
 
@@ -1141,93 +1330,91 @@ namespace Isis {
 
 
   void CameraBuffers::loadBuffers(int currentLine, int ns, int currentBand) {
-    if (currentLine != m_lastLine) {
-      m_lastLine = currentLine;
-
-      // Resize buffers if necessary
-      if (m_phaBuffer) m_phaBuffer->resize(ns);
-      if (m_inaBuffer) m_inaBuffer->resize(ns);
-      if (m_emaBuffer) m_emaBuffer->resize(ns);
-      if (m_latBuffer) m_latBuffer->resize(ns);
-      if (m_lonBuffer) m_lonBuffer->resize(ns);
-      if (m_resBuffer) m_resBuffer->resize(ns);
-      if (m_radiusBuffer) m_radiusBuffer->resize(ns);
-      if (m_phalBuffer) m_phalBuffer->resize(ns);
-      if (m_inalBuffer) m_inalBuffer->resize(ns);
-      if (m_emalBuffer) m_emalBuffer->resize(ns);
-
-      // Center angle buffers will only ever have one item, the center angle value
-      if (m_phacBuffer) m_phacBuffer->resize(1);
-      if (m_inacBuffer) m_inacBuffer->resize(1);
-      if (m_emacBuffer) m_emacBuffer->resize(1);
-
-      m_camera->SetBand(currentBand);
-
-      if (m_phacBuffer || m_inacBuffer || m_emacBuffer) {
-          QString tokenName; // used for exception
-          double centerLine = m_camera->Lines() / 2.0 + 0.5;
-          double centerSamp = m_camera->Samples() / 2.0 + 0.5;
-
-          if (m_camera->SetImage(centerSamp, centerLine)) {
-            if (m_phacBuffer) {
-              tokenName = "phac";
-              (*m_phacBuffer)[0] = m_camera->PhaseAngle();
-            }
-            if (m_inacBuffer) {
-              tokenName = "inac";
-              (*m_inacBuffer)[0] = m_camera->IncidenceAngle();
-            }
-            if (m_emacBuffer) {
-              tokenName = "emac";
-              (*m_emacBuffer)[0] = m_camera->EmissionAngle();
-            }
-          }
-          else {
-            QString msg = "Unable to compute illumination angles at image center for operator ["
-                          + tokenName + "].";
-            throw IException(IException::Unknown, msg, _FILEINFO_);
-          }
+    // Every data definition of this camera shares the buffers, so each backplane is computed
+    // once per line however many times the equation uses it
+    if (currentLine == m_lastLine && currentBand == m_lastBand) {
+      return;
+    }
+    m_lastLine = currentLine;
+    m_lastBand = currentBand;
+
+    // Resize buffers if necessary
+    if (m_phaBuffer) m_phaBuffer->resize(ns);
+    if (m_inaBuffer) m_inaBuffer->resize(ns);
+    if (m_emaBuffer) m_emaBuffer->resize(ns);
+    if (m_latBuffer) m_latBuffer->resize(ns);
+    if (m_lonBuffer) m_lonBuffer->resize(ns);
+    if (m_resBuffer) m_resBuffer->resize(ns);
+    if (m_radiusBuffer) m_radiusBuffer->resize(ns);
+    if (m_phalBuffer) m_phalBuffer->resize(ns);
+    if (m_inalBuffer) m_inalBuffer->resize(ns);
+    if (m_emalBuffer) m_emalBuffer->resize(ns);
+
+    // Center angle buffers will only ever have one item, the center angle value
+    if (m_phacBuffer) m_phacBuffer->resize(1);
+    if (m_inacBuffer) m_inacBuffer->resize(1);
+    if (m_emacBuffer) m_emacBuffer->resize(1);
+
+    m_camera->SetBand(currentBand);
+
+    // The center angles only depend on the band, so they are not recomputed for every line
+    if ((m_phacBuffer || m_inacBuffer || m_emacBuffer) && currentBand != m_centerBand) {
+      QString tokenName = m_phacBuffer ? "phac" : m_inacBuffer ? "inac" : "emac";
+      double centerLine = m_camera->Lines() / 2.0 + 0.5;
+      double centerSamp = m_camera->Samples() / 2.0 + 0.5;
+
+      if (m_camera->SetImage(centerSamp, centerLine)) {
+        if (m_phacBuffer) (*m_phacBuffer)[0] = m_camera->PhaseAngle();
+        if (m_inacBuffer) (*m_inacBuffer)[0] = m_camera->IncidenceAngle();
+        if (m_emacBuffer) (*m_emacBuffer)[0] = m_camera->EmissionAngle();
       }
-
       else {
-        for (int i = 0; i < ns; i++) {
-        
-          if (m_camera->SetImage(i + 1, currentLine)) {
-            if (m_phaBuffer) (*m_phaBuffer)[i] = m_camera->PhaseAngle();
-            if (m_inaBuffer) (*m_inaBuffer)[i] = m_camera->IncidenceAngle();
-            if (m_emaBuffer) (*m_emaBuffer)[i] = m_camera->EmissionAngle();
-            if (m_latBuffer) (*m_latBuffer)[i] = m_camera->UniversalLatitude();
-            if (m_lonBuffer) (*m_lonBuffer)[i] = m_camera->UniversalLongitude();
-            if (m_resBuffer) (*m_resBuffer)[i] = m_camera->PixelResolution();
-            if (m_radiusBuffer) (*m_radiusBuffer)[i] = m_camera->LocalRadius().meters();
-            if (m_phalBuffer || m_inalBuffer || m_emalBuffer) {
-              Angle phal, inal, emal;
-              bool okay;
-              m_camera->LocalPhotometricAngles(phal, inal, emal, okay);
-              if (okay) {
-                if (m_phalBuffer) (*m_phalBuffer)[i] = phal.degrees();
-                if (m_inalBuffer) (*m_inalBuffer)[i] = inal.degrees();
-                if (m_emalBuffer) (*m_emalBuffer)[i] = emal.degrees();
-              }
-              else {
-                if (m_phalBuffer) (*m_phalBuffer)[i] = NAN;
-                if (m_inalBuffer) (*m_inalBuffer)[i] = NAN;
-                if (m_emalBuffer) (*m_emalBuffer)[i] = NAN;
-              }
+        QString msg = "Unable to compute illumination angles at image center for operator ["
+                      + tokenName + "].";
+        throw IException(IException::Unknown, msg, _FILEINFO_);
+      }
+      m_centerBand = currentBand;
+    }
+
+    if (m_phaBuffer || m_inaBuffer || m_emaBuffer || m_latBuffer || m_lonBuffer ||
+        m_resBuffer || m_radiusBuffer || m_phalBuffer || m_inalBuffer || m_emalBuffer) {
+      for (int i = 0; i < ns; i++) {
+
+        if (m_camera->SetImage(i + 1, currentLine)) {
+          if (m_phaBuffer) (*m_phaBuffer)[i] = m_camera->PhaseAngle();
+          if (m_inaBuffer) (*m_inaBuffer)[i] = m_camera->IncidenceAngle();
+          if (m_emaBuffer) (*m_emaBuffer)[i] = m_camera->EmissionAngle();
+          if (m_latBuffer) (*m_latBuffer)[i] = m_camera->UniversalLatitude();
+          if (m_lonBuffer) (*m_lonBuffer)[i] = m_camera->UniversalLongitude();
+          if (m_resBuffer) (*m_resBuffer)[i] = m_camera->PixelResolution();
+          if (m_radiusBuffer) (*m_radiusBuffer)[i] = m_camera->LocalRadius().meters();
+          if (m_phalBuffer || m_inalBuffer || m_emalBuffer) {
+            Angle phal, inal, emal;
+            bool okay;
+            m_camera->LocalPhotometricAngles(phal, inal, emal, okay);
+            if (okay) {
+              if (m_phalBuffer) (*m_phalBuffer)[i] = phal.degrees();
+              if (m_inalBuffer) (*m_inalBuffer)[i] = inal.degrees();
+              if (m_emalBuffer) (*m_emalBuffer)[i] = emal.degrees();
+            }
+            else {
+              if (m_phalBuffer) (*m_phalBuffer)[i] = NAN;
+              if (m_inalBuffer) (*m_inalBuffer)[i] = NAN;
+              if (m_emalBuffer) (*m_emalBuffer)[i] = NAN;
             }
           }
-          else {
-            if (m_phaBuffer) (*m_phaBuffer)[i] = NAN;
-            if (m_inaBuffer) (*m_inaBuffer)[i] = NAN;
-            if (m_emaBuffer) (*m_emaBuffer)[i] = NAN;
-            if (m_latBuffer) (*m_latBuffer)[i] = NAN;
-            if (m_lonBuffer) (*m_lonBuffer)[i] = NAN;
-            if (m_resBuffer) (*m_resBuffer)[i] = NAN;
-            if (m_radiusBuffer) (*m_radiusBuffer)[i] = NAN;
-            if (m_phalBuffer) (*m_phalBuffer)[i] = NAN;
-            if (m_inalBuffer) (*m_inalBuffer)[i] = NAN;
-            if (m_emalBuffer) (*m_emalBuffer)[i] = NAN;
-          }
+        }
+        else {
+          if (m_phaBuffer) (*m_phaBuffer)[i] = NAN;
+          if (m_inaBuffer) (*m_inaBuffer)[i] = NAN;
+          if (m_emaBuffer) (*m_emaBuffer)[i] = NAN;
+          if (m_latBuffer) (*m_latBuffer)[i] = NAN;
+          if (m_lonBuffer) (*m_lonBuffer)[i] = NAN;
+          if (m_resBuffer) (*m_resBuffer)[i] = NAN;
+          if (m_radiusBuffer) (*m_radiusBuffer)[i] = NAN;
+          if (m_phalBuffer) (*m_phalBuffer)[i] = NAN;
+          if (m_inalBuffer) (*m_inalBuffer)[i] = NAN;
+          if (m_emalBuffer) (*m_emalBuffer)[i] = NAN;
         }
       }
     }
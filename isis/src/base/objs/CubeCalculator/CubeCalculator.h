@@ -10,6 +10,7 @@ find files of those names at the top level of this repository. **/
 #define CUBE_CALCULATOR_H_
 
 #include "Calculator.h"
+#include "CalculatorProgram.h"
 #include "Cube.h"
 
 class QString;
@@ -26,6 +27,12 @@ namespace Isis {
    *   is used in conjunction with methods to retrieve data from a cube
    *   and perform calculations.
    *
+   * Once the calculations are prepared they are also compiled into a
+   *   CalculatorProgram, which evaluates each line in blocks without the
+   *   per operator allocations of the stack. The stack based calculations
+   *   are only run for equations that are not complete, so that their
+   *   errors are reported as before.
+   *
    * @ingroup Math
    *
    * @author 2008-03-26 Steven Lambright
@@ -87,6 +94,8 @@ namespace Isis {
 
       void addMethodCall(void (Calculator::*method)(void));
 
+      void compileProgram();
+
       int lastPushToCubeStats(QVector<Cube *> &inCubes);
 
       int lastPushToCubeCameras(QVector<Cube *> &inCubes);
@@ -120,6 +129,12 @@ namespace Isis {
       QVector<CameraBuffers *> *m_cameraBuffers;
 
       int m_outputSamples; //!< Number of samples in the output cube.
+
+      //! The compiled calculations, with one input for each data definition.
+      CalculatorProgram *m_program;
+
+      //! Sample numbers of the output line, the data for the sample operator.
+      QVector<double> *m_sampleNumbers;
   };
 
 
@@ -224,6 +239,8 @@ namespace Isis {
 
       Camera *m_camera; //!< Camera to obtain camera-related information from.
       int m_lastLine; //!< The number of the last line loaded into the enabled camera buffers.
+      int m_lastBand; //!< The band of the last line loaded into the enabled camera buffers.
+      int m_centerBand; //!< The band the center angle buffers were computed for.
 
       QVector<double> *m_phaBuffer;    //!< Phase angle buffer.
       QVector<double> *m_inaBuffer;    //!< Incidence angle buffer.
@@ -7,6 +7,7 @@ find files of those names at the top level of this repository. **/
 #include "DemShape.h"
 
 // Qt third party includes
+#include <QCache>
 #include <QDebug>
 #include <QVector>
 
@@ -23,6 +24,7 @@ find files of those names at the top level of this repository. **/
 #include <SpiceZfc.h>
 #include <SpiceZmc.h>
 
+#include "Brick.h"
 #include "Cube.h"
 #include "CubeManager.h"
 #include "Distance.h"
@@ -30,12 +32,13 @@ find files of those names at the top level of this repository. **/
 //#include "Geometry3D.h"
 #include "IException.h"
 #include "Interpolator.h"
+#include "IString.h"
 #include "Latitude.h"
 //#include "LinearAlgebra.h"
 #include "Longitude.h"
-#include "NaifStatus.h"
-#include "Portal.h"
+#include "Preference.h"
 #include "Projection.h"
+#include "ProjectionFactory.h"
 #include "Pvl.h"
 #include "Spice.h"
 #include "SurfacePoint.h"
@@ -56,7 +59,10 @@ namespace Isis {
     m_demProj = NULL;
     m_demCube = NULL;
     m_interp = NULL;
-    m_portal = NULL;
+    m_demTiles = NULL;
+    m_demTileColumns = 0;
+    m_lastDemTileIndex = -1;
+    m_lastDemTile = NULL;
     m_demValueFound = false;
     m_demValue = -std::numeric_limits<double>::max();
   }
@@ -75,7 +81,10 @@ namespace Isis {
     m_demProj = NULL;
     m_demCube = NULL;
     m_interp = NULL;
-    m_portal = NULL;
+    m_demTiles = NULL;
+    m_demTileColumns = 0;
+    m_lastDemTileIndex = -1;
+    m_lastDemTile = NULL;
     m_demValueFound = false;
     m_demValue = -std::numeric_limits<double>::max();
 
@@ -98,11 +107,23 @@ namespace Isis {
     //   from iteration 1 of setlookdirection (first algorithm) at iteration
     //   4 and the next setimage has to re-read the data.
     m_demCube->addCachingAlgorithm(new UniqueIOCachingAlgorithm(5));
-    m_demProj = m_demCube->projection();
+    // The DEM cube is shared with the other shapes that use it, but its
+    //   projection holds the last ground point, so each shape has its own.
+    m_demProj = ProjectionFactory::CreateFromCube(*m_demCube->label());
     m_interp = new Interpolator(Interpolator::BiLinearType);
-    m_portal = new Portal(m_interp->Samples(), m_interp->Lines(),
-                          m_demCube->pixelType(),
-                          m_interp->HotSample(), m_interp->HotLine());
+
+    // The DemTileCache Performance preference is the memory, in megabytes,
+    //   each DemShape may use for DEM tiles. At least one tile is kept.
+    int cacheMegabytes = s_defaultDemTileCache;
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("DemTileCache")) {
+      cacheMegabytes = toInt(performancePrefs["DemTileCache"][0]);
+    }
+    int tileBytes = s_demTileSize * s_demTileSize * (int)sizeof(double);
+    int maxTiles = qMax(1, (int)(cacheMegabytes * 1048576LL / tileBytes));
+
+    m_demTiles = new QCache<int, QVector<double> >(maxTiles);
+    m_demTileColumns = (m_demCube->sampleCount() + s_demTileSize - 1) / s_demTileSize;
 
     // Read in the Scale of the DEM file in pixels/degree
     const PvlGroup &mapgrp = m_demCube->label()->findGroup("Mapping", Pvl::Traverse);
@@ -114,6 +135,7 @@ namespace Isis {
 
   //! Destroys the DemShape
   DemShape::~DemShape() {
+    delete m_demProj;
     m_demProj = NULL;
 
     // We do not have ownership of p_demCube
@@ -122,8 +144,9 @@ namespace Isis {
     delete m_interp;
     m_interp = NULL;
 
-    delete m_portal;
-    m_portal = NULL;
+    delete m_demTiles;
+    m_demTiles = NULL;
+    m_lastDemTile = NULL;
   }
 
   /**
@@ -165,12 +188,11 @@ namespace Isis {
       lonDD += 360;
     }
     
-    // Previous Sensor version used local version of this method with lat and lon doubles.
-    // Steven made the change to improve speed.  He said the difference was negligible.
-    Distance surfaceRadiusKm = localRadius(Latitude(latDD, Angle::Degrees),
-                                           Longitude(lonDD, Angle::Degrees));
-    
-    if (Isis::IsSpecial(surfaceRadiusKm.kilometers())) {
+    // Interpolate the DEM directly, without building a Latitude, Longitude and
+    // Distance for every step along the ray.
+    double surfaceRadiusM = demRadius(latDD, lonDD);
+
+    if (Isis::IsSpecial(surfaceRadiusM)) {
       setHasIntersection(false);
       success = false;
       return -1; // return something
@@ -181,7 +203,7 @@ namespace Isis {
     setHasIntersection(true);
     
     success = true;
-    return pointRadiusKm - surfaceRadiusKm.kilometers();
+    return pointRadiusKm - surfaceRadiusM / 1000.0;
   } 
   
   /**
@@ -210,15 +232,14 @@ namespace Isis {
     SpiceDouble newIntersectPt[3];
 
     // An estimate for the radius of points in the DEM. Ensure the radius is
-    // strictly below the position, so that surfpt_c does not fail.
+    // strictly below the position, so that the observer is outside of it.
     double r = findDemValue();
     r = std::min(r, positionNormKm - 0.0001);
     
     // Try to intersect the target body ellipsoid at given radius as a first
     // approximation.
-    bool status;
-    surfpt_c((SpiceDouble *) &observerPos[0], &lookDirection[0], r, r, r, newIntersectPt,
-               (SpiceBoolean*) &status);
+    bool status = ellipsoidIntercept(&observerPos[0], &lookDirection[0], r, r, r,
+                                     newIntersectPt);
   
     if (!status) { 
         // If no luck, start at the observer, and will try points along the ray.
@@ -321,8 +342,6 @@ namespace Isis {
       t1 = t2; f1 = f2;
     }
 
-    NaifStatus::CheckErrors();
-    
     return converged;
   }
 
@@ -350,10 +369,9 @@ namespace Isis {
     for (int s = sampleSpacing; s <= numSamples - sampleSpacing; s += sampleSpacing) {
       for (int l = lineSpacing; l <= numLines - lineSpacing; l += lineSpacing) {
 
-        m_portal->SetPosition(s, l, 1);
-        m_demCube->read(*m_portal);
-        if (!Isis::IsSpecial(m_portal->DoubleBuffer()[0])) {
-          m_demValue = m_portal->DoubleBuffer()[0] / 1000.0;
+        double dn = demPixel(s, l);
+        if (!Isis::IsSpecial(dn)) {
+          m_demValue = dn / 1000.0;
           m_demValueFound = true;
           return m_demValue;
         }
@@ -385,23 +403,119 @@ namespace Isis {
     Distance distance=Distance();
 
     if (lat.isValid() && lon.isValid()) {
-      m_demProj->SetUniversalGround(lat.degrees(), lon.degrees());
+      distance = Distance(demRadius(lat.degrees(), lon.degrees()), Distance::Meters);
+    }
 
-      // The next if statement attempts to do the same as the previous one, but not as well so
-      // it was replaced.
-      // if (!m_demProj->IsGood())
-      //   return Distance();
+    return distance;
+  }
 
-      m_portal->SetPosition(m_demProj->WorldX(), m_demProj->WorldY(), 1);
 
-      m_demCube->read(*m_portal);
-      distance = Distance(m_interp->Interpolate(m_demProj->WorldX(),
-                                                m_demProj->WorldY(),
-                                                m_portal->DoubleBuffer()),
-                                                Distance::Meters);
+  /**
+   * Gets the radii from the DEM at many points. This is the same as calling
+   * localRadius for each point, without the overhead of a Latitude,
+   * Longitude and Distance per point.
+   *
+   * @param latitudes Universal latitudes in degrees
+   * @param longitudes Universal longitudes in degrees, one per latitude
+   *
+   * @return @b std::vector<double> Local radius from the DEM at each point in
+   *                                kilometers, or Null where there is none
+   */
+  std::vector<double> DemShape::localRadii(const std::vector<double> &latitudes,
+                                           const std::vector<double> &longitudes) {
+    if (latitudes.size() != longitudes.size()) {
+      QString msg = "Cannot compute local radii for [" + toString((int)latitudes.size()) +
+                    "] latitudes and [" + toString((int)longitudes.size()) + "] longitudes";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    std::vector<double> radii(latitudes.size(), Null);
+    for (size_t i = 0; i < latitudes.size(); i++) {
+      if (!IsSpecial(latitudes[i]) && !IsSpecial(longitudes[i])) {
+        double radius = demRadius(latitudes[i], longitudes[i]);
+        if (!IsSpecial(radius)) {
+          radii[i] = radius / 1000.0;
+        }
+      }
     }
 
-    return distance;
+    return radii;
+  }
+
+
+  /**
+   * Interpolates the DEM at a point. The four DNs around the point come from
+   * the DEM tiles cached in memory, so the DEM cube is only read when a tile
+   * is first used.
+   *
+   * @param latitude Universal latitude in degrees
+   * @param longitude Universal longitude in degrees
+   *
+   * @return @b double The radius in meters, or Null if it could not be found
+   */
+  double DemShape::demRadius(double latitude, double longitude) {
+    m_demProj->SetUniversalGround(latitude, longitude);
+
+    // The next if statement attempts to do the same as the previous one, but not as well so
+    // it was replaced.
+    // if (!m_demProj->IsGood())
+    //   return Null;
+
+    double sample = m_demProj->WorldX();
+    double line = m_demProj->WorldY();
+
+    // The same 2x2 window a Portal positioned for the bilinear interpolator would read
+    int startSample = (int)floor(sample - m_interp->HotSample());
+    int startLine = (int)floor(line - m_interp->HotLine());
+    double window[4] = {demPixel(startSample, startLine),
+                        demPixel(startSample + 1, startLine),
+                        demPixel(startSample, startLine + 1),
+                        demPixel(startSample + 1, startLine + 1)};
+
+    return m_interp->Interpolate(sample, line, window);
+  }
+
+
+  /**
+   * Returns a DN of band 1 of the DEM, reading its tile of the DEM into
+   * memory if it is not cached yet.
+   *
+   * @param sample The sample of the DN
+   * @param line The line of the DN
+   *
+   * @return @b double The DN, or Null outside of the DEM
+   */
+  double DemShape::demPixel(int sample, int line) {
+    if (sample < 1 || sample > m_demCube->sampleCount() ||
+        line < 1 || line > m_demCube->lineCount()) {
+      return Null;
+    }
+
+    int tileSample = (sample - 1) / s_demTileSize;
+    int tileLine = (line - 1) / s_demTileSize;
+    int tileIndex = tileLine * m_demTileColumns + tileSample;
+
+    if (tileIndex != m_lastDemTileIndex) {
+      QVector<double> *tile = m_demTiles->object(tileIndex);
+
+      if (!tile) {
+        Brick brick(s_demTileSize, s_demTileSize, 1, m_demCube->pixelType());
+        brick.SetBasePosition(tileSample * s_demTileSize + 1, tileLine * s_demTileSize + 1, 1);
+        m_demCube->read(brick);
+
+        tile = new QVector<double>(brick.size());
+        std::copy(brick.DoubleBuffer(), brick.DoubleBuffer() + brick.size(), tile->begin());
+
+        // Inserting can remove other tiles, but never the new one
+        m_demTiles->insert(tileIndex, tile);
+      }
+
+      m_lastDemTileIndex = tileIndex;
+      m_lastDemTile = tile;
+    }
+
+    return (*m_lastDemTile)[((line - 1) % s_demTileSize) * s_demTileSize +
+                            (sample - 1) % s_demTileSize];
   }
 
 
@@ -440,10 +554,7 @@ namespace Isis {
     double c = radii[2].kilometers();
 
     vector<double> normal(3,0.);
-
-    NaifStatus::CheckErrors();
-    surfnm_c(a, b, c, pB, (SpiceDouble *) &normal[0]);
-    NaifStatus::CheckErrors();
+    ellipsoidNormal(a, b, c, pB, &normal[0]);
 
     setNormal(normal);
     setHasNormal(true);
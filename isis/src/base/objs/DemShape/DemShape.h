@@ -9,12 +9,12 @@ find files of those names at the top level of this repository. **/
 
 #include "ShapeModel.h"
 
+template<class Key, class T> class QCache;
 template<class T> class QVector;
 
 namespace Isis {
   class Cube;
   class Interpolator;
-  class Portal;
   class Projection;
 
   /**
@@ -47,6 +47,9 @@ namespace Isis {
    *                           data areas. Fixes #4738.
    *   @history 2017-06-07 Kristin Berry - Added a using declaration so that the new
    *                            intersectSurface methods in ShapeModel are accessible by DemShape.
+   *   @history 2026-10-16 Isis Development Team - Each DemShape now has its own projection of
+   *                           the shared DEM cube, and intersections no longer make NAIF calls,
+   *                           so the shapes of cloned cameras can be used from several threads.
    *
    */
   class DemShape : public ShapeModel {
@@ -68,6 +71,8 @@ namespace Isis {
                             std::vector<double> lookDirection);
 
       Distance localRadius(const Latitude &lat, const Longitude &lon);
+      std::vector<double> localRadii(const std::vector<double> &latitudes,
+                                     const std::vector<double> &longitudes);
 
       // Return dem scale in pixels/degree
       double demScale();
@@ -105,12 +110,29 @@ namespace Isis {
       // Find a value in the DEM. Used when intersecting a ray with the DEM.
       // Returned value is in km. 
       double findDemValue();
-      
+
+      // Interpolate the DEM, in meters, at a universal latitude and longitude in degrees
+      double demRadius(double latitude, double longitude);
+      double demPixel(int sample, int line);
+
+      //! Samples and lines in the tiles of the DEM that are cached in memory
+      static const int s_demTileSize = 64;
+      //! Megabytes of DEM tiles cached when there is no DemTileCache preference
+      static const int s_defaultDemTileCache = 2;
+
       Cube *m_demCube;        //!< The cube containing the model
-      Projection *m_demProj;  //!< The projection of the model
+      Projection *m_demProj;  //!< This shape's own projection of the model
       double m_pixPerDegree;  //!< Scale of DEM file in pixels per degree
-      Portal *m_portal;       //!< Buffer used to read from the model
       Interpolator *m_interp; //!< Use bilinear interpolation from dem
+
+      /**
+       * Tiles of the DEM that have been read, by tile index. They hold the
+       *   DNs of band 1 so radii are interpolated without reading the cube.
+       */
+      QCache<int, QVector<double> > *m_demTiles;
+      int m_demTileColumns;             //!< Number of tiles across the DEM
+      int m_lastDemTileIndex;           //!< Index of the most recently used tile, or -1
+      const QVector<double> *m_lastDemTile; //!< The most recently used tile
       double m_demValue;      //!< A value picked from the dem
       bool m_demValueFound;   //!< True if it was attempted to find a value in the DEM
   };
@@ -18,7 +18,6 @@ find files of those names at the top level of this repository. **/
 #include "IString.h"
 #include "Latitude.h"
 #include "Longitude.h"
-#include "NaifStatus.h"
 #include "ShapeModel.h"
 #include "SurfacePoint.h"
 
@@ -126,9 +125,7 @@ namespace Isis {
     double c = radii[2].kilometers();
 
     vector<double> normal(3,0.);
-    NaifStatus::CheckErrors();
-    surfnm_c(a, b, c, pB, (SpiceDouble *) &normal[0]);
-    NaifStatus::CheckErrors();
+    ellipsoidNormal(a, b, c, pB, &normal[0]);
 
     setLocalNormal(normal);
     setHasLocalNormal(true);
@@ -185,6 +185,55 @@ namespace Isis {
   }
 
 
+  /**
+   * Intersects many rays with the target shape at once. The rays are traced
+   * concurrently by the Embree target shape, and the closest intersection of
+   * each ray is returned like intersectSurface(observerPos, lookDirection)
+   * would save it. The shape model is left without an intersection.
+   *
+   * @param observerPositions The body-fixed origin of each ray in kilometers
+   * @param lookDirections The body-fixed direction of each ray
+   *
+   * @return std::vector<SurfacePoint> The intersection of each ray. Rays that
+   *                                   miss the target get an invalid
+   *                                   SurfacePoint.
+   */
+  std::vector<SurfacePoint> EmbreeShapeModel::intersectSurfaces(
+      const std::vector< std::vector<double> > &observerPositions,
+      const std::vector< std::vector<double> > &lookDirections) {
+    if (observerPositions.size() != lookDirections.size()) {
+      QString msg = "Cannot intersect rays with [" + toString((int)observerPositions.size()) +
+                    "] observer positions and [" + toString((int)lookDirections.size()) +
+                    "] look directions";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Remove any previous intersection
+    clearSurfacePoint();
+
+    std::vector<RTCMultiHitRay> rays;
+    rays.reserve(observerPositions.size());
+    for (size_t i = 0; i < observerPositions.size(); i++) {
+      rays.push_back(RTCMultiHitRay(observerPositions[i], lookDirections[i]));
+    }
+
+    m_targetShape->intersectRays(rays);
+
+    std::vector<SurfacePoint> intersections(rays.size());
+    for (size_t i = 0; i < rays.size(); i++) {
+      if (rays[i].lastHit >= 0) {
+        RayHitInformation hitInfo = m_targetShape->getHitInformation(rays[i], 0);
+        double intersection[3] = {hitInfo.intersection[0],
+                                  hitInfo.intersection[1],
+                                  hitInfo.intersection[2]};
+        intersections[i].FromNaifArray(intersection);
+      }
+    }
+
+    return intersections;
+  }
+
+
 /**
  * @brief Compute intersection of surface vector direction from observer with 
  *        occulusion
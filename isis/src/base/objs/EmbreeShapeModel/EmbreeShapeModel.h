@@ -55,6 +55,9 @@ namespace Isis {
       virtual bool intersectSurface(const SurfacePoint &surfpt, 
                                     const std::vector<double> &observerPos,
                                     const bool &backCheck = true);
+      virtual std::vector<SurfacePoint> intersectSurfaces(
+          const std::vector< std::vector<double> > &observerPositions,
+          const std::vector< std::vector<double> > &lookDirections);
 
       virtual void clearSurfacePoint();
 
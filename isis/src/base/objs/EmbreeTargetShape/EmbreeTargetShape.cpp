@@ -7,11 +7,15 @@ find files of those names at the top level of this repository. **/
 
 #include "EmbreeTargetShape.h"
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <numeric>
 #include <sstream>
 
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "NaifDskApi.h"
 
 #include "FileName.h"
@@ -665,6 +669,47 @@ namespace Isis {
   }
 
 
+  /**
+   * Intersect many rays with the target shape. Afterwards, each ray holds
+   * its intersections like after intersectRay. Embree scenes can be traced
+   * from many threads at once, so blocks of the rays are traced concurrently
+   * on the global thread pool.
+   *
+   * @note The rays are traced one at a time instead of in Embree ray
+   *       packets because the multiple hit filter collects the hits of a
+   *       single ray.
+   *
+   * @param[in,out] rays The rays to intersect with the scene.
+   */
+  void EmbreeTargetShape::intersectRays(std::vector<RTCMultiHitRay> &rays) {
+    if (!isValid()) {
+      return;
+    }
+
+    const int raysPerBlock = 256;
+    int blockCount = ((int)rays.size() + raysPerBlock - 1) / raysPerBlock;
+
+    auto intersectBlock = [&](int block) {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      size_t end = std::min(rays.size(), (size_t)(block + 1) * raysPerBlock);
+      for (size_t i = (size_t)block * raysPerBlock; i < end; i++) {
+        rtcIntersect1(m_scene, &context, (RTCRayHit *)&rays[i]);
+      }
+    };
+
+    if (blockCount == 1) {
+      intersectBlock(0);
+      return;
+    }
+
+    QVector<int> blocks(blockCount);
+    std::iota(blocks.begin(), blocks.end(), 0);
+    QtConcurrent::blockingMap(blocks, intersectBlock);
+  }
+
+
   /**
    * Check if a ray intersects the target body.
    * 
@@ -7,6 +7,8 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <vector>
+
 #include <QString>
 
 // Embree includes
@@ -153,6 +155,7 @@ namespace Isis {
       double maximumSceneDistance() const;
 
       void intersectRay(RTCMultiHitRay &ray);
+      void intersectRays(std::vector<RTCMultiHitRay> &rays);
       bool isOccluded(RTCOcclusionRay &ray);
 
       RayHitInformation getHitInformation(RTCMultiHitRay &ray, int hitIndex);
@@ -25,7 +25,6 @@ find files of those names at the top level of this repository. **/
 #include "Latitude.h"
 // #include "LinearAlgebra.h"
 #include "Longitude.h"
-#include "NaifStatus.h"
 #include "SpecialPixel.h"
 #include "SurfacePoint.h"
 #include "Table.h"
@@ -394,12 +393,8 @@ namespace Isis {
       } // end while
 
       SpiceDouble intersectionPoint[3];
-      SpiceBoolean found;
-
-      NaifStatus::CheckErrors();
-      surfpt_c(&observerBodyFixedPos[0], &observerLookVectorToTarget[0], plen, plen, plen,
-               intersectionPoint, &found);
-      NaifStatus::CheckErrors();
+      bool found = ellipsoidIntercept(&observerBodyFixedPos[0], &observerLookVectorToTarget[0],
+                                      plen, plen, plen, intersectionPoint);
 
       surfaceIntersection()->FromNaifArray(intersectionPoint);
 
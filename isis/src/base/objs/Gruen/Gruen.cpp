@@ -840,6 +840,38 @@ namespace Isis {
     return (pvl);
   }
 
+  /**
+   * @brief Adds the statistics of another registration to this one
+   *
+   * The AutoReg statistics are added by the base class. If the other
+   * registration is also a Gruen, its error counts, iteration counts and
+   * eigen, iteration, radiometric shift and gain statistics are added to
+   * these as well.
+   *
+   * @param other Registration whose statistics are added to this one
+   */
+  void Gruen::AddStatistics(const AutoReg &other) {
+    AutoReg::AddStatistics(other);
+
+    const Gruen *gruen = dynamic_cast<const Gruen *>(&other);
+    if (!gruen) return;
+
+    m_callCount += gruen->m_callCount;
+    m_unclassified += gruen->m_unclassified;
+    m_totalIterations += gruen->m_totalIterations;
+    for (int e = 0 ; e < gruen->m_errors.size() ; e++) {
+      int gerrno = gruen->m_errors.key(e);
+      if (m_errors.exists(gerrno)) {
+        m_errors.get(gerrno).m_count += gruen->m_errors.getNth(e).Count();
+      }
+    }
+
+    m_eigenStat.merge(gruen->m_eigenStat);
+    m_iterStat.merge(gruen->m_iterStat);
+    m_shiftStat.merge(gruen->m_shiftStat);
+    m_gainStat.merge(gruen->m_gainStat);
+  }
+
   /**
    * @brief Create a PvlGroup with the Gruen specific statistics
    *
@@ -86,6 +86,8 @@ namespace Isis {
 
       void WriteSubsearchChips(const QString &pattern = "SubChip");
 
+      virtual void AddStatistics(const AutoReg &other);
+
       AffineTolerance getAffineTolerance() const;
 
       /** Returns the SPICE tolerance constraint as read from config file */
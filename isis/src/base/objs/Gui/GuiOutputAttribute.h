@@ -60,6 +60,7 @@ namespace Isis {
       QRadioButton *p_detached;
       QRadioButton *p_tiled;
       QRadioButton *p_bsq;
+      QRadioButton *p_compressedTiled;
       QRadioButton *p_lsb;
       QRadioButton *p_msb;
       bool p_propagationEnabled;
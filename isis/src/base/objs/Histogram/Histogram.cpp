@@ -311,6 +311,30 @@ namespace Isis {
     }
   }
 
+  /**
+   * Add the counts and statistics of another histogram to this one, as if
+   *   its data had been added here. The histograms must have the same bins.
+   *
+   * @param other The histogram to combine with this histogram
+   *
+   * @throws IException::Programmer The histograms have different bins
+   */
+  void Histogram::merge(const Histogram &other) {
+    if (p_bins.size() != other.p_bins.size() ||
+        BinRangeStart() != other.BinRangeStart() ||
+        BinRangeEnd() != other.BinRangeEnd()) {
+      QString msg = "Cannot merge histograms with different bins";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    Statistics::merge(other);
+
+    for (int i = 0; i < (int)p_bins.size(); i++) {
+      p_bins[i] += other.p_bins[i];
+    }
+  }
+
+
   /**
    * Returns the median.
    *
@@ -94,6 +94,8 @@ namespace Isis {
       virtual void AddData(const double data);
       virtual void RemoveData(const double *data, const unsigned int count);
 
+      void merge(const Histogram &other);
+
       double Median() const;
       double Mode() const;
       double Percent(const double percent) const;
@@ -11,12 +11,17 @@ find files of those names at the top level of this repository. **/
 #include <string>
 #include <vector>
 
+#include <QHash>
+
 #include "Cube.h"
 #include "FileName.h"
 #include "geos/operation/distance/DistanceOp.h"
 #include "geos/util/IllegalArgumentException.h"
+#include "geos/geom/Envelope.h"
 #include "geos/geom/Point.h"
+#include "geos/index/strtree/STRtree.h"
 //#include "geos/opOverlay.h"
+#include "geos/operation/overlay/snap/GeometrySnapper.h"
 #include "geos/operation/overlay/snap/SnapOverlayOp.h"
 
 #include "IException.h"
@@ -549,6 +554,29 @@ namespace Isis {
 
     geos::geom::MultiPolygon *emptyPolygon = Isis::globalFactory->createMultiPolygon().release();
 
+    // Index the envelopes of the starting polygons. Empty and degenerate
+    //   polygons are left out, so they always get the checks below. The
+    //   polygons change as overlaps are found, so an indexed envelope only
+    //   stands for a polygon while the polygon still has that envelope.
+    std::vector<geos::geom::Envelope> indexedEnvelopes;
+    indexedEnvelopes.reserve(p_lonLatOverlaps.size());
+    QHash<const ImageOverlap *, int> indexedOverlaps;
+    geos::index::strtree::STRtree envelopeTree;
+    for (int i = 0; i < p_lonLatOverlaps.size(); i++) {
+      const geos::geom::MultiPolygon *poly = p_lonLatOverlaps.at(i)->Polygon();
+      if (!poly->isEmpty() && poly->getArea() >= 1.0e-14) {
+        indexedEnvelopes.push_back(*poly->getEnvelopeInternal());
+        indexedOverlaps.insert(p_lonLatOverlaps.at(i), indexedEnvelopes.size() - 1);
+        envelopeTree.insert(&indexedEnvelopes.back(), &indexedEnvelopes.back());
+      }
+    }
+
+    // The indexed polygons that may overlap the current outside polygon
+    std::vector<bool> candidates(indexedEnvelopes.size(), false);
+    std::vector<void *> candidateEnvelopes;
+    const ImageOverlap *candidatesOverlap = NULL;
+    geos::geom::Envelope candidatesEnvelope;
+
     // Compare each polygon with all of the others
     for (int outside = 0; outside < p_lonLatOverlaps.size() - 1; ++outside) {
       p_calculatedSoFar = outside - 1;
@@ -565,6 +593,43 @@ namespace Isis {
       // below it
       for (int inside = outside + 1; inside < p_lonLatOverlaps.size(); ++inside) {
         try {
+          // Find the candidates again whenever the outside polygon changes
+          const ImageOverlap *outsideOverlap = p_lonLatOverlaps.at(outside);
+          const geos::geom::Envelope *outsideEnvelope =
+              outsideOverlap->Polygon()->getEnvelopeInternal();
+          if (outsideOverlap != candidatesOverlap || !outsideEnvelope->equals(&candidatesEnvelope)) {
+            for (unsigned int i = 0; i < candidateEnvelopes.size(); i++) {
+              candidates[(geos::geom::Envelope *)candidateEnvelopes[i] - &indexedEnvelopes[0]] =
+                  false;
+            }
+            candidateEnvelopes.clear();
+
+            // Grow the envelope by the snapping tolerances of the intersection below
+            candidatesOverlap = outsideOverlap;
+            candidatesEnvelope = *outsideEnvelope;
+            geos::geom::Envelope searchEnvelope(candidatesEnvelope);
+            searchEnvelope.expandBy(1.0e-10 +
+                geos::operation::overlay::snap::GeometrySnapper::computeOverlaySnapTolerance(
+                    *outsideOverlap->Polygon()));
+            envelopeTree.query(&searchEnvelope, candidateEnvelopes);
+
+            for (unsigned int i = 0; i < candidateEnvelopes.size(); i++) {
+              candidates[(geos::geom::Envelope *)candidateEnvelopes[i] - &indexedEnvelopes[0]] =
+                  true;
+            }
+          }
+
+          // An indexed polygon the tree did not return is not empty, not
+          //   equal to the outside polygon and does not overlap it, so none
+          //   of the checks below would do anything with it
+          QHash<const ImageOverlap *, int>::const_iterator indexed =
+              indexedOverlaps.constFind(p_lonLatOverlaps.at(inside));
+          if (indexed != indexedOverlaps.constEnd() && !candidates[indexed.value()] &&
+              p_lonLatOverlaps.at(inside)->Polygon()->getEnvelopeInternal()->equals(
+                  &indexedEnvelopes[indexed.value()])) {
+            continue;
+          }
+
           if (p_lonLatOverlaps.at(outside)->HasAnySameSerialNumber(*p_lonLatOverlaps.at(inside)))
             continue;
 
@@ -592,6 +657,20 @@ namespace Isis {
             continue;
           }
 
+          // Polygons whose envelopes are apart can not overlap, so skip the
+          //   (by far most expensive) intersection. PolygonTools snaps the
+          //   polygons to each other and SnapOverlayOp snaps them again
+          //   before intersecting, so only pairs further apart than both
+          //   snapping tolerances are skipped. This catches the polygons that
+          //   changed since they were indexed.
+          double snapTolerance = 1.0e-10 +
+              geos::operation::overlay::snap::GeometrySnapper::computeOverlaySnapTolerance(
+                  *poly1, *poly2);
+          if (poly1->getEnvelopeInternal()->distance(*poly2->getEnvelopeInternal()) >
+              snapTolerance) {
+            continue;
+          }
+
           geos::geom::Geometry *intersected = NULL;
           try {
             intersected = PolygonTools::Intersect(poly1, poly2);
@@ -116,6 +116,9 @@ namespace Isis {
     Clear();  // Clear the stack
     m_equation = equation;
     m_functions.clear();  // Clear function list
+    m_program.clear();
+    m_programInputs.clear();
+    bool programCompiled = true;
  
     QStringList tokenList = tokenOps.split(" ");
     while ( !tokenList.isEmpty() ) {
@@ -139,6 +142,7 @@ namespace Isis {
           // Will also get line, sample, band, etc...
           fx = addFunction(new ParameterFx(token, &InlineCalculator::variable, this));
           m_functions.push_back(fx);
+          m_variableNames.append(token);
         }
         else {
             //  Parameter not recognized during compile.  All unknown tokens are
@@ -157,8 +161,16 @@ namespace Isis {
             nerrors++;
           }
         }
+
+        if (programCompiled) {
+          programCompiled = compileToken(token);
+        }
       }
     }
+
+    if (!programCompiled) {
+      m_program.clear();
+    }
  
     //  Might want to make this optional here
     if (nerrors > 0) {  
@@ -216,6 +228,16 @@ namespace Isis {
    *  
    */
   QVector<double> InlineCalculator::evaluate() {
+
+    if (m_program.isValid()) {
+      // Keeps the variable values alive while the program reads them
+      QVector< QVector<double> > values(m_programInputs.size());
+      for (int i = 0; i < m_programInputs.size(); i++) {
+        values[i] = variableValues(m_programInputs[i]);
+        m_program.setInput(i, values[i].constData(), values[i].size());
+      }
+      return (m_program.evaluate());
+    }
  
     BOOST_FOREACH (FxTypePtr function,  m_functions) {
       function->execute();
@@ -307,18 +329,113 @@ namespace Isis {
    * @throw IException::User "Could not find variable in variable pool."
    */  
   void InlineCalculator::variable(const QVariant &variable) {
+    QVector<double> values = variableValues(variable.toString());
+    Push(values);
+  }
+
+
+  /**
+   * Looks up the values of a variable in the current variable pool.
+   *
+   * @param key The name of the variable
+   *
+   * @return QVector \< double \> The values of the variable.
+   * @throw IException::User "Could not find variable in variable pool."
+   */
+  QVector<double> InlineCalculator::variableValues(const QString &key) {
     CalculatorVariablePool *variablePool = variables();
-    QString key = variable.toString();
     if (variablePool->exists(key)) {
-      QVector<double> values = variablePool->value(key);
-      Push(values);
-      return;
+      return (variablePool->value(key));
     }
  
     // Error!
     QString error = "Could not find variable [" + key + "] in variable pool.";
     throw IException(IException::User, error, _FILEINFO_);
   }
+
+
+  /**
+   * Adds a token of the equation being compiled to the compiled program.
+   * Scalars, variables and the functions added by initialize() can be compiled.
+   *
+   * @param token The token, in postfix order
+   *
+   * @return bool False if the token cannot be compiled and the equation must be
+   *              evaluated on the stack.
+   */
+  bool InlineCalculator::compileToken(const QString &token) {
+    CalculatorProgram::Operator op;
+
+    if (token == "pi") {
+      m_program.pushConstant(pi_c());
+      return (true);
+    }
+    else if (token == "e") {
+      m_program.pushConstant(E);
+      return (true);
+    }
+    else if (token == "rads") {
+      m_program.pushConstant(rpd_c());
+      op = CalculatorProgram::Multiply;
+    }
+    else if (token == "degs") {
+      m_program.pushConstant(dpr_c());
+      op = CalculatorProgram::Multiply;
+    }
+    else if (token == "^") op = CalculatorProgram::Exponent;
+    else if (token == "/") op = CalculatorProgram::Divide;
+    else if (token == "*") op = CalculatorProgram::Multiply;
+    else if (token == "<<") op = CalculatorProgram::LeftShift;
+    else if (token == ">>") op = CalculatorProgram::RightShift;
+    else if (token == "+") op = CalculatorProgram::Add;
+    else if (token == "-") op = CalculatorProgram::Subtract;
+    else if (token == ">") op = CalculatorProgram::GreaterThan;
+    else if (token == "<") op = CalculatorProgram::LessThan;
+    else if (token == ">=") op = CalculatorProgram::GreaterThanOrEqual;
+    else if (token == "<=") op = CalculatorProgram::LessThanOrEqual;
+    else if (token == "==") op = CalculatorProgram::Equal;
+    else if (token == "!=") op = CalculatorProgram::NotEqual;
+    else if (token == "&" || token == "and") op = CalculatorProgram::And;
+    else if (token == "|" || token == "or") op = CalculatorProgram::Or;
+    else if (token == "%" || token == "fmod") op = CalculatorProgram::FloatModulus;
+    else if (token == "mod") op = CalculatorProgram::Modulus;
+    else if (token == "--" || token == "neg") op = CalculatorProgram::Negative;
+    else if (token == "min") op = CalculatorProgram::MinimumPixel;
+    else if (token == "max") op = CalculatorProgram::MaximumPixel;
+    else if (token == "abs") op = CalculatorProgram::AbsoluteValue;
+    else if (token == "sqrt") op = CalculatorProgram::SquareRoot;
+    else if (token == "log" || token == "ln") op = CalculatorProgram::Log;
+    else if (token == "log10") op = CalculatorProgram::Log10;
+    else if (token == "sin") op = CalculatorProgram::Sine;
+    else if (token == "cos") op = CalculatorProgram::Cosine;
+    else if (token == "tan") op = CalculatorProgram::Tangent;
+    else if (token == "sec") op = CalculatorProgram::Secant;
+    else if (token == "csc") op = CalculatorProgram::Cosecant;
+    else if (token == "cot") op = CalculatorProgram::Cotangent;
+    else if (token == "asin") op = CalculatorProgram::Arcsine;
+    else if (token == "acos") op = CalculatorProgram::Arccosine;
+    else if (token == "atan") op = CalculatorProgram::Arctangent;
+    else if (token == "atan2") op = CalculatorProgram::Arctangent2;
+    else if (token == "||") op = CalculatorProgram::LogicalOr;
+    else if (token == "&&") op = CalculatorProgram::LogicalAnd;
+    else if (isScalar(token)) {
+      m_program.pushConstant(toDouble(token));
+      return (true);
+    }
+    else if (m_variableNames.contains(token)) {
+      if (!m_programInputs.contains(token)) {
+        m_programInputs.append(token);
+      }
+      m_program.pushInput(m_programInputs.indexOf(token));
+      return (true);
+    }
+    else {
+      return (false);
+    }
+
+    m_program.pushOperator(op);
+    return (true);
+  }
  
 
   /**
@@ -13,8 +13,11 @@ find files of those names at the top level of this repository. **/
 #include <QList>
 #include <QMap>
 #include <QString>
+#include <QStringList>
 #include <QVector>
 
+#include "CalculatorProgram.h"
+
 class QVariant;
 
 namespace Isis {
@@ -36,6 +39,11 @@ namespace Isis {
    * A calculator with the ability to parse infix equations with embedded
    * variables and scalars, known as an inline equation.
    *  
+   * Equations made only of scalars, variables and the built in functions are
+   * also compiled into a CalculatorProgram, which evaluate() uses instead of
+   * dispatching each function on the stack. Equations that use functions added
+   * by derived classes or tokens resolved by orphanTokenHandler() are always
+   * evaluated on the stack.
    *  
    * @author 2012-07-15 Kris Becker
    * @internal
@@ -98,6 +106,9 @@ namespace Isis {
       void pushVariables(CalculatorVariablePool *variablePool);
       CalculatorVariablePool *variables();
       void popVariables();
+      QVector<double> variableValues(const QString &key);
+
+      bool compileToken(const QString &token);
  
       FxTypePtr find(const QString &fxname);
       void initialize();
@@ -107,6 +118,10 @@ namespace Isis {
       FxPoolType  m_fxPool;    //!< The map between function names and equation lists.
       QString     m_equation;  //!< The equation to be evaluated.
       QList<CalculatorVariablePool *> m_variablePoolList; //!< The list of variable pool pointers.
+
+      CalculatorProgram m_program;  //!< The compiled equation, invalid if it must use the stack.
+      QStringList m_programInputs;  //!< The variable bound to each input of m_program.
+      QStringList m_variableNames;  //!< The functions in m_fxPool that push variables.
  
   };
  
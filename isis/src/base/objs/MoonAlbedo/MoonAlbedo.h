@@ -27,6 +27,11 @@ namespace Isis {
       MoonAlbedo(Pvl &pvl, PhotoModel &pmodel);
       virtual ~MoonAlbedo() {};
 
+      //! The albedo is iterated on the phase function, so it is a nonlinear function of the DN
+      virtual bool IsLinearInDn() const {
+        return false;
+      }
+
     protected:
       virtual void NormModelAlgorithm(double pha, double inc, double ema,
                                       double dn, double &albedo, double &mult, double &base) {};
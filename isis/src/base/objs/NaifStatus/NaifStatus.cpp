@@ -8,6 +8,8 @@ find files of those names at the top level of this repository. **/
 
 #include <iostream>
 
+#include <QRecursiveMutex>
+
 #include <SpiceUsr.h>
 
 #include "IException.h"
@@ -18,6 +20,20 @@ find files of those names at the top level of this repository. **/
 namespace Isis {
   bool NaifStatus::initialized = false;
 
+  /**
+   * Returns the mutex that serializes NAIF calls within the process. CSPICE
+   * keeps its error status, traceback and loaded kernels in global state, so
+   * code that evaluates cameras, loads or unloads kernels or makes other NAIF
+   * calls on more than one thread must hold this mutex while doing so. It is
+   * recursive so that locked code can call other code that locks it.
+   *
+   * @return QRecursiveMutex* The NAIF mutex
+   */
+  QRecursiveMutex *NaifStatus::mutex() {
+    static QRecursiveMutex naifMutex;
+    return &naifMutex;
+  }
+
   /**
    * This method looks for any naif errors that might have occurred. It
    * then compares the error to a list of known naif errors and converts
@@ -7,6 +7,8 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+class QRecursiveMutex;
+
 namespace Isis {
   /**
    * @brief Class for checking for errors in the NAIF library
@@ -21,6 +23,7 @@ namespace Isis {
   class NaifStatus {
     public:
       static void CheckErrors(bool resetNaif = true);
+      static QRecursiveMutex *mutex();
     private:
       static bool initialized;
   };
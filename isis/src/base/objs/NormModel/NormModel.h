@@ -32,6 +32,8 @@ namespace Isis {
    *                      method is called from the Photometry class.
    *  @history 2008-06-18 Steven Koechle - Fixed Documentation Errors
    *  @history 2008-07-09 Steven Lambright - Fixed unit test
+   *  @history 2026-10-16 Isis Development Team - Added IsLinearInDn and the geometry term
+   *                      methods used by the Photometry lookup table.
    */
   class NormModel {
     public:
@@ -52,6 +54,50 @@ namespace Isis {
                          double &mult, double &base);
       virtual void SetNormWavelength(double wavelength);
 
+      /**
+       * Returns whether the albedo is linear in the DN for fixed angles, which
+       * Photometry::CreateLookupTable requires
+       *
+       * @return bool True if albedo = mult * dn + base
+       */
+      virtual bool IsLinearInDn() const {
+        return true;
+      }
+
+      /**
+       * Returns the number of terms of the normalization that depend only on the
+       * photometric angles, which Photometry::CreateLookupTable can tabulate for
+       * models that are not linear in the DN. Models without such terms return 0.
+       *
+       * @return int Number of terms CalcGeometryTerms computes
+       */
+      virtual int GeometryTermCount() const {
+        return 0;
+      }
+
+      /**
+       * Computes the terms of the normalization that depend only on the
+       * photometric angles, for the local angles equal to the ellipsoid angles
+       *
+       * @param pha The phase angle
+       * @param inc The incidence angle
+       * @param ema The emission angle
+       * @param terms Returns GeometryTermCount() terms
+       */
+      virtual void CalcGeometryTerms(double pha, double inc, double ema, double *terms) {}
+
+      /**
+       * Computes the normalized albedo from the terms CalcGeometryTerms computed,
+       * which gives the albedo of CalcNrmAlbedo when the terms are exact
+       *
+       * @param inc The incidence angle
+       * @param terms The terms of the angles
+       * @param dn The DN value
+       * @param albedo Returns the normalized albedo
+       */
+      virtual void CalcNrmAlbedoFromTerms(double inc, const double *terms, double dn,
+                                          double &albedo) {}
+
     protected:
       virtual void NormModelAlgorithm(double pha, double inc, double ema,
                                       double dn, double &albedo, double &mult, double &base) = 0;
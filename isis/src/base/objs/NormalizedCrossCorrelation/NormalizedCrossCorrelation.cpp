@@ -0,0 +1,357 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "NormalizedCrossCorrelation.h"
+
+#include <cmath>
+#include <vector>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "Chip.h"
+#include "MultivariateStatistics.h"
+#include "SpecialPixel.h"
+
+namespace Isis {
+  /**
+   * Returns the dot product of two arrays.
+   *
+   * @param a The first array
+   * @param b The second array
+   * @param count The number of values in each array
+   *
+   * @return double The sum of the products of the values
+   */
+  static double dotProduct(const double *a, const double *b, int count) {
+    double sum = 0.0;
+    int i = 0;
+
+#if defined(__AVX__)
+    __m256d sums = _mm256_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+      sums = _mm256_add_pd(sums, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sums);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+    __m128d sums = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2) {
+      sums = _mm_add_pd(sums, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, sums);
+    sum = lanes[0] + lanes[1];
+#endif
+
+    for (; i < count; i++) {
+      sum += a[i] * b[i];
+    }
+    return sum;
+  }
+
+
+  /**
+   * Returns the sum of a summed-area table over a window.
+   *
+   * @param table The summed-area table, one sample and line larger than the
+   *              area it sums, in line major order
+   * @param tableSamples The number of samples in the table
+   * @param sample The first sample of the window, from 0
+   * @param line The first line of the window, from 0
+   * @param samples The number of samples in the window
+   * @param lines The number of lines in the window
+   *
+   * @return T The sum over the window
+   */
+  template <typename T>
+  static T windowSum(const std::vector<T> &table, int tableSamples,
+                     int sample, int line, int samples, int lines) {
+    return table[(line + lines) * tableSamples + sample + samples]
+           - table[line * tableSamples + sample + samples]
+           - table[(line + lines) * tableSamples + sample]
+           + table[line * tableSamples + sample];
+  }
+
+
+  /**
+   * Computes the goodness of fit for one pair of chips. This is the same as
+   * MaximumCorrelation and is only used when a single pair is matched.
+   *
+   * @param pattern Pattern chip to match against
+   * @param subsearch Subchip of the search chip to match with
+   *
+   * @return double The absolute value of the correlation, or Null
+   */
+  double NormalizedCrossCorrelation::MatchAlgorithm(Chip &pattern, Chip &subsearch) {
+    MultivariateStatistics mv;
+    std::vector <double> pdn, sdn;
+    pdn.resize(pattern.Samples());
+    sdn.resize(pattern.Samples());
+
+    for(int l = 1; l <= pattern.Lines(); l++) {
+      for(int s = 1; s <= pattern.Samples(); s++) {
+        pdn[s-1] = pattern.GetValue(s, l);
+        sdn[s-1] = subsearch.GetValue(s, l);
+      }
+      mv.AddData(&pdn[0], &sdn[0], pattern.Samples());
+    }
+    double percentValid = (double) mv.ValidPixels() /
+                          (pattern.Lines() * pattern.Samples());
+    if(percentValid * 100.0 < this->PatternValidPercent()) return Isis::Null;
+
+    double r = mv.Correlation();
+    if(r == Isis::Null) return Isis::Null;
+    return fabs(r);
+  }
+
+
+  /**
+   * Fills the fit chip with the absolute value of the correlation between the
+   * pattern chip and the sub-search chip at every position in the window.
+   *
+   * The sub-search chips are never extracted. The values are shifted by the
+   * mean of the valid pattern and search pixels, which leaves the correlation
+   * unchanged and keeps the summed-area tables from losing precision.
+   *
+   * @param sChip Search chip
+   * @param pChip Pattern chip
+   * @param fChip Fit chip, the same size as the search chip
+   * @param startSamp Start sample
+   * @param endSamp End sample
+   * @param startLine Start line
+   * @param endLine End line
+   */
+  void NormalizedCrossCorrelation::MatchWindow(Chip &sChip, Chip &pChip, Chip &fChip,
+                                               int startSamp, int endSamp,
+                                               int startLine, int endLine) {
+    if (startSamp > endSamp || startLine > endLine) return;
+
+    int patternSamples = pChip.Samples();
+    int patternLines = pChip.Lines();
+    int patternSize = patternSamples * patternLines;
+
+    // Copy the pattern with its invalid pixels zeroed
+    double patternMean = 0.0;
+    int patternValid = 0;
+    for (int line = 1; line <= patternLines; line++) {
+      for (int samp = 1; samp <= patternSamples; samp++) {
+        double value = pChip.GetValue(samp, line);
+        if (IsValidPixel(value)) {
+          patternMean += value;
+          patternValid++;
+        }
+      }
+    }
+    if (patternValid > 0) patternMean /= patternValid;
+
+    std::vector<double> patternMask(patternSize, 0.0);
+    std::vector<double> patternValues(patternSize, 0.0);
+    std::vector<double> patternSquares(patternSize, 0.0);
+    double sumPattern = 0.0;
+    double sumPatternSquares = 0.0;
+    for (int line = 0; line < patternLines; line++) {
+      for (int samp = 0; samp < patternSamples; samp++) {
+        double value = pChip.GetValue(samp + 1, line + 1);
+        if (IsValidPixel(value)) {
+          int index = line * patternSamples + samp;
+          patternMask[index] = 1.0;
+          patternValues[index] = value - patternMean;
+          patternSquares[index] = patternValues[index] * patternValues[index];
+          sumPattern += patternValues[index];
+          sumPatternSquares += patternSquares[index];
+        }
+      }
+    }
+
+    // The area of the search chip the sub-search chips cover. Chip::Extract
+    // fills the parts of a sub-search chip outside the search chip with nulls.
+    int tackSample = (patternSamples - 1) / 2 + 1;
+    int tackLine = (patternLines - 1) / 2 + 1;
+    int firstSample = startSamp - tackSample + 1;
+    int firstLine = startLine - tackLine + 1;
+    int areaSamples = endSamp - startSamp + patternSamples;
+    int areaLines = endLine - startLine + patternLines;
+    int areaSize = areaSamples * areaLines;
+
+    std::vector<double> areaData(areaSize, Isis::Null);
+    std::vector<bool> areaChipValid(areaSize, false);
+    double searchMean = 0.0;
+    int searchValid = 0;
+    for (int line = 0; line < areaLines; line++) {
+      int chipLine = firstLine + line;
+      if (chipLine < 1 || chipLine > sChip.Lines()) continue;
+
+      for (int samp = 0; samp < areaSamples; samp++) {
+        int chipSamp = firstSample + samp;
+        if (chipSamp < 1 || chipSamp > sChip.Samples()) continue;
+
+        int index = line * areaSamples + samp;
+        areaData[index] = sChip.GetValue(chipSamp, chipLine);
+        areaChipValid[index] = sChip.IsValid(chipSamp, chipLine);
+        if (IsValidPixel(areaData[index])) {
+          searchMean += areaData[index];
+          searchValid++;
+        }
+      }
+    }
+    if (searchValid > 0) searchMean /= searchValid;
+
+    // Copy the search area with its invalid pixels zeroed, and build the
+    // summed-area tables
+    std::vector<double> searchMask(areaSize, 0.0);
+    std::vector<double> searchValues(areaSize, 0.0);
+    std::vector<double> searchSquares(areaSize, 0.0);
+
+    int tableSamples = areaSamples + 1;
+    int tableSize = tableSamples * (areaLines + 1);
+    std::vector<int> chipValidTable(tableSize, 0);
+    std::vector<int> invalidTable(tableSize, 0);
+    std::vector<double> sumTable(tableSize, 0.0);
+    std::vector<double> squaresTable(tableSize, 0.0);
+
+    for (int line = 0; line < areaLines; line++) {
+      int chipValidRow = 0;
+      int invalidRow = 0;
+      double sumRow = 0.0;
+      double squaresRow = 0.0;
+      for (int samp = 0; samp < areaSamples; samp++) {
+        int index = line * areaSamples + samp;
+        if (IsValidPixel(areaData[index])) {
+          searchMask[index] = 1.0;
+          searchValues[index] = areaData[index] - searchMean;
+          searchSquares[index] = searchValues[index] * searchValues[index];
+        }
+        else {
+          invalidRow++;
+        }
+        if (areaChipValid[index]) chipValidRow++;
+        sumRow += searchValues[index];
+        squaresRow += searchSquares[index];
+
+        int table = (line + 1) * tableSamples + samp + 1;
+        chipValidTable[table] = chipValidTable[table - tableSamples] + chipValidRow;
+        invalidTable[table] = invalidTable[table - tableSamples] + invalidRow;
+        sumTable[table] = sumTable[table - tableSamples] + sumRow;
+        squaresTable[table] = squaresTable[table - tableSamples] + squaresRow;
+      }
+    }
+
+    // Walk the window
+    for (int line = startLine; line <= endLine; line++) {
+      int areaLine = line - startLine;
+      for (int samp = startSamp; samp <= endSamp; samp++) {
+        int areaSamp = samp - startSamp;
+
+        // Make sure the sub-search chip has enough valid data
+        int validCount = windowSum(chipValidTable, tableSamples, areaSamp, areaLine,
+                                   patternSamples, patternLines);
+        double validPercentage = 100.0 * (double) validCount / (double) patternSize;
+        if (validPercentage < SubsearchValidPercent()) continue;
+
+        double count, sumP, sumPP, sumS, sumSS, sumPS = 0.0;
+        if (patternValid == patternSize &&
+            windowSum(invalidTable, tableSamples, areaSamp, areaLine,
+                      patternSamples, patternLines) == 0) {
+          count = patternSize;
+          sumP = sumPattern;
+          sumPP = sumPatternSquares;
+          sumS = windowSum(sumTable, tableSamples, areaSamp, areaLine,
+                           patternSamples, patternLines);
+          sumSS = windowSum(squaresTable, tableSamples, areaSamp, areaLine,
+                            patternSamples, patternLines);
+          for (int pline = 0; pline < patternLines; pline++) {
+            int searchIndex = (areaLine + pline) * areaSamples + areaSamp;
+            sumPS += dotProduct(&patternValues[pline * patternSamples],
+                                &searchValues[searchIndex], patternSamples);
+          }
+        }
+        else {
+          // Only use the pixels valid in both chips
+          count = sumP = sumPP = sumS = sumSS = 0.0;
+          for (int pline = 0; pline < patternLines; pline++) {
+            int patternIndex = pline * patternSamples;
+            int searchIndex = (areaLine + pline) * areaSamples + areaSamp;
+            count += dotProduct(&patternMask[patternIndex], &searchMask[searchIndex],
+                                patternSamples);
+            sumP += dotProduct(&patternValues[patternIndex], &searchMask[searchIndex],
+                               patternSamples);
+            sumPP += dotProduct(&patternSquares[patternIndex], &searchMask[searchIndex],
+                                patternSamples);
+            sumS += dotProduct(&patternMask[patternIndex], &searchValues[searchIndex],
+                               patternSamples);
+            sumSS += dotProduct(&patternMask[patternIndex], &searchSquares[searchIndex],
+                                patternSamples);
+            sumPS += dotProduct(&patternValues[patternIndex], &searchValues[searchIndex],
+                                patternSamples);
+          }
+        }
+
+        double fit = Fit(count, patternSize, sumP, sumPP, sumS, sumSS, sumPS);
+        if (fit != Isis::Null) {
+          fChip.SetValue(samp, line, fit);
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Computes the absolute value of the correlation from the sums over the
+   * pixels valid in both the pattern and the sub-search chip, the way
+   * MultivariateStatistics does.
+   *
+   * @param count The number of pixels valid in both chips
+   * @param patternSize The number of pixels in the pattern chip
+   * @param sumPattern The sum of the pattern values
+   * @param sumPatternSquares The sum of the squares of the pattern values
+   * @param sumSearch The sum of the sub-search values
+   * @param sumSearchSquares The sum of the squares of the sub-search values
+   * @param sumProducts The sum of the products of the pattern and sub-search values
+   *
+   * @return double The absolute value of the correlation, or Null if the
+   *                pattern valid percent is not met or either chip is flat
+   */
+  double NormalizedCrossCorrelation::Fit(double count, int patternSize, double sumPattern,
+                                         double sumPatternSquares, double sumSearch,
+                                         double sumSearchSquares, double sumProducts) const {
+    double percentValid = count / patternSize;
+    if (percentValid * 100.0 < PatternValidPercent()) return Isis::Null;
+    if (count <= 1.0) return Isis::Null;
+
+    // Flat chips can be left with a variance of round-off instead of zero
+    const double flatTolerance = 1.0e-12;
+    double patternVariance = count * sumPatternSquares - sumPattern * sumPattern;
+    if (patternVariance <= flatTolerance * count * sumPatternSquares) return Isis::Null;
+    double searchVariance = count * sumSearchSquares - sumSearch * sumSearch;
+    if (searchVariance <= flatTolerance * count * sumSearchSquares) return Isis::Null;
+
+    double covariance = (sumProducts - sumPattern * sumSearch / count) / (count - 1.0);
+    double r = covariance / (sqrt(patternVariance / ((count - 1.0) * count)) *
+                             sqrt(searchVariance / ((count - 1.0) * count)));
+    return fabs(r);
+  }
+
+
+  /**
+   * This virtual method must return if the 1st fit is equal to or better
+   * than the second fit.
+   *
+   * @param fit1  1st goodness of fit
+   * @param fit2  2nd goodness of fit
+   */
+  bool NormalizedCrossCorrelation::CompareFits(double fit1, double fit2) {
+    return (fit1 >= fit2);
+  }
+}
+
+extern "C" Isis::AutoReg *NormalizedCrossCorrelationPlugin(Isis::Pvl &pvl) {
+  return new Isis::NormalizedCrossCorrelation(pvl);
+}
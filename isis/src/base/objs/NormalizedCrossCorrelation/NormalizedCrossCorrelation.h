@@ -0,0 +1,68 @@
+#ifndef NormalizedCrossCorrelation_h
+#define NormalizedCrossCorrelation_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "AutoReg.h"
+
+namespace Isis {
+  class Pvl;
+  class Chip;
+
+  /**
+   * @brief Normalized cross correlation pattern matching
+   *
+   * This class computes the same goodness of fit as MaximumCorrelation, the
+   * absolute value of the correlation between the pattern chip and each
+   * sub-search chip, but for the whole search window at once instead of
+   * extracting every sub-search chip.
+   *
+   * The pattern and the search window are copied once into arrays in which
+   * invalid pixels are zero and have a zero mask. Summed-area tables of the
+   * search window give the valid pixel counts, sums and sums of squares of
+   * every sub-search chip. The cross products with the pattern are SIMD dot
+   * products along the lines. When the pattern or a sub-search chip has
+   * invalid pixels, all the sums are masked dot products instead, so only
+   * pixels valid in both chips are used, just like MaximumCorrelation.
+   *
+   * The fit chip matches MaximumCorrelation's to round-off, so the surface
+   * model and sub-pixel registration work the same way. Sub-search chips
+   * whose variance is lost to round-off are not fit.
+   *
+   * @ingroup PatternMatching
+   *
+   * @see MaximumCorrelation AutoReg
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class NormalizedCrossCorrelation : public AutoReg {
+    public:
+      NormalizedCrossCorrelation(Pvl &pvl) : AutoReg(pvl) { };
+      virtual ~NormalizedCrossCorrelation() {};
+
+    protected:
+      virtual double MatchAlgorithm(Chip &pattern, Chip &subsearch);
+      virtual void MatchWindow(Chip &sChip, Chip &pChip, Chip &fChip,
+                               int startSamp, int endSamp, int startLine, int endLine);
+      virtual bool CompareFits(double fit1, double fit2);
+      virtual double IdealFit() const {
+        return 1.0;
+      };
+      virtual QString AlgorithmName() const {
+        return "NormalizedCrossCorrelation";
+      };
+
+    private:
+      double Fit(double count, int patternSize, double sumPattern,
+                 double sumPatternSquares, double sumSearch, double sumSearchSquares,
+                 double sumProducts) const;
+  };
+};
+
+#endif
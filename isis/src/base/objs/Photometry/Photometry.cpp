@@ -4,6 +4,9 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <algorithm>
+#include <cmath>
+
 #include "IException.h"
 #include "IString.h"
 #include "Pvl.h"
@@ -16,6 +19,7 @@ find files of those names at the top level of this repository. **/
 #include "NormModel.h"
 #include "Plugin.h"
 #include "FileName.h"
+#include "SpecialPixel.h"
 
 namespace Isis {
   /**
@@ -29,6 +33,8 @@ namespace Isis {
     p_phtAmodel = NULL;
     p_phtPmodel = NULL;
     p_phtNmodel = NULL;
+    p_lutLinear = true;
+    p_lutTermCount = 0;
     if(pvl.hasObject("PhotometricModel")) {
       p_phtPmodel = PhotoModelFactory::Create(pvl);
     } else {
@@ -92,6 +98,11 @@ namespace Isis {
   /**
    * Calculate the surface brightness using ellipsoid and dem
    *
+   * If a lookup table has been created and the dem angles are the ellipsoid
+   * angles, the brightness is interpolated from the table where it is
+   * accurate enough. In that case mult and base are the interpolated linear
+   * coefficients of the normalization, so that albedo = mult * dn + base.
+   *
    * @return  Returns the surface brightness
    *
    */
@@ -99,11 +110,317 @@ namespace Isis {
                            double deminc, double demema, double dn,
                            double &albedo, double &mult, double &base) {
 
+    if (!p_lutExact.empty() && deminc == inc && demema == ema &&
+        LookupAlbedo(pha, inc, ema, dn, albedo, mult, base)) {
+      return;
+    }
+
     // Calculate the surface brightness
     p_phtNmodel->CalcNrmAlbedo(pha, inc, ema, deminc, demema, dn, albedo, mult, base);
     return;
   }
 
+
+  /**
+   * Tabulate the normalization over a grid of phase, incidence and emission
+   * angles so that Compute() can look up the surface brightness instead of
+   * evaluating the photometric models for every pixel.
+   *
+   * For normalizations that are linear in the DN, each node of the grid holds
+   * the albedo for a DN of zero and its change for a DN of one. Models that are
+   * not linear in the DN, such as AlbedoAtm, instead tabulate the terms that
+   * depend only on the angles (see NormModel::CalcGeometryTerms), and the
+   * albedo is computed from the interpolated terms with the model's closed
+   * form for the DN of every pixel, so no DN is ever interpolated. Models that
+   * are neither, such as MoonAlbedo, are refused.
+   *
+   * Once the nodes are computed, the trilinear interpolation at the center of
+   * every cell is checked against the exact albedo for DNs of 0.5 and 1.0, and
+   * tabulated terms are checked against their exact values. Cells that miss
+   * the tolerance, or that have a corner the models could not compute, are
+   * flagged and pixels falling in them are computed exactly.
+   *
+   * The phase angle is tabulated from 0 to 180 degrees. Angles outside of the
+   * table are always computed exactly.
+   *
+   * @param spacing Largest spacing between the nodes in degrees
+   * @param maxIncidence Largest incidence angle in the table
+   * @param maxEmission Largest emission angle in the table
+   * @param tolerance Largest albedo and term error accepted at the cell centers
+   *
+   * @throws IException::User "The lookup table can not be used with the
+   *                           normalization model, which is not linear in the DN"
+   */
+  void Photometry::CreateLookupTable(double spacing, double maxIncidence,
+                                     double maxEmission, double tolerance) {
+    if (spacing <= 0.0) {
+      std::string msg = "The lookup table spacing [" + IString(spacing) +
+                        "] must be greater than zero";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    if (maxIncidence <= 0.0 || maxEmission <= 0.0) {
+      std::string msg = "The lookup table must cover incidence and emission angles "
+                        "greater than zero";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    p_lutLinear = p_phtNmodel->IsLinearInDn();
+    p_lutTermCount = p_lutLinear ? 2 : p_phtNmodel->GeometryTermCount();
+    if (p_lutTermCount <= 0) {
+      std::string msg = "The lookup table can not be used with the [" +
+                        p_phtNmodel->AlgorithmName() +
+                        "] normalization model, which is not linear in the DN and has no "
+                        "terms that depend only on the angles";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    if (p_lutTermCount > s_maxLutTerms) {
+      std::string msg = "The [" + p_phtNmodel->AlgorithmName() + "] normalization model has [" +
+                        IString(p_lutTermCount) + "] geometry terms, more than the lookup "
+                        "table can hold";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    double ranges[3] = {180.0, maxIncidence, maxEmission};
+    double nodes = 1.0;
+    for (int k = 0; k < 3; k++) {
+      nodes *= ceil(ranges[k] / spacing) + 1.0;
+    }
+    if (nodes > 50000000.0) {
+      std::string msg = "The lookup table spacing [" + IString(spacing) +
+                        "] is too small, the table would have more than 50000000 nodes";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    for (int k = 0; k < 3; k++) {
+      p_lutSize[k] = (int) ceil(ranges[k] / spacing) + 1;
+      p_lutStep[k] = ranges[k] / (p_lutSize[k] - 1);
+    }
+
+    // Compute the terms at every node
+    p_lutTerms.assign((int) nodes * p_lutTermCount, 0.0);
+    std::vector<char> valid((int) nodes, 0);
+    int node = 0;
+    for (int p = 0; p < p_lutSize[0]; p++) {
+      for (int i = 0; i < p_lutSize[1]; i++) {
+        for (int e = 0; e < p_lutSize[2]; e++, node++) {
+          valid[node] = ExactTerms(p * p_lutStep[0], i * p_lutStep[1], e * p_lutStep[2],
+                                   &p_lutTerms[node * p_lutTermCount]);
+        }
+      }
+    }
+
+    // Check the interpolation at the center of every cell
+    int cells = (p_lutSize[0] - 1) * (p_lutSize[1] - 1) * (p_lutSize[2] - 1);
+    p_lutExact.assign(cells, 1);
+    int cell = 0;
+    for (int p = 0; p < p_lutSize[0] - 1; p++) {
+      for (int i = 0; i < p_lutSize[1] - 1; i++) {
+        for (int e = 0; e < p_lutSize[2] - 1; e++, cell++) {
+          double terms[s_maxLutTerms] = {0.0};
+          bool corners = true;
+          for (int corner = 0; corner < 8 && corners; corner++) {
+            int index = ((p + (corner >> 2)) * p_lutSize[1] + i + ((corner >> 1) & 1)) *
+                        p_lutSize[2] + e + (corner & 1);
+            corners = valid[index];
+            for (int t = 0; t < p_lutTermCount; t++) {
+              terms[t] += p_lutTerms[index * p_lutTermCount + t] / 8.0;
+            }
+          }
+          if (!corners) {
+            continue;
+          }
+
+          double pha = (p + 0.5) * p_lutStep[0];
+          double inc = (i + 0.5) * p_lutStep[1];
+          double ema = (e + 0.5) * p_lutStep[2];
+          if (!p_lutLinear) {
+            double exactTerms[s_maxLutTerms];
+            if (!ExactTerms(pha, inc, ema, exactTerms)) {
+              continue;
+            }
+            bool termsAccurate = true;
+            for (int t = 0; t < p_lutTermCount; t++) {
+              termsAccurate = termsAccurate && fabs(terms[t] - exactTerms[t]) <= tolerance;
+            }
+            if (!termsAccurate) {
+              continue;
+            }
+          }
+
+          double half, one, halfLookup, oneLookup;
+          if (ExactAlbedo(pha, inc, ema, 0.5, half) && ExactAlbedo(pha, inc, ema, 1.0, one) &&
+              TermsAlbedo(inc, terms, 0.5, halfLookup) && TermsAlbedo(inc, terms, 1.0, oneLookup) &&
+              fabs(halfLookup - half) <= tolerance && fabs(oneLookup - one) <= tolerance) {
+            p_lutExact[cell] = 0;
+          }
+        }
+      }
+    }
+  }
+
+
+  //! Discard the lookup table so that every pixel is computed exactly
+  void Photometry::ClearLookupTable() {
+    p_lutTerms.clear();
+    p_lutExact.clear();
+  }
+
+
+  /**
+   * Returns whether a lookup table was created
+   *
+   * @return bool True if Compute() uses a lookup table
+   */
+  bool Photometry::HasLookupTable() const {
+    return !p_lutExact.empty();
+  }
+
+
+  /**
+   * Returns the number of cells in the lookup table
+   *
+   * @return int Number of cells
+   */
+  int Photometry::LookupTableCells() const {
+    return p_lutExact.size();
+  }
+
+
+  /**
+   * Returns the number of cells of the lookup table whose pixels are computed
+   * exactly because the interpolation missed the tolerance
+   *
+   * @return int Number of exactly computed cells
+   */
+  int Photometry::LookupTableExactCells() const {
+    return std::count(p_lutExact.begin(), p_lutExact.end(), 1);
+  }
+
+
+  /**
+   * Interpolate the surface brightness from the lookup table
+   *
+   * @return bool False if the angles are outside of the table or fall in a
+   *              cell that must be computed exactly
+   */
+  bool Photometry::LookupAlbedo(double pha, double inc, double ema, double dn,
+                                double &albedo, double &mult, double &base) const {
+    double angles[3] = {pha, inc, ema};
+    int index[3];
+    double weight[3];
+    for (int k = 0; k < 3; k++) {
+      double position = angles[k] / p_lutStep[k];
+      if (!(position >= 0.0 && position <= p_lutSize[k] - 1)) {
+        return false;
+      }
+      index[k] = std::min((int) position, p_lutSize[k] - 2);
+      weight[k] = position - index[k];
+    }
+
+    int cell = (index[0] * (p_lutSize[1] - 1) + index[1]) * (p_lutSize[2] - 1) + index[2];
+    if (p_lutExact[cell]) {
+      return false;
+    }
+
+    double terms[s_maxLutTerms] = {0.0};
+    for (int corner = 0; corner < 8; corner++) {
+      int p = corner >> 2;
+      int i = (corner >> 1) & 1;
+      int e = corner & 1;
+      double w = (p ? weight[0] : 1.0 - weight[0]) *
+                 (i ? weight[1] : 1.0 - weight[1]) *
+                 (e ? weight[2] : 1.0 - weight[2]);
+      int node = ((index[0] + p) * p_lutSize[1] + index[1] + i) * p_lutSize[2] + index[2] + e;
+      for (int t = 0; t < p_lutTermCount; t++) {
+        terms[t] += w * p_lutTerms[node * p_lutTermCount + t];
+      }
+    }
+
+    if (p_lutLinear) {
+      mult = terms[0];
+      base = terms[1];
+      albedo = mult * dn + base;
+    }
+    else {
+      p_phtNmodel->CalcNrmAlbedoFromTerms(inc, terms, dn, albedo);
+    }
+    return true;
+  }
+
+
+  /**
+   * Compute the albedo of a table node or cell center with the models
+   *
+   * @return bool False if the models failed or returned a special pixel
+   */
+  bool Photometry::ExactAlbedo(double pha, double inc, double ema, double dn,
+                               double &albedo) {
+    double mult = 0.0;
+    double base = 0.0;
+    try {
+      p_phtNmodel->CalcNrmAlbedo(pha, inc, ema, inc, ema, dn, albedo, mult, base);
+    }
+    catch (IException &e) {
+      return false;
+    }
+    return std::isfinite(albedo) && !IsSpecial(albedo);
+  }
+
+
+  /**
+   * Compute the tabulated terms of a table node or cell center with the
+   * models. For linear normalizations they are the change in albedo per DN
+   * and the albedo for a DN of zero, otherwise they are the normalization
+   * model's geometry terms.
+   *
+   * @return bool False if the models failed or returned a special pixel
+   */
+  bool Photometry::ExactTerms(double pha, double inc, double ema, double *terms) {
+    if (p_lutLinear) {
+      double zero, one;
+      if (!ExactAlbedo(pha, inc, ema, 0.0, zero) || !ExactAlbedo(pha, inc, ema, 1.0, one)) {
+        return false;
+      }
+      terms[0] = one - zero;
+      terms[1] = zero;
+      return true;
+    }
+
+    try {
+      p_phtNmodel->CalcGeometryTerms(pha, inc, ema, terms);
+    }
+    catch (IException &e) {
+      return false;
+    }
+    for (int t = 0; t < p_lutTermCount; t++) {
+      if (!std::isfinite(terms[t]) || IsSpecial(terms[t])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+
+  /**
+   * Compute the albedo from tabulated or interpolated terms
+   *
+   * @return bool False if the model failed or returned a special pixel
+   */
+  bool Photometry::TermsAlbedo(double inc, const double *terms, double dn, double &albedo) {
+    if (p_lutLinear) {
+      albedo = terms[0] * dn + terms[1];
+      return true;
+    }
+
+    try {
+      p_phtNmodel->CalcNrmAlbedoFromTerms(inc, terms, dn, albedo);
+    }
+    catch (IException &e) {
+      return false;
+    }
+    return std::isfinite(albedo) && !IsSpecial(albedo);
+  }
+
   /**
    * GSL's the Brent-Dekker method (referred to here as Brent's method) combines an
    * interpolation strategy with the bisection algorithm. This produces a fast algorithm
@@ -45,6 +45,13 @@ namespace Isis {
                    double demema, double dn, double &albedo,
                    double &mult, double &base);
 
+      void CreateLookupTable(double spacing, double maxIncidence,
+                             double maxEmission, double tolerance);
+      void ClearLookupTable();
+      bool HasLookupTable() const;
+      int LookupTableCells() const;
+      int LookupTableExactCells() const;
+
       //! Set the wavelength
       virtual void SetPhotomWl(double wl);
 
@@ -78,6 +85,28 @@ namespace Isis {
       AtmosModel *p_phtAmodel;
       PhotoModel *p_phtPmodel;
       NormModel *p_phtNmodel;
+
+    private:
+      bool LookupAlbedo(double pha, double inc, double ema, double dn,
+                        double &albedo, double &mult, double &base) const;
+      bool ExactAlbedo(double pha, double inc, double ema, double dn,
+                       double &albedo);
+      bool ExactTerms(double pha, double inc, double ema, double *terms);
+      bool TermsAlbedo(double inc, const double *terms, double dn, double &albedo);
+
+      //! Largest number of terms a lookup table node can hold
+      static const int s_maxLutTerms = 8;
+
+      int p_lutSize[3];                 //!< Number of phase, incidence and emission nodes
+      double p_lutStep[3];              //!< Phase, incidence and emission node spacing in degrees
+      bool p_lutLinear;                 //!< Whether the nodes hold the linear coefficients
+      int p_lutTermCount;               //!< Number of terms at each node
+      /**
+       * The terms at each node: the change in albedo per DN and the albedo for a DN of zero
+       * for linear normalizations, otherwise the normalization model's geometry terms
+       */
+      std::vector<double> p_lutTerms;
+      std::vector<char> p_lutExact;     //!< Cells that must be computed exactly
   };
 };
 
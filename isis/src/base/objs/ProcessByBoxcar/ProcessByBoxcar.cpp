@@ -4,12 +4,20 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <algorithm>
+#include <vector>
+
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "BoxcarCachingAlgorithm.h"
 #include "BoxcarManager.h"
 #include "Buffer.h"
 #include "LineManager.h"
 #include "Process.h"
 #include "ProcessByBoxcar.h"
+#include "RankWindow.h"
 
 using namespace std;
 namespace Isis {
@@ -40,42 +48,7 @@ namespace Isis {
    * @throws Isis::IException::Programmer
    */
   void ProcessByBoxcar::StartProcess(void funct(Isis::Buffer &in, double &out)) {
-    // Error checks ... there must be one input and output
-    if(InputCubes.size() != 1) {
-      string m = "You must specify exactly one input cube";
-      throw IException(IException::Programmer, m, _FILEINFO_);
-    }
-    else if(OutputCubes.size() != 1) {
-      string m = "You must specify exactly one output cube";
-      throw IException(IException::Programmer, m, _FILEINFO_);
-    }
-
-    // The lines in the input and output must match
-    if(InputCubes[0]->lineCount() != OutputCubes[0]->lineCount()) {
-      string m = "The number of lines in the input and output cubes ";
-      m += "must match";
-      throw IException(IException::Programmer, m, _FILEINFO_);
-    }
-
-    // The samples in the input and output must match
-    if(InputCubes[0]->sampleCount() != OutputCubes[0]->sampleCount()) {
-      string m = "The number of samples in the input and output cubes ";
-      m += "must match";
-      throw IException(IException::Programmer, m, _FILEINFO_);
-    }
-
-    // The bands in the input and output must match
-    if(InputCubes[0]->bandCount() != OutputCubes[0]->bandCount()) {
-      string m = "The number of bands in the input and output cubes ";
-      m += "must match";
-      throw IException(IException::Programmer, m, _FILEINFO_);
-    }
-
-    //  Make sure the boxcar size has been set
-    if(!p_boxsizeSet) {
-      string m = "Use the SetBoxcarSize method to set the boxcar size";
-      throw IException(IException::Programmer, m, _FILEINFO_);
-    }
+    VerifyCubes();
 
     // Construct boxcar buffer and line buffer managers
     Isis::BoxcarManager box(*InputCubes[0], p_boxSamples, p_boxLines);
@@ -93,6 +66,8 @@ namespace Isis {
     for(line.begin(); !line.end(); line.next()) {
       for(int i = 0; i < line.size(); i++) {
         InputCubes[0]->read(box);
+        // Look a full line of boxcars ahead
+        InputCubes[0]->prefetch(box, line.size());
         funct(box, out);
         line[i] = out;
         box++;
@@ -103,6 +78,117 @@ namespace Isis {
 
   }
 
+  /**
+   * Starts the systematic processing of the input cube with a rank filter.
+   * Instead of a boxcar buffer, the processing function is given a RankWindow
+   * over the same p_boxSamples by p_boxLines boxcar, which holds the input
+   * values between validMinimum and validMaximum in order and slides along
+   * each line without sorting the boxcar at every pixel.
+   *
+   * The cube is read a chunk of lines at a time and the chunk is split into
+   * strips of lines that are filtered on the global thread pool, each with its
+   * own RankWindow, so the processing function must be safe to call from
+   * several threads at once. A chunk has a strip for each thread, but no more
+   * strips than fit in about four million pixels, or a single strip. The
+   * output lines are written in order, and the results do not depend on the
+   * number of threads.
+   *
+   * @param funct (Isis::RankWindow &window, double &out) Name of your
+   *              processing function
+   * @param validMinimum Smallest input value counted in the window
+   * @param validMaximum Largest input value counted in the window
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::StartProcess(void funct(Isis::RankWindow &window, double &out),
+                                     const double validMinimum, const double validMaximum) {
+    VerifyCubes();
+
+    Cube *inCube = InputCubes[0];
+    Cube *outCube = OutputCubes[0];
+    int samples = inCube->sampleCount();
+    int lines = inCube->lineCount();
+    int bands = inCube->bandCount();
+
+    // Lines of the boxcar above and below the pixel it is over
+    int above = (p_boxLines - 1) / 2;
+    int below = p_boxLines - 1 - above;
+
+    // A strip of lines for each thread, as long as the chunk stays under
+    // chunkPixels so that wide cubes on many threads do not hold too much
+    // of the cube in memory
+    const int stripLines = 32;
+    const int chunkPixels = 4 * 1024 * 1024;
+    int threads = std::max(QThreadPool::globalInstance()->maxThreadCount(), 1);
+    int chunkStrips = std::max(std::min(threads, chunkPixels / (stripLines * samples)), 1);
+    int chunkLines = stripLines * chunkStrips;
+
+    Isis::LineManager inLine(*inCube);
+    Isis::LineManager outLine(*outCube);
+    std::vector<double> data;
+    std::vector<double> results;
+
+    p_progress->SetMaximumSteps(lines * bands);
+    p_progress->CheckStatus();
+
+    for (int band = 1; band <= bands; band++) {
+      for (int first = 1; first <= lines; first += chunkLines) {
+        int last = std::min(first + chunkLines - 1, lines);
+        int firstRow = std::max(first - above, 1);
+        int lastRow = std::min(last + below, lines);
+
+        data.resize((size_t) (lastRow - firstRow + 1) * samples);
+        for (int row = firstRow; row <= lastRow; row++) {
+          inLine.SetLine(row, band);
+          inCube->read(inLine);
+          std::copy(inLine.DoubleBuffer(), inLine.DoubleBuffer() + samples,
+                    data.begin() + (size_t) (row - firstRow) * samples);
+        }
+        results.resize((size_t) (last - first + 1) * samples);
+
+        auto filterStrip = [&](int stripFirst) {
+          int stripLast = std::min(stripFirst + stripLines - 1, last);
+          int stripFirstRow = std::max(stripFirst - above, firstRow);
+          int stripLastRow = std::min(stripLast + below, lastRow);
+
+          RankWindow window(p_boxSamples, p_boxLines, validMinimum, validMaximum);
+          window.setStrip(&data[(size_t) (stripFirstRow - firstRow) * samples], samples,
+                          stripLastRow - stripFirstRow + 1, stripFirstRow);
+          for (int line = stripFirst; line <= stripLast; line++) {
+            double *out = &results[(size_t) (line - first) * samples];
+            window.moveTo(line);
+            for (int i = 0; i < samples; i++) {
+              if (i > 0) {
+                window.next();
+              }
+              funct(window, out[i]);
+            }
+          }
+        };
+
+        QVector<int> strips;
+        for (int stripFirst = first; stripFirst <= last; stripFirst += stripLines) {
+          strips.append(stripFirst);
+        }
+        if (strips.size() == 1) {
+          filterStrip(strips[0]);
+        }
+        else {
+          QtConcurrent::blockingMap(strips, filterStrip);
+        }
+
+        for (int line = first; line <= last; line++) {
+          outLine.SetLine(line, band);
+          std::copy(results.begin() + (size_t) (line - first) * samples,
+                    results.begin() + (size_t) (line - first + 1) * samples,
+                    outLine.DoubleBuffer());
+          outCube->write(outLine);
+          p_progress->CheckStatus();
+        }
+      }
+    }
+  }
+
   /**
    * End the boxcar processing sequence and cleans up by closing cubes, freeing
    * memory, etc.
@@ -126,4 +212,49 @@ namespace Isis {
     Isis::Process::Finalize();
 
   }
+
+  /**
+   * Checks that there is exactly one input and one output cube of the same
+   * size and that the boxcar size has been set
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::VerifyCubes() {
+    // Error checks ... there must be one input and output
+    if(InputCubes.size() != 1) {
+      string m = "You must specify exactly one input cube";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+    else if(OutputCubes.size() != 1) {
+      string m = "You must specify exactly one output cube";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    // The lines in the input and output must match
+    if(InputCubes[0]->lineCount() != OutputCubes[0]->lineCount()) {
+      string m = "The number of lines in the input and output cubes ";
+      m += "must match";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    // The samples in the input and output must match
+    if(InputCubes[0]->sampleCount() != OutputCubes[0]->sampleCount()) {
+      string m = "The number of samples in the input and output cubes ";
+      m += "must match";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    // The bands in the input and output must match
+    if(InputCubes[0]->bandCount() != OutputCubes[0]->bandCount()) {
+      string m = "The number of bands in the input and output cubes ";
+      m += "must match";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    //  Make sure the boxcar size has been set
+    if(!p_boxsizeSet) {
+      string m = "Use the SetBoxcarSize method to set the boxcar size";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+  }
 } // end namespace isis
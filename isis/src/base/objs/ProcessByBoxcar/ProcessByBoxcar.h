@@ -10,6 +10,8 @@ find files of those names at the top level of this repository. **/
 #include "Buffer.h"
 
 namespace Isis {
+  class RankWindow;
+
   /**
    * @brief Process cubes by boxcar
    *
@@ -43,6 +45,8 @@ namespace Isis {
       int p_boxSamples;  //!< Number of samples in boxcar
       int p_boxLines;    //!< Number of lines in boxcar
 
+      void VerifyCubes();
+
 
     public:
 
@@ -58,6 +62,8 @@ namespace Isis {
 
       using Isis::Process::StartProcess;  // make parent functions visable
       virtual void StartProcess(void funct(Isis::Buffer &in, double &out));
+      void StartProcess(void funct(Isis::RankWindow &window, double &out),
+                        const double validMinimum, const double validMaximum);
       void ProcessCube(void funct(Isis::Buffer &in, double &out)) {
         StartProcess(funct);
       }
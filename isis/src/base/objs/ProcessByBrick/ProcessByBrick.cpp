@@ -444,8 +444,10 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
     p_progress->CheckStatus();
 
     for (brick->begin(); !brick->end(); (*brick)++) {
-      if (haveInput)
+      if (haveInput) {
         cube->read(*brick);  // input only
+        cube->prefetch(*brick);
+      }
 
       funct(*brick);
 
@@ -484,8 +486,10 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
     p_progress->CheckStatus();
 
     for (brick->begin(); !brick->end(); (*brick)++) {
-      if (haveInput)
+      if (haveInput) {
         cube->read(*brick);  // input only
+        cube->prefetch(*brick);
+      }
 
       funct(*brick);
 
@@ -529,6 +533,7 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
 
     for (int i = 0; i < numBricks; i++) {
       InputCubes[0]->read(*ibrick);
+      InputCubes[0]->prefetch(*ibrick);
       funct(*ibrick, *obrick);
       OutputCubes[0]->write(*obrick);
       p_progress->CheckStatus();
@@ -569,6 +574,7 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
 
     for (int i = 0; i < numBricks; i++) {
       InputCubes[0]->read(*ibrick);
+      InputCubes[0]->prefetch(*ibrick);
       funct(*ibrick, *obrick);
       OutputCubes[0]->write(*obrick);
       p_progress->CheckStatus();
@@ -614,6 +620,7 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
       // Read the input buffers
       for(unsigned int i = 0; i < InputCubes.size(); i++) {
         InputCubes[i]->read(*ibufs[i]);
+        InputCubes[i]->prefetch(*imgrs[i]);
       }
 
       // Pass them to the application function
@@ -689,6 +696,7 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
       // Read the input buffers
       for(unsigned int i = 0; i < InputCubes.size(); i++) {
         InputCubes[i]->read(*ibufs[i]);
+        InputCubes[i]->prefetch(*imgrs[i]);
       }
 
       // Pass them to the application function
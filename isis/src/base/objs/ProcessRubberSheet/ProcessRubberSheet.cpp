@@ -8,15 +8,23 @@ find files of those names at the top level of this repository. **/
 #include <iomanip>
 #include <algorithm>
 
+#include <QAtomicInt>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
 #include <QVector>
+#include <QtConcurrentMap>
 
 #include "Affine.h"
 #include "BasisFunction.h"
 #include "BoxcarCachingAlgorithm.h"
 #include "Brick.h"
 #include "Interpolator.h"
+#include "IString.h"
 #include "LeastSquares.h"
 #include "Portal.h"
+#include "Preference.h"
 #include "ProcessRubberSheet.h"
 #include "TileManager.h"
 #include "Transform.h"
@@ -26,6 +34,47 @@ using namespace std;
 
 
 namespace Isis {
+  /**
+   * @brief The transform, interpolator, and buffers one thread uses.
+   *
+   * When the application's Transform can be cloned, output tiles and input patches are
+   * transformed on several threads at once. Each thread gets a worker with its own clone of the
+   * transform, its own interpolator and input portal, and its own quad tree maps.
+   *
+   * @internal
+   */
+  class ProcessRubberSheet::TransformWorker {
+    public:
+      /**
+       * Creates a worker that owns the given transform.
+       *
+       * @param workerTransform The transform clone this worker will use and delete.
+       * @param workerInterp The interpolator to copy.
+       * @param pixelType The pixel type of the input cube.
+       * @param quadSize The size of the output tiles.
+       */
+      TransformWorker(Transform *workerTransform, Interpolator &workerInterp,
+                      PixelType pixelType, long long quadSize) :
+          transform(workerTransform), interp(workerInterp),
+          iportal(workerInterp.Samples(), workerInterp.Lines(), pixelType,
+                  workerInterp.HotSample(), workerInterp.HotLine()),
+          lineMap(quadSize, std::vector<double>(quadSize)),
+          sampMap(quadSize, std::vector<double>(quadSize)) {
+      }
+
+      //! Deletes the worker's transform.
+      ~TransformWorker() {
+        delete transform;
+      }
+
+      Transform *transform; //!< This worker's clone of the transform
+      Interpolator interp;  //!< This worker's interpolator
+      Portal iportal;       //!< The portal this worker reads the input cube with
+      std::vector< std::vector<double> > lineMap; //!< The input lines of the current tile
+      std::vector< std::vector<double> > sampMap; //!< The input samples of the current tile
+  };
+
+
   /**
    * Constructs a ProcessRubberSheet class with the default tile size range
    *
@@ -119,6 +168,11 @@ namespace Isis {
    * calling this method. Output pixels which come from outside the input cube
    * are set to NULL8.
    *
+   * If the RubberSheetTransforms Performance preference is Threaded, the
+   * Transform can be cloned and no band change function is registered,
+   * output tiles are transformed on the global thread pool, each thread with
+   * its own clone of the Transform. The tiles are still written in order.
+   *
    * @param trans A fully initialized Transform object. The Transform member of
    *              this object is used to calculate what input pixel location
    *              should be used to interpolate the output pixel value.
@@ -169,25 +223,32 @@ namespace Isis {
       InputCubes[0]->addCachingAlgorithm(new UniqueIOCachingAlgorithm(2 * InputCubes[0]->bandCount()));
       OutputCubes[0]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
 
-      long long int tilesPerBand = otile.Tiles() / OutputCubes[0]->bandCount();
+      QList< QSharedPointer<TransformWorker> > workers = createWorkers(trans, interp);
+
+      if (!workers.isEmpty()) {
+        processTilesInParallel(workers);
+      }
+      else {
+        long long int tilesPerBand = otile.Tiles() / OutputCubes[0]->bandCount();
 
-      for (long long int tile = 1; tile <= tilesPerBand; tile++) {
-        bool useLastTileMap = false;
-        for (int band = 1; band <= OutputCubes[0]->bandCount(); band++) {
-          otile.SetTile(tile, band);
+        for (long long int tile = 1; tile <= tilesPerBand; tile++) {
+          bool useLastTileMap = false;
+          for (int band = 1; band <= OutputCubes[0]->bandCount(); band++) {
+            otile.SetTile(tile, band);
 
-          // If either image or quad sizes are small, skip to SlowGeom. 
-          if (p_startQuadSize <= 2 || min(OutputCubes[0]->lineCount(), OutputCubes[0]->sampleCount()) <= p_startQuadSize) {
-            SlowGeom(otile, iportal, trans, interp);
-          }
-          else {
-            QuadTree(otile, iportal, trans, interp, useLastTileMap);
-          }
+            // If either image or quad sizes are small, skip to SlowGeom. 
+            if (p_startQuadSize <= 2 || min(OutputCubes[0]->lineCount(), OutputCubes[0]->sampleCount()) <= p_startQuadSize) {
+              SlowGeom(otile, iportal, trans, interp);
+            }
+            else {
+              QuadTree(otile, iportal, trans, interp, useLastTileMap, p_lineMap, p_sampMap);
+            }
 
-          useLastTileMap = true;
+            useLastTileMap = true;
 
-          OutputCubes[0]->write(otile);
-          p_progress->CheckStatus();
+            OutputCubes[0]->write(otile);
+            p_progress->CheckStatus();
+          }
         }
       }
     }
@@ -206,7 +267,7 @@ namespace Isis {
           SlowGeom(otile, iportal, trans, interp);
         }
         else {
-          QuadTree(otile, iportal, trans, interp, false);
+          QuadTree(otile, iportal, trans, interp, false, p_lineMap, p_sampMap);
         }
 
         OutputCubes[0]->write(otile);
@@ -219,6 +280,131 @@ namespace Isis {
   }
 
 
+  /**
+   * Creates a worker for each thread of the global thread pool, each with its own clone of the
+   * transform. Workers are only created when the RubberSheetTransforms Performance preference
+   * is Threaded.
+   *
+   * @param trans The application's transform.
+   * @param interp The application's interpolator.
+   *
+   * @return @b QList<QSharedPointer<TransformWorker>> The workers, or an empty list if the
+   *                                                   transforms are serial, the transform
+   *                                                   cannot be cloned or there is only one
+   *                                                   thread.
+   */
+  QList< QSharedPointer<ProcessRubberSheet::TransformWorker> >
+      ProcessRubberSheet::createWorkers(Transform &trans, Interpolator &interp) {
+    QList< QSharedPointer<TransformWorker> > workers;
+
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if ( !performancePrefs.hasKeyword("RubberSheetTransforms") ) {
+      return workers;
+    }
+
+    IString transformsPerfOpt = performancePrefs["RubberSheetTransforms"][0];
+    if (transformsPerfOpt.DownCase() != "threaded") {
+      return workers;
+    }
+
+    int numThreads = QThreadPool::globalInstance()->maxThreadCount();
+    if (numThreads < 2) {
+      return workers;
+    }
+
+    for (int i = 0; i < numThreads; i++) {
+      Transform *clone = trans.clone();
+      if (!clone) {
+        workers.clear();
+        break;
+      }
+
+      workers.append(QSharedPointer<TransformWorker>(
+          new TransformWorker(clone, interp, InputCubes[0]->pixelType(), p_startQuadSize)));
+    }
+
+    return workers;
+  }
+
+
+  /**
+   * Transforms the output tiles on the global thread pool, one worker per thread. Tiles are
+   * transformed in batches. Every band of a tile is transformed by the same worker so the tile's
+   * map is reused like in the serial loop. Each batch is written in tile order on this thread.
+   *
+   * @param workers The workers to transform the tiles with.
+   */
+  void ProcessRubberSheet::processTilesInParallel(
+      QList< QSharedPointer<TransformWorker> > &workers) {
+    Cube *outputCube = OutputCubes[0];
+    int numBands = outputCube->bandCount();
+
+    TileManager otile(*outputCube, p_startQuadSize, p_startQuadSize);
+    long long int tilesPerBand = otile.Tiles() / numBands;
+    long long int batchSize = 4 * workers.size();
+
+    // If either image or quad sizes are small, skip to SlowGeom.
+    bool slowGeom = p_startQuadSize <= 2 ||
+                    min(outputCube->lineCount(), outputCube->sampleCount()) <= p_startQuadSize;
+
+    for (long long int batchStart = 1; batchStart <= tilesPerBand; batchStart += batchSize) {
+      int batchCount = (int) min(batchSize, tilesPerBand - batchStart + 1);
+
+      // The transformed data of every band of every tile in the batch
+      std::vector< std::vector<double> > batch(batchCount * numBands);
+      QAtomicInt nextTile(0);
+      QMap<int, IException> errors;
+      QMutex errorsMutex;
+
+      auto transformTiles = [&](QSharedPointer<TransformWorker> worker) {
+        TileManager workerTile(*outputCube, p_startQuadSize, p_startQuadSize);
+
+        int batchIndex;
+        while ( (batchIndex = nextTile.fetchAndAddOrdered(1)) < batchCount ) {
+          try {
+            for (int band = 1; band <= numBands; band++) {
+              workerTile.SetTile(batchStart + batchIndex, band);
+
+              if (slowGeom) {
+                SlowGeom(workerTile, worker->iportal, *worker->transform, worker->interp);
+              }
+              else {
+                QuadTree(workerTile, worker->iportal, *worker->transform, worker->interp,
+                         band > 1, worker->lineMap, worker->sampMap);
+              }
+
+              batch[batchIndex * numBands + band - 1].assign(
+                  workerTile.DoubleBuffer(), workerTile.DoubleBuffer() + workerTile.size());
+            }
+          }
+          catch (IException &e) {
+            QMutexLocker locker(&errorsMutex);
+            errors.insert(batchIndex, e);
+          }
+        }
+      };
+
+      QtConcurrent::blockingMap(workers, transformTiles);
+
+      if ( !errors.isEmpty() ) {
+        throw errors.first();
+      }
+
+      for (int batchIndex = 0; batchIndex < batchCount; batchIndex++) {
+        for (int band = 1; band <= numBands; band++) {
+          otile.SetTile(batchStart + batchIndex, band);
+
+          const std::vector<double> &tileData = batch[batchIndex * numBands + band - 1];
+          std::copy(tileData.begin(), tileData.end(), otile.DoubleBuffer());
+
+          outputCube->write(otile);
+          p_progress->CheckStatus();
+        }
+      }
+    }
+  }
+
+
   /**
    * Registers a function to be called when the current output cube band number
    * changes. This includes the first time. If and application does NOT need to
@@ -270,7 +456,9 @@ namespace Isis {
 
   void ProcessRubberSheet::QuadTree(TileManager &otile, Portal &iportal,
                                     Transform &trans, Interpolator &interp,
-                                    bool useLastTileMap) {
+                                    bool useLastTileMap,
+                                    std::vector< std::vector<double> > &lineMap,
+                                    std::vector< std::vector<double> > &sampMap) {
 
     // Initializations
     vector<Quad *> quadTree;
@@ -291,7 +479,7 @@ namespace Isis {
       // Loop and compute the input coordinates filling the maps
       // until the quad tree is empty
       while (quadTree.size() > 0) {
-        ProcessQuad(quadTree, trans, p_lineMap, p_sampMap);
+        ProcessQuad(quadTree, trans, lineMap, sampMap);
       }
     }
 
@@ -299,8 +487,8 @@ namespace Isis {
     int outputBand = otile.Band();
     for (int i = 0, line = 0; line < p_startQuadSize; line++) {
       for (int samp = 0; samp < p_startQuadSize; samp++, i++) {
-        double inputLine = p_lineMap[line][samp];
-        double inputSamp = p_sampMap[line][samp];
+        double inputLine = lineMap[line][samp];
+        double inputSamp = sampMap[line][samp];
         if (inputLine != NULL8) {
           iportal.SetPosition(inputSamp, inputLine, outputBand);
           InputCubes[0]->read(iportal);
@@ -774,6 +962,12 @@ namespace Isis {
  * (fractional). This input coordinate is then used in the interp object in
  * order to geometrically move input pixels to output pixels.
  *
+ * If the RubberSheetTransforms Performance preference is Threaded, the
+ * Transform can be cloned and no band change function is registered,
+ * patches are transformed on the global thread pool, each thread with its own
+ * clone of the Transform. The output of the patches is still written in the
+ * order the patches are visited, so overlapping patches give the same result.
+ *
  * @param trans A fully initialized Transform object. The Transform member of
  *              this object is used to calculate an output pixel location given
  *              an input pixel location.
@@ -837,6 +1031,15 @@ namespace Isis {
     // exception would be for PushFrameCameras which should increment lines by
     // twice the framelet height.
 
+    if (p_bandChangeFunct == NULL) {
+      QList< QSharedPointer<TransformWorker> > workers = createWorkers(trans, interp);
+
+      if (!workers.isEmpty()) {
+        processPatchesInParallel(workers);
+        return;
+      }
+    }
+
     for (int band=1; band <= InputCubes[0]->bandCount(); band++) {
       if (p_bandChangeFunct != NULL) p_bandChangeFunct(band);
       iportal.SetPosition(1,1,band);
@@ -847,9 +1050,95 @@ namespace Isis {
         for (int samp = m_patchStartSample;
               samp <= InputCubes[0]->sampleCount();
               samp += m_patchSampleIncrement, p_progress->CheckStatus()) {
-          transformPatch((double)samp, (double)(samp + m_patchSamples - 1),
-                         (double)line, (double)(line + m_patchLines - 1),
-                         iportal, trans, interp);
+          QList<Brick *> obricks;
+          try {
+            transformPatch((double)samp, (double)(samp + m_patchSamples - 1),
+                           (double)line, (double)(line + m_patchLines - 1),
+                           iportal, trans, interp, obricks);
+          }
+          catch (IException &e) {
+            qDeleteAll(obricks);
+            throw;
+          }
+          writePatchBricks(obricks);
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Transforms the input patches on the global thread pool, one worker per thread. The patches
+   * of each band are transformed in batches, and the output bricks of each batch are written on
+   * this thread in the order the serial loop visits the patches.
+   *
+   * @param workers The workers to transform the patches with.
+   */
+  void ProcessRubberSheet::processPatchesInParallel(
+      QList< QSharedPointer<TransformWorker> > &workers) {
+
+    // The starting sample and line of each patch of a band, in the order they are visited
+    QVector< QPair<int, int> > patches;
+    for (int line = m_patchStartLine; line <= InputCubes[0]->lineCount();
+          line += m_patchLineIncrement) {
+      for (int samp = m_patchStartSample; samp <= InputCubes[0]->sampleCount();
+            samp += m_patchSampleIncrement) {
+        patches.append(qMakePair(samp, line));
+      }
+    }
+
+    int batchSize = 64 * workers.size();
+
+    for (int band = 1; band <= InputCubes[0]->bandCount(); band++) {
+      foreach (QSharedPointer<TransformWorker> worker, workers) {
+        worker->iportal.SetPosition(1, 1, band);
+      }
+
+      for (int batchStart = 0; batchStart < patches.size(); batchStart += batchSize) {
+        int batchCount = qMin(batchSize, patches.size() - batchStart);
+
+        // The output bricks of every patch in the batch
+        std::vector< QList<Brick *> > batch(batchCount);
+        QAtomicInt nextPatch(0);
+        QMap<int, IException> errors;
+        QMutex errorsMutex;
+
+        auto transformPatches = [&](QSharedPointer<TransformWorker> worker) {
+          int batchIndex;
+          while ( (batchIndex = nextPatch.fetchAndAddOrdered(1)) < batchCount ) {
+            int samp = patches[batchStart + batchIndex].first;
+            int line = patches[batchStart + batchIndex].second;
+
+            try {
+              transformPatch((double)samp, (double)(samp + m_patchSamples - 1),
+                             (double)line, (double)(line + m_patchLines - 1),
+                             worker->iportal, *worker->transform, worker->interp,
+                             batch[batchIndex]);
+            }
+            catch (IException &e) {
+              QMutexLocker locker(&errorsMutex);
+              errors.insert(batchIndex, e);
+            }
+          }
+        };
+
+        QtConcurrent::blockingMap(workers, transformPatches);
+
+        try {
+          if ( !errors.isEmpty() ) {
+            throw errors.first();
+          }
+
+          for (int batchIndex = 0; batchIndex < batchCount; batchIndex++) {
+            writePatchBricks(batch[batchIndex]);
+            p_progress->CheckStatus();
+          }
+        }
+        catch (IException &e) {
+          for (int batchIndex = 0; batchIndex < batchCount; batchIndex++) {
+            qDeleteAll(batch[batchIndex]);
+          }
+          throw;
         }
       }
     }
@@ -861,7 +1150,8 @@ namespace Isis {
                                           double sline, double eline,
                                           Portal &iportal,
                                           Transform &trans,
-                                          Interpolator &interp) {
+                                          Interpolator &interp,
+                                          QList<Brick *> &obricks) {
     // Let's make sure our patch is contained in the input file
     // TODO:  Think about the image edges should I be adding 0.5
     if (esamp > InputCubes[0]->sampleCount()) {
@@ -921,7 +1211,7 @@ namespace Isis {
 
     // If at least one of the 4 input tile corners did NOT transform, split it
     if (isamps.size() < 4) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
       return;
     }
 
@@ -964,11 +1254,11 @@ namespace Isis {
      */
 
     if (osampMax - osampMin + 1.0 > OutputCubes[0]->sampleCount() * 0.50) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
       return;
     }
     if (olineMax - olineMin + 1.0 > OutputCubes[0]->lineCount() * 0.50) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
       return;
     }
 
@@ -994,18 +1284,18 @@ namespace Isis {
       ilineLSQ.Solve(LeastSquares::QRD);
     }
     catch (IException &e) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
       return;
     }
 
     // If the fit at any corner isn't good enough break it down
     for (int i=0; i<isamps.size(); i++) {
       if (fabs(isampLSQ.Residual(i)) > 0.5) {
-        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
         return;
       }
       if (fabs(ilineLSQ.Residual(i)) > 0.5) {
-        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
         return;
       }
     }
@@ -1028,12 +1318,12 @@ namespace Isis {
       double err = (csamp - isamp) * (csamp - isamp) +
                    (cline - iline) * (cline - iline);
       if (err > 0.25) {
-        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
         return;
       }
     }
     else {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, obricks);
       return;
     }
 #endif
@@ -1049,11 +1339,11 @@ namespace Isis {
     // Now we can do our typical backwards geom. Loop over the output cube
     // coordinates and compute input cube coordinates for the corners of the current
     // buffer. The buffer is the same size as the current patch size.
-    Brick oBrick(*OutputCubes[0], osampMax-osampMin+1, olineMax-olineMin+1, 1);
-    oBrick.SetBasePosition(osampMin, olineMin, iportal.Band());
+    Brick *oBrick = new Brick(*OutputCubes[0], osampMax-osampMin+1, olineMax-olineMin+1, 1);
+    oBrick->SetBasePosition(osampMin, olineMin, iportal.Band());
+    obricks.append(oBrick);
 
     int brickIndex = 0;
-    bool foundNull = false;
     for (int oline = olineMin; oline <= olineMax; oline++) {
       double isamp = A * osampMin + B * oline + C;
       double iline = D * osampMin + E * oline + F;
@@ -1065,36 +1355,59 @@ namespace Isis {
         iportal.SetPosition(isamp, iline, iportal.Band());
         InputCubes[0]->read(iportal);
         double dn = interp.Interpolate(isamp, iline, iportal.DoubleBuffer());
-        oBrick[brickIndex] = dn;
-        if (dn == Null) foundNull = true;
+        (*oBrick)[brickIndex] = dn;
         brickIndex++;
       }
     }
+  }
 
-    // If there are any special pixel Null values in this output brick, we may be
-    // up against an edge of the input image where the interpolaters get Nulls from
-    // outside the image. Since the patches have some overlap due to finding the
-    // rectangular area (bounding box, min/max line/samp) of the four points input points
-    // projected into the output space, this causes valid DNs
-    // from a previously processed patch to be replaced with Null DNs from this patch.
-    // NOTE: A different method of accomplishing this fixing of Nulls was tested. We read
-    // the buffer from the output and tested each pixel values before overwriting it
-    // This resulted in a slighly slower run for the test. A concern was found in the
-    // asynchronous write of buffers to the cube, where a race condition may have generated
-    // different dns, not bad, but making testing more difficult.
-    if (foundNull) {
-      Brick readBrick(*OutputCubes[0], osampMax-osampMin+1, olineMax-olineMin+1, 1);
-      readBrick.SetBasePosition(osampMin, olineMin, iportal.Band());
-      OutputCubes[0]->read(readBrick);
-      for (brickIndex = 0; brickIndex<(osampMax-osampMin+1)*(olineMax-olineMin+1); brickIndex++) {
-        if (readBrick[brickIndex] != Null) {
-          oBrick[brickIndex] = readBrick[brickIndex];
+
+  // Private method to write the output bricks of a patch, in order, and delete them
+  void ProcessRubberSheet::writePatchBricks(QList<Brick *> &obricks) {
+    try {
+      foreach (Brick *oBrick, obricks) {
+        bool foundNull = false;
+        for (int brickIndex = 0; brickIndex < oBrick->size(); brickIndex++) {
+          if ((*oBrick)[brickIndex] == Null) {
+            foundNull = true;
+            break;
+          }
         }
+
+        // If there are any special pixel Null values in this output brick, we may be
+        // up against an edge of the input image where the interpolaters get Nulls from
+        // outside the image. Since the patches have some overlap due to finding the
+        // rectangular area (bounding box, min/max line/samp) of the four points input points
+        // projected into the output space, this causes valid DNs
+        // from a previously processed patch to be replaced with Null DNs from this patch.
+        // NOTE: A different method of accomplishing this fixing of Nulls was tested. We read
+        // the buffer from the output and tested each pixel values before overwriting it
+        // This resulted in a slighly slower run for the test. A concern was found in the
+        // asynchronous write of buffers to the cube, where a race condition may have generated
+        // different dns, not bad, but making testing more difficult.
+        if (foundNull) {
+          Brick readBrick(*OutputCubes[0], oBrick->SampleDimension(), oBrick->LineDimension(), 1);
+          readBrick.SetBasePosition(oBrick->Sample(), oBrick->Line(), oBrick->Band());
+          OutputCubes[0]->read(readBrick);
+          for (int brickIndex = 0; brickIndex < oBrick->size(); brickIndex++) {
+            if (readBrick[brickIndex] != Null) {
+              (*oBrick)[brickIndex] = readBrick[brickIndex];
+            }
+          }
+        }
+
+        // Write filled buffer to cube
+        OutputCubes[0]->write(*oBrick);
       }
     }
+    catch (IException &e) {
+      qDeleteAll(obricks);
+      obricks.clear();
+      throw;
+    }
 
-    // Write filled buffer to cube
-    OutputCubes[0]->write(oBrick);
+    qDeleteAll(obricks);
+    obricks.clear();
   }
 
 
@@ -1102,7 +1415,8 @@ namespace Isis {
   // process
   void ProcessRubberSheet::splitPatch(double ssamp, double esamp,
                                        double sline, double eline, Portal &iportal,
-                                       Transform &trans, Interpolator &interp) {
+                                       Transform &trans, Interpolator &interp,
+                                       QList<Brick *> &obricks) {
 
     // Is the input patch too small to even worry about transforming?
     if ((esamp - ssamp < 0.1) && (eline - sline < 0.1)) return;
@@ -1113,16 +1427,16 @@ namespace Isis {
 
     transformPatch(ssamp, midSamp,
                    sline, midLine,
-                   iportal, trans, interp);
+                   iportal, trans, interp, obricks);
     transformPatch(midSamp, esamp,
                    sline, midLine,
-                   iportal, trans, interp);
+                   iportal, trans, interp, obricks);
     transformPatch(ssamp, midSamp,
                    midLine, eline,
-                   iportal, trans, interp);
+                   iportal, trans, interp, obricks);
     transformPatch(midSamp, esamp,
                    midLine, eline,
-                   iportal, trans, interp);
+                   iportal, trans, interp, obricks);
 
     return;
   }
@@ -6,6 +6,9 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <QList>
+#include <QSharedPointer>
+
 #include "Process.h"
 #include "Buffer.h"
 #include "Transform.h"
@@ -175,7 +178,9 @@ namespace Isis {
                     Transform &trans, Interpolator &interp);
       void QuadTree(TileManager &otile, Portal &iportal,
                     Transform &trans, Interpolator &interp,
-                    bool useLastTileMap);
+                    bool useLastTileMap,
+                    std::vector< std::vector<double> > &lineMap,
+                    std::vector< std::vector<double> > &sampMap);
 
       bool TestLine(Transform &trans, int ssamp, int esamp, int sline,
                     int eline, int increment);
@@ -184,11 +189,21 @@ namespace Isis {
 
       void transformPatch (double startingSample, double endingSample,
                            double startingLine, double endingLine,
-                           Portal &iportal, Transform &trans, Interpolator &interp);
+                           Portal &iportal, Transform &trans, Interpolator &interp,
+                           QList<Brick *> &obricks);
 
       void splitPatch (double startingSample, double endingSample,
                        double startingLine, double endingLine,
-                       Portal &iportal, Transform &trans, Interpolator &interp);
+                       Portal &iportal, Transform &trans, Interpolator &interp,
+                       QList<Brick *> &obricks);
+
+      void writePatchBricks(QList<Brick *> &obricks);
+
+      class TransformWorker;
+      QList< QSharedPointer<TransformWorker> > createWorkers(Transform &trans,
+                                                             Interpolator &interp);
+      void processTilesInParallel(QList< QSharedPointer<TransformWorker> > &workers);
+      void processPatchesInParallel(QList< QSharedPointer<TransformWorker> > &workers);
 #if 0
       void transformPatch (double startingSample, double endingSample,
                            double startingLine, double endingLine);
@@ -0,0 +1,251 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "RankWindow.h"
+
+#include <algorithm>
+
+#include <QString>
+
+#include "IException.h"
+#include "SpecialPixel.h"
+
+namespace Isis {
+  /**
+   * Constructs a RankWindow
+   *
+   * @param boxSamples Number of samples in the boxcar
+   * @param boxLines Number of lines in the boxcar
+   * @param validMinimum Smallest value counted in the window
+   * @param validMaximum Largest value counted in the window
+   */
+  RankWindow::RankWindow(int boxSamples, int boxLines, double validMinimum,
+                         double validMaximum) {
+    if (boxSamples < 1 || boxLines < 1) {
+      QString msg = "The boxcar size [" + QString::number(boxSamples) + ", " +
+                    QString::number(boxLines) + "] must be at least one sample and line";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_boxSamples = boxSamples;
+    m_boxLines = boxLines;
+    m_sampleOffset = -((boxSamples - 1) / 2);
+    m_lineOffset = -((boxLines - 1) / 2);
+    m_centerSample = ((boxSamples * boxLines - 1) / 2) % boxSamples;
+    m_centerLine = ((boxSamples * boxLines - 1) / 2) / boxSamples;
+    m_validMinimum = validMinimum;
+    m_validMaximum = validMaximum;
+
+    m_data = NULL;
+    m_samples = 0;
+    m_lines = 0;
+    m_firstLine = 1;
+    m_treeStep = 0;
+    m_count = 0;
+    m_placed = false;
+    m_sample = 1;
+    m_line = 1;
+  }
+
+
+  //! Destroys the RankWindow
+  RankWindow::~RankWindow() {
+  }
+
+
+  /**
+   * Sets the strip of data the window slides over and ranks its valid values.
+   * The data is not copied and must outlive the use of the window. Lines of
+   * the boxcar outside of the strip are treated as Null, so the strip must
+   * hold every cube line the boxcars of the processed lines cover.
+   *
+   * @param data The pixels of the strip, one line after another
+   * @param samples Number of samples in each line
+   * @param lines Number of lines in the strip
+   * @param firstLine Cube line of the first line of the strip
+   */
+  void RankWindow::setStrip(const double *data, int samples, int lines, int firstLine) {
+    m_data = data;
+    m_samples = samples;
+    m_lines = lines;
+    m_firstLine = firstLine;
+
+    int size = samples * lines;
+    m_values.clear();
+    for (int i = 0; i < size; i++) {
+      if (!IsSpecial(data[i]) && data[i] >= m_validMinimum && data[i] <= m_validMaximum) {
+        m_values.push_back(data[i]);
+      }
+    }
+    std::sort(m_values.begin(), m_values.end());
+    m_values.erase(std::unique(m_values.begin(), m_values.end()), m_values.end());
+
+    m_ranks.resize(size);
+    for (int i = 0; i < size; i++) {
+      if (!IsSpecial(data[i]) && data[i] >= m_validMinimum && data[i] <= m_validMaximum) {
+        m_ranks[i] = std::lower_bound(m_values.begin(), m_values.end(), data[i]) -
+                     m_values.begin();
+      }
+      else {
+        m_ranks[i] = -1;
+      }
+    }
+
+    m_treeStep = 1;
+    while (m_treeStep * 2 <= (int) m_values.size()) {
+      m_treeStep *= 2;
+    }
+
+    m_tree.assign(m_values.size() + 1, 0);
+    m_count = 0;
+    m_placed = false;
+  }
+
+
+  /**
+   * Places the window over the first sample of a cube line. The columns the
+   * window covers are removed from the histogram, rather than clearing the
+   * whole tree, so moving costs the same as boxSamples calls to next().
+   *
+   * @param line The cube line
+   */
+  void RankWindow::moveTo(int line) {
+    if (m_placed) {
+      for (int s = 0; s < m_boxSamples; s++) {
+        addColumn(m_sample + m_sampleOffset + s, -1);
+      }
+    }
+
+    m_line = line;
+    m_sample = 1;
+    for (int s = 0; s < m_boxSamples; s++) {
+      addColumn(m_sample + m_sampleOffset + s, 1);
+    }
+    m_placed = true;
+  }
+
+
+  //! Moves the window to the next sample of the line
+  void RankWindow::next() {
+    addColumn(m_sample + m_sampleOffset, -1);
+    m_sample++;
+    addColumn(m_sample + m_sampleOffset + m_boxSamples - 1, 1);
+  }
+
+
+  /**
+   * Returns the cube sample the window is over
+   *
+   * @return int The sample
+   */
+  int RankWindow::sample() const {
+    return m_sample;
+  }
+
+
+  /**
+   * Returns the cube line the window is over
+   *
+   * @return int The line
+   */
+  int RankWindow::line() const {
+    return m_line;
+  }
+
+
+  /**
+   * Returns the number of valid pixels in the window
+   *
+   * @return int Number of pixels
+   */
+  int RankWindow::count() const {
+    return m_count;
+  }
+
+
+  /**
+   * Returns a valid pixel of the window by its rank
+   *
+   * @param rank Rank of the pixel, zero being the smallest value
+   *
+   * @return double The value of that rank
+   */
+  double RankWindow::value(int rank) const {
+    if (rank < 0 || rank >= m_count) {
+      QString msg = "The rank [" + QString::number(rank) + "] is outside of the [" +
+                    QString::number(m_count) + "] valid pixels in the window";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Descend the tree to the first value whose cumulative count exceeds rank
+    int position = 0;
+    int remaining = rank + 1;
+    int nodes = m_values.size();
+    for (int step = m_treeStep; step > 0; step /= 2) {
+      if (position + step <= nodes && m_tree[position + step] < remaining) {
+        position += step;
+        remaining -= m_tree[position];
+      }
+    }
+    return m_values[position];
+  }
+
+
+  /**
+   * Returns the median of the valid pixels in the window, which is the lower
+   * of the two middle values when the count is even
+   *
+   * @return double The median, or Null if the window has no valid pixels
+   */
+  double RankWindow::median() const {
+    if (m_count == 0) {
+      return Null;
+    }
+    return value((m_count - 1) / 2);
+  }
+
+
+  /**
+   * Returns the center pixel of the window
+   *
+   * @return double The center pixel, Null if it is outside of the strip
+   */
+  double RankWindow::center() const {
+    int sample = m_sample + m_sampleOffset + m_centerSample;
+    int row = m_line + m_lineOffset + m_centerLine - m_firstLine;
+    if (sample < 1 || sample > m_samples || row < 0 || row >= m_lines) {
+      return Null;
+    }
+    return m_data[row * m_samples + sample - 1];
+  }
+
+
+  /**
+   * Adds or removes a column of the boxcar in the histogram
+   *
+   * @param sample Cube sample of the column
+   * @param delta 1 to add the column, -1 to remove it
+   */
+  void RankWindow::addColumn(int sample, int delta) {
+    if (sample < 1 || sample > m_samples) {
+      return;
+    }
+
+    int firstRow = std::max(m_line + m_lineOffset - m_firstLine, 0);
+    int lastRow = std::min(m_line + m_lineOffset + m_boxLines - 1 - m_firstLine, m_lines - 1);
+    int nodes = m_values.size();
+    for (int row = firstRow; row <= lastRow; row++) {
+      int rank = m_ranks[row * m_samples + sample - 1];
+      if (rank < 0) {
+        continue;
+      }
+      for (int node = rank + 1; node <= nodes; node += node & -node) {
+        m_tree[node] += delta;
+      }
+      m_count += delta;
+    }
+  }
+}
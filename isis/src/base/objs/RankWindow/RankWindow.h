@@ -0,0 +1,84 @@
+#ifndef RankWindow_h
+#define RankWindow_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <vector>
+
+namespace Isis {
+  /**
+   * @brief Sliding boxcar over the valid pixels of a strip of lines
+   *
+   * A RankWindow answers rank queries (the number of valid pixels, the median
+   * or the value of any rank) for a boxcar that slides along the lines of a
+   * strip of cube data, without sorting the boxcar at every pixel. The valid
+   * values of the strip are sorted once and replaced by their ranks, and the
+   * window keeps a histogram of the ranks it covers in a binary indexed tree.
+   * Moving the window one sample removes the column leaving it and adds the
+   * column entering it, and the value of a rank is found by descending the
+   * tree, so each pixel costs O(boxLines log n) instead of sorting all
+   * boxSamples * boxLines values of the boxcar.
+   *
+   * Special pixels and values outside of the valid range never enter the
+   * histogram, and neither do pixels of the boxcar outside of the strip. The
+   * boxcar is placed over a pixel the same way a BoxcarManager places it, and
+   * center() is the pixel in[(in.size() - 1) / 2] of the equivalent boxcar
+   * buffer, so filters written for ProcessByBoxcar give the same results.
+   *
+   * @ingroup Math
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class RankWindow {
+    public:
+      RankWindow(int boxSamples, int boxLines, double validMinimum, double validMaximum);
+      ~RankWindow();
+
+      void setStrip(const double *data, int samples, int lines, int firstLine);
+
+      void moveTo(int line);
+      void next();
+
+      int sample() const;
+      int line() const;
+
+      int count() const;
+      double value(int rank) const;
+      double median() const;
+      double center() const;
+
+    private:
+      void addColumn(int sample, int delta);
+
+      int m_boxSamples;               //!< Number of samples in the boxcar.
+      int m_boxLines;                 //!< Number of lines in the boxcar.
+      int m_sampleOffset;             //!< Offset from a pixel to the first sample of its boxcar.
+      int m_lineOffset;               //!< Offset from a pixel to the first line of its boxcar.
+      int m_centerSample;             //!< Boxcar sample of the center pixel, from zero.
+      int m_centerLine;               //!< Boxcar line of the center pixel, from zero.
+      double m_validMinimum;          //!< Smallest value that enters the histogram.
+      double m_validMaximum;          //!< Largest value that enters the histogram.
+
+      const double *m_data;           //!< The strip of cube data, one line after another.
+      int m_samples;                  //!< Number of samples in the strip.
+      int m_lines;                    //!< Number of lines in the strip.
+      int m_firstLine;                //!< Cube line of the first line of the strip.
+
+      std::vector<int> m_ranks;       //!< Rank of each pixel of the strip, or -1 if it is not valid.
+      std::vector<double> m_values;   //!< The distinct valid values of the strip in order.
+      std::vector<int> m_tree;        //!< Binary indexed tree of the ranks in the window.
+      int m_treeStep;                 //!< Largest power of two not above the number of values.
+      int m_count;                    //!< Number of valid pixels in the window.
+      bool m_placed;                  //!< Whether the window has been moved over a line.
+      int m_sample;                   //!< Cube sample the window is over.
+      int m_line;                     //!< Cube line the window is over.
+  };
+}
+
+#endif
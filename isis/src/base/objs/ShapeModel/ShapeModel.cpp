@@ -24,7 +24,6 @@ find files of those names at the top level of this repository. **/
 #include "SurfacePoint.h"
 #include "IException.h"
 #include "IString.h"
-#include "NaifStatus.h"
 #include "Spice.h"
 #include "Target.h"
 
@@ -136,6 +135,43 @@ namespace Isis {
     return (true);
   }
 
+
+  /**
+   * Intersects many rays with the shape model at once, such as the look
+   * directions of a whole image line. The intersections are returned instead
+   * of being saved in the shape model, which is left without an intersection.
+   *
+   * This implementation intersects the rays one at a time. Shape models that
+   * can trace rays in batches override it.
+   *
+   * @param observerPositions The body-fixed origin of each ray in kilometers
+   * @param lookDirections The body-fixed direction of each ray
+   *
+   * @return std::vector<SurfacePoint> The intersection of each ray. Rays that
+   *                                   miss the shape model get an invalid
+   *                                   SurfacePoint.
+   */
+  std::vector<SurfacePoint> ShapeModel::intersectSurfaces(
+      const std::vector< std::vector<double> > &observerPositions,
+      const std::vector< std::vector<double> > &lookDirections) {
+    if (observerPositions.size() != lookDirections.size()) {
+      QString msg = "Cannot intersect rays with [" + toString((int)observerPositions.size()) +
+                    "] observer positions and [" + toString((int)lookDirections.size()) +
+                    "] look directions";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    std::vector<SurfacePoint> intersections(observerPositions.size());
+    for (size_t i = 0; i < observerPositions.size(); i++) {
+      if (intersectSurface(observerPositions[i], lookDirections[i])) {
+        intersections[i] = *surfaceIntersection();
+      }
+    }
+
+    clearSurfacePoint();
+    return intersections;
+  }
+
   /**
    *  Calculates the ellipsoidal surface normal.
    */
@@ -288,12 +324,10 @@ namespace Isis {
 
     // check if observer look vector intersects the target
     SpiceDouble intersectionPoint[3];
-    SpiceBoolean intersected = false;
+    bool intersected = false;
 
-    NaifStatus::CheckErrors();
-    surfpt_c((SpiceDouble *) &observerBodyFixedPosition[0], lookB, a, b, c,
-             intersectionPoint, &intersected);
-    NaifStatus::CheckErrors();
+    intersected = ellipsoidIntercept(&observerBodyFixedPosition[0], lookB, a, b, c,
+                                     intersectionPoint);
 
     if (intersected) {
       m_surfacePoint->FromNaifArray(intersectionPoint);
@@ -308,6 +342,131 @@ namespace Isis {
   }
 
 
+  /**
+   * Intersects a ray with an ellipsoid. This gives the same intercept as the
+   * NAIF routine surfpt_c, but does not touch the NAIF error state, so it can
+   * be called from several threads at once.
+   *
+   * The ray and the ellipsoid are scaled so the ellipsoid becomes the unit
+   * sphere. The intercept is then found from the part of the observer position
+   * that is perpendicular to the ray. If the observer is inside the ellipsoid,
+   * the intercept is where the ray leaves it.
+   *
+   * @param observer The observer position in the body-fixed frame, in km
+   * @param look The look direction in the body-fixed frame
+   * @param a The x radius of the ellipsoid in km
+   * @param b The y radius of the ellipsoid in km
+   * @param c The z radius of the ellipsoid in km
+   * @param intercept The intercept in the body-fixed frame, in km. It is not
+   *                  changed if the ray misses the ellipsoid.
+   *
+   * @throws IException::Programmer "The radii of the ellipsoid must be positive."
+   * @throws IException::Programmer "The look direction must not be the zero vector."
+   *
+   * @return @b bool Indicates whether the ray intersects the ellipsoid.
+   */
+  bool ShapeModel::ellipsoidIntercept(const double observer[3], const double look[3],
+                                      double a, double b, double c, double intercept[3]) {
+    if (a <= 0.0 || b <= 0.0 || c <= 0.0) {
+      QString msg = "The radii of the ellipsoid must be positive.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    double radii[3] = {a, b, c};
+    double position[3];
+    double direction[3];
+    double directionLength = 0.0;
+    double positionLengthSquared = 0.0;
+    for (int i = 0; i < 3; i++) {
+      position[i] = observer[i] / radii[i];
+      direction[i] = look[i] / radii[i];
+      directionLength += direction[i] * direction[i];
+      positionLengthSquared += position[i] * position[i];
+    }
+
+    directionLength = sqrt(directionLength);
+    if (directionLength == 0.0) {
+      QString msg = "The look direction must not be the zero vector.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    double along = 0.0;
+    for (int i = 0; i < 3; i++) {
+      direction[i] /= directionLength;
+      along += position[i] * direction[i];
+    }
+
+    // An observer outside the ellipsoid must look towards it
+    bool inside = positionLengthSquared <= 1.0;
+    if (!inside && along > 0.0) {
+      return false;
+    }
+
+    double perpendicular[3];
+    double perpendicularLengthSquared = 0.0;
+    for (int i = 0; i < 3; i++) {
+      perpendicular[i] = position[i] - along * direction[i];
+      perpendicularLengthSquared += perpendicular[i] * perpendicular[i];
+    }
+
+    if (perpendicularLengthSquared > 1.0) {
+      return false;
+    }
+
+    double halfChord = sqrt(1.0 - perpendicularLengthSquared);
+    if (!inside) {
+      halfChord = -halfChord;
+    }
+
+    for (int i = 0; i < 3; i++) {
+      intercept[i] = (perpendicular[i] + halfChord * direction[i]) * radii[i];
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Computes the outward unit normal of an ellipsoid at a point on its surface.
+   * This gives the same normal as the NAIF routine surfnm_c without touching the
+   * NAIF error state.
+   *
+   * @param a The x radius of the ellipsoid in km
+   * @param b The y radius of the ellipsoid in km
+   * @param c The z radius of the ellipsoid in km
+   * @param point The point on the surface in the body-fixed frame, in km
+   * @param normal The unit normal at the point
+   *
+   * @throws IException::Programmer "The radii of the ellipsoid must be positive."
+   */
+  void ShapeModel::ellipsoidNormal(double a, double b, double c, const double point[3],
+                                   double normal[3]) {
+    if (a <= 0.0 || b <= 0.0 || c <= 0.0) {
+      QString msg = "The radii of the ellipsoid must be positive.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Scale by the smallest radius so the squared ratios stay near one
+    double minRadius = std::min(a, std::min(b, c));
+    double radii[3] = {a / minRadius, b / minRadius, c / minRadius};
+
+    double length = 0.0;
+    for (int i = 0; i < 3; i++) {
+      normal[i] = point[i] / (radii[i] * radii[i]);
+      length += normal[i] * normal[i];
+    }
+
+    length = sqrt(length);
+    if (length == 0.0) {
+      return;
+    }
+
+    for (int i = 0; i < 3; i++) {
+      normal[i] /= length;
+    }
+  }
+
+
   /**
    * Computes and returns phase angle, in degrees, given the positions of the
    * observer and illuminator.
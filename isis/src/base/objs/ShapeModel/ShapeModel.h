@@ -62,6 +62,9 @@ namespace Isis {
    *                                       as the surface normal. This ensures that the currently
    *                                       stored m_normal is always the surface normal, and that 
    *                                       the local normal is always stored in m_localNormal.
+   *   @history 2026-10-16 Isis Development Team - Added ellipsoidIntercept() and
+   *                           ellipsoidNormal(), which replace surfpt_c and surfnm_c so
+   *                           intersecting the ellipsoid does not use the NAIF error state.
    */
   class ShapeModel {
     public:
@@ -90,6 +93,11 @@ namespace Isis {
                                     const std::vector<double> &observerPos,
                                     const bool &backCheck = true);
 
+      // Intersect many rays with the shape model
+      virtual std::vector<SurfacePoint> intersectSurfaces(
+          const std::vector< std::vector<double> > &observerPositions,
+          const std::vector< std::vector<double> > &lookDirections);
+
 
 
       // Return the surface intersection
@@ -174,6 +182,10 @@ namespace Isis {
       // Intersect ellipse
       bool intersectEllipsoid(const std::vector<double> observerPosRelativeToTarget,
                               const std::vector<double> &observerLookVectorToTarget);
+      static bool ellipsoidIntercept(const double observer[3], const double look[3],
+                                     double a, double b, double c, double intercept[3]);
+      static void ellipsoidNormal(double a, double b, double c, const double point[3],
+                                  double normal[3]);
       bool hasValidTarget() const;
       std::vector<Distance> targetRadii() const;
       void setHasNormal(bool status);
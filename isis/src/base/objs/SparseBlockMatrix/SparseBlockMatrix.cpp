@@ -7,13 +7,13 @@ find files of those names at the top level of this repository. **/
 #include "SparseBlockMatrix.h"
 
 // std lib
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
 // qt lib
 #include <QDataStream>
 #include <QDebug>
-#include <QMapIterator>
 #include <QListIterator>
 
 // boost lib
@@ -29,6 +29,129 @@ using namespace boost::numeric::ublas;
 
 namespace Isis {
 
+  /**
+   * Compares the index of a block against an index, for binary searches of the blocks.
+   *
+   * @param block The block to compare
+   * @param key The index to compare against
+   *
+   * @return @b bool True if the block comes before the index
+   */
+  static bool blockBefore(const SparseBlockMap::Block &block, int key) {
+    return block.first < key;
+  }
+
+
+  /**
+   * Finds the first block whose index is not less than an index.
+   *
+   * @param key The index to search for
+   *
+   * @return @b std::vector<Block>::iterator The first block at or after the index
+   */
+  std::vector<SparseBlockMap::Block>::iterator SparseBlockMap::lowerBound(int key) {
+    return std::lower_bound(m_blocks.begin(), m_blocks.end(), key, blockBefore);
+  }
+
+
+  /**
+   * Finds the first block whose index is not less than an index.
+   *
+   * @param key The index to search for
+   *
+   * @return @b std::vector<Block>::const_iterator The first block at or after the index
+   */
+  std::vector<SparseBlockMap::Block>::const_iterator SparseBlockMap::lowerBound(int key) const {
+    return std::lower_bound(m_blocks.begin(), m_blocks.end(), key, blockBefore);
+  }
+
+
+  /**
+   * Returns whether there is a block at an index.
+   *
+   * @param key The block index
+   *
+   * @return @b bool True if there is a block at the index
+   */
+  bool SparseBlockMap::contains(int key) const {
+    std::vector<Block>::const_iterator it = lowerBound(key);
+    return it != m_blocks.end() && it->first == key;
+  }
+
+
+  /**
+   * Returns the block at an index.
+   *
+   * @param key The block index
+   *
+   * @return @b LinearAlgebra::Matrix* The block, or NULL if there is no block at the index
+   */
+  LinearAlgebra::Matrix *SparseBlockMap::value(int key) const {
+    std::vector<Block>::const_iterator it = lowerBound(key);
+    if ( it == m_blocks.end() || it->first != key ) {
+      return NULL;
+    }
+    return it->second;
+  }
+
+
+  /**
+   * Returns a reference to the block at an index. Like QMap, a NULL block is inserted at the
+   * index if there is none.
+   *
+   * @param key The block index
+   *
+   * @return @b LinearAlgebra::Matrix*& The block at the index
+   */
+  LinearAlgebra::Matrix *&SparseBlockMap::operator[](int key) {
+    std::vector<Block>::iterator it = lowerBound(key);
+    if ( it == m_blocks.end() || it->first != key ) {
+      it = m_blocks.insert(it, Block(key, NULL));
+    }
+    return it->second;
+  }
+
+
+  /**
+   * Returns the block at an index.
+   *
+   * @param key The block index
+   *
+   * @return @b LinearAlgebra::Matrix* The block, or NULL if there is no block at the index
+   */
+  LinearAlgebra::Matrix *SparseBlockMap::operator[](int key) const {
+    return value(key);
+  }
+
+
+  /**
+   * Inserts a block at an index, replacing the block that was at the index. The replaced block
+   * is not deleted.
+   *
+   * @param key The block index
+   * @param block The block to insert
+   */
+  void SparseBlockMap::insert(int key, LinearAlgebra::Matrix *block) {
+    (*this)[key] = block;
+  }
+
+
+  /**
+   * Returns an iterator at the block at an index.
+   *
+   * @param key The block index
+   *
+   * @return @b const_iterator The block at the index, or end() if there is no block at the index
+   */
+  SparseBlockMap::const_iterator SparseBlockMap::find(int key) const {
+    std::vector<Block>::const_iterator it = lowerBound(key);
+    if ( it == m_blocks.end() || it->first != key ) {
+      return end();
+    }
+    return const_iterator(&(*it));
+  }
+
+
   /**
    * Default constructor.
    */
@@ -50,7 +173,7 @@ namespace Isis {
    *  fact, called by the ~SparseBlockColumnMatrix above.
    */
   void SparseBlockColumnMatrix::wipe() {
-    qDeleteAll(values());
+    qDeleteAll(*this);
     clear();
   }
 
@@ -75,7 +198,7 @@ namespace Isis {
     wipe();
 
     // copy matrix blocks from src
-    QMapIterator<int, LinearAlgebra::Matrix *> it(src);
+    SparseBlockMapIterator it(src);
     while ( it.hasNext() ) {
       it.next();
 
@@ -168,7 +291,7 @@ namespace Isis {
   int SparseBlockColumnMatrix::numberOfElements() {
     int nElements = 0;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -191,7 +314,7 @@ namespace Isis {
 
     int nColumns = 0;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -215,7 +338,7 @@ namespace Isis {
   int SparseBlockColumnMatrix::numberOfRows() {
 
     // iterate to last block (the diagonal one)
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -243,7 +366,7 @@ namespace Isis {
     }
 
     outstream << "Printing SparseBlockColumnMatrix..." << std::endl;
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -269,7 +392,7 @@ namespace Isis {
       return;
     }
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -297,7 +420,7 @@ namespace Isis {
    * Sets all elements of all matrix blocks to zero.
    */
   void SparseBlockColumnMatrix::zeroBlocks() {
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
       it.value()->clear();
@@ -316,7 +439,7 @@ namespace Isis {
     int nBlocks = sbcm.size();
     stream << (qint32)nBlocks;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(sbcm);
+    SparseBlockMapIterator it(sbcm);
     while ( it.hasNext() ) {
       it.next();
 
@@ -388,7 +511,7 @@ namespace Isis {
   QDebug operator<<(QDebug dbg, const SparseBlockColumnMatrix &sbcm) {
     dbg.space() << "New Block" << Qt::endl;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(sbcm);
+    SparseBlockMapIterator it(sbcm);
     while ( it.hasNext() ) {
       it.next();
 
@@ -435,7 +558,7 @@ namespace Isis {
    * fact, called by the ~SparseBlockColumnMatrix above.
    */
   void SparseBlockRowMatrix::wipe() {
-    qDeleteAll(values());
+    qDeleteAll(*this);
     clear();
   }
 
@@ -460,7 +583,7 @@ namespace Isis {
     wipe();
 
     // copy matrix blocks from src
-    QMapIterator<int, LinearAlgebra::Matrix *> it(src);
+    SparseBlockMapIterator it(src);
     while ( it.hasNext() ) {
       it.next();
 
@@ -530,7 +653,7 @@ namespace Isis {
   int SparseBlockRowMatrix::numberOfElements() {
     int nElements = 0;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -556,7 +679,7 @@ namespace Isis {
     }
 
     outstream << "Printing SparseBlockRowMatrix..." << std::endl;
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -581,7 +704,7 @@ namespace Isis {
       return;
     }
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -609,7 +732,7 @@ namespace Isis {
    * Sets all elements of all matrix blocks to zero.
    */
   void SparseBlockRowMatrix::zeroBlocks() {
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
       it.value()->clear();
@@ -630,7 +753,7 @@ namespace Isis {
     range rRow = range(0,3);
     range rCol;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(*this);
+    SparseBlockMapIterator it(*this);
     while ( it.hasNext() ) {
       it.next();
 
@@ -698,7 +821,7 @@ namespace Isis {
     int nBlocks = sbrm.size();
     stream << (qint32)nBlocks;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(sbrm);
+    SparseBlockMapIterator it(sbrm);
     while ( it.hasNext() ) {
       it.next();
 
@@ -770,7 +893,7 @@ namespace Isis {
   QDebug operator<<(QDebug dbg, const SparseBlockRowMatrix &sbrm) {
     dbg.space() << "New Block" << Qt::endl;
 
-    QMapIterator<int, LinearAlgebra::Matrix *> it(sbrm);
+    SparseBlockMapIterator it(sbrm);
     while ( it.hasNext() ) {
       it.next();
 
@@ -930,7 +1053,7 @@ namespace Isis {
       if ( !column )
         continue;
 
-      QMapIterator<int, LinearAlgebra::Matrix *> it(*column);
+      SparseBlockMapIterator it(*column);
       while ( it.hasNext() ) {
         it.next();
 
@@ -1099,7 +1222,7 @@ namespace Isis {
       if ( !column )
         continue;
 
-      QMapIterator<int, LinearAlgebra::Matrix *> it(*column);
+      SparseBlockMapIterator it(*column);
       // iterate to last element in column
       while ( it.hasNext() ) {
         it.next();
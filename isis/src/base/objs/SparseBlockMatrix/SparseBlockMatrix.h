@@ -10,9 +10,10 @@ find files of those names at the top level of this repository. **/
 
 // std library
 #include <iostream>
+#include <utility>
+#include <vector>
 
 // Qt library
-#include <QMap>
 #include <QList>
 
 // boost library
@@ -26,11 +27,127 @@ class QDebug;
 
 namespace Isis {
 
+  /**
+   * @brief SparseBlockMap
+   *
+   * A map from block indices to matrix blocks, kept as one array of (index, block) pairs sorted
+   * by index. It has the parts of the QMap interface the bundle adjustment uses. Looking up a
+   * block is a binary search and iterating over the blocks walks one contiguous array, instead
+   * of the tree nodes a QMap allocates for every block. A row or column of blocks holds few
+   * blocks and they are only inserted while the normal equations pattern is built, so
+   * inserting in the middle of the array is cheap.
+   *
+   * The blocks are not owned by the map.
+   *
+   * @ingroup Utility
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   *   @history 2026-10-16 Isis Development Team - Original version. Replaces the QMap that
+   *                           SparseBlockColumnMatrix and SparseBlockRowMatrix derived from.
+   */
+  class SparseBlockMap {
+    public:
+      //! An index and the matrix block at that index
+      typedef std::pair<int, LinearAlgebra::Matrix *> Block;
+
+      /**
+       * An iterator over the blocks of a SparseBlockMap, in index order. Like a QMap iterator,
+       *   key() is the block index and value() is the matrix block.
+       */
+      class const_iterator {
+        public:
+          const_iterator() : m_block(NULL) {}
+          explicit const_iterator(const Block *block) : m_block(block) {}
+
+          int key() const { return m_block->first; }
+          LinearAlgebra::Matrix *value() const { return m_block->second; }
+          LinearAlgebra::Matrix *operator*() const { return m_block->second; }
+
+          const_iterator &operator++() { ++m_block; return *this; }
+          const_iterator operator++(int) { const_iterator it = *this; ++m_block; return it; }
+          const_iterator &operator--() { --m_block; return *this; }
+          const_iterator operator--(int) { const_iterator it = *this; --m_block; return it; }
+
+          bool operator==(const const_iterator &other) const { return m_block == other.m_block; }
+          bool operator!=(const const_iterator &other) const { return m_block != other.m_block; }
+
+        private:
+          const Block *m_block; //!< The block the iterator is at
+      };
+      typedef const_iterator iterator;
+
+      int size() const { return (int)m_blocks.size(); }
+      bool isEmpty() const { return m_blocks.empty(); }
+      bool contains(int key) const;
+      LinearAlgebra::Matrix *value(int key) const;
+      LinearAlgebra::Matrix *&operator[](int key);
+      LinearAlgebra::Matrix *operator[](int key) const;
+      void insert(int key, LinearAlgebra::Matrix *block);
+      void clear() { m_blocks.clear(); }
+
+      const_iterator begin() const { return const_iterator(m_blocks.data()); }
+      const_iterator end() const { return const_iterator(m_blocks.data() + m_blocks.size()); }
+      const_iterator constBegin() const { return begin(); }
+      const_iterator constEnd() const { return end(); }
+      const_iterator find(int key) const;
+      const_iterator constFind(int key) const { return find(key); }
+
+    private:
+      std::vector<Block>::iterator lowerBound(int key);
+      std::vector<Block>::const_iterator lowerBound(int key) const;
+
+      std::vector<Block> m_blocks; //!< The blocks, sorted by index
+  };
+
+
+  /**
+   * @brief SparseBlockMapIterator
+   *
+   * A Java-style iterator over a SparseBlockMap, with the interface of QMapIterator. The map
+   *   must not have blocks inserted while it is iterated.
+   *
+   * @ingroup Utility
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   *   @history 2026-10-16 Isis Development Team - Original version.
+   */
+  class SparseBlockMapIterator {
+    public:
+      explicit SparseBlockMapIterator(const SparseBlockMap &map) :
+          m_begin(map.begin()), m_end(map.end()), m_current(map.begin()), m_last(map.end()) {}
+
+      bool hasNext() const { return m_current != m_end; }
+      SparseBlockMap::const_iterator next() { m_last = m_current++; return m_last; }
+      SparseBlockMap::const_iterator peekNext() const { return m_current; }
+      bool hasPrevious() const { return m_current != m_begin; }
+      SparseBlockMap::const_iterator previous() { m_last = --m_current; return m_last; }
+      SparseBlockMap::const_iterator peekPrevious() const {
+        SparseBlockMap::const_iterator it = m_current;
+        return --it;
+      }
+      void toFront() { m_current = m_begin; m_last = m_end; }
+      void toBack() { m_current = m_end; m_last = m_end; }
+
+      int key() const { return m_last.key(); }
+      LinearAlgebra::Matrix *value() const { return m_last.value(); }
+
+    private:
+      SparseBlockMap::const_iterator m_begin;   //!< The first block of the map
+      SparseBlockMap::const_iterator m_end;     //!< Past the last block of the map
+      SparseBlockMap::const_iterator m_current; //!< The position between blocks
+      SparseBlockMap::const_iterator m_last;    //!< The block last moved over
+  };
+
+
   /**
    * @brief SparseBlockColumnMatrix
    *
    * The SparseBlockMatrix class is a QList of SparseBlockColumnMatrix objects. Each
-   * SparseBlockColumnMatrix is a QMap of square matrix blocks and represents a column of square
+   * SparseBlockColumnMatrix is a SparseBlockMap of square matrix blocks and represents a column of square
    * matrix blocks in the reduced normal equations matrix. The key into each column map is the
    * block's row index. The value at each key is a square dense matrix (Boost matrix) with a
    * dimension equivalent to the number of exterior orientation parameters used for the image.
@@ -53,9 +170,9 @@ namespace Isis {
    *   @history 2017-05-09 Ken Edmundson - Added m_startColumn member and mutator/accessor methods
    *                           to SparseBlockColumnMatrix. Done to eliminate lengthy computation of
    *                           leading colums and rows. References #4664.
+   *   @history 2026-10-16 Isis Development Team - Derived from SparseBlockMap instead of QMap.
    */
-  class SparseBlockColumnMatrix :
-      public QMap< int, LinearAlgebra::Matrix * > {
+  class SparseBlockColumnMatrix : public SparseBlockMap {
 
   public:
     SparseBlockColumnMatrix();  // default constructor
@@ -97,7 +214,7 @@ namespace Isis {
   /**
    * @brief SparseBlockRowMatrix
    *
-   * A SparseBlockRowMatrix is a QMap of square matrix blocks and represents a row of square
+   * A SparseBlockRowMatrix is a SparseBlockMap of square matrix blocks and represents a row of square
    *  matrix blocks in the reduced normal equations matrix. The key into each row map is the
    *  block’s column index. The value at each key is a square dense matrix (Boost matrix) with a
    *  dimension equivalent to the number of exterior orientation parameters used for the image.
@@ -120,9 +237,9 @@ namespace Isis {
    *                           to write matrices to QDebug stream.
    *   @history 2015-12-18 Ken Edmundson - 1) added more detailed documentation; 2) brought closer
    *                           to ISIS coding standards.
+   *   @history 2026-10-16 Isis Development Team - Derived from SparseBlockMap instead of QMap.
    */
-  class SparseBlockRowMatrix :
-      public QMap< int, LinearAlgebra::Matrix  * > {
+  class SparseBlockRowMatrix : public SparseBlockMap {
 
   public:
     SparseBlockRowMatrix(){} // default constructor
@@ -164,7 +281,7 @@ namespace Isis {
    *  that can be efficiently populated in a random fashion and can be traversed by column in row
    *  order to subsequently construct the CCS matrix required by CHOLMOD. We use a type of Block
    *  Compressed Column Storage (BCCS) which consists of an array of map containers (QList of
-   *  SparseBlockColumnMatrices), each representing a column of square matrix blocks in the reduced
+   *  SparseBlockColumnMatrices, each an array of blocks sorted by row), each representing a column of square matrix blocks in the reduced
    *  normal equations. The key into each column map is the block’s row index.The value at each key
    *  is a square dense matrix (Boost matrix) with a dimension equivalent to the number of exterior
    *  orientation parameters used for the image. Zero blocks are not stored. The BCCS matrix is
@@ -1410,8 +1410,6 @@ namespace Isis {
    * @param et Ephemeris time
    */
   void Spice::computeSolarLongitude(iTime et) {
-    NaifStatus::CheckErrors();
-
     if (m_target->isSky()) {
       *m_solarLongitude = Longitude();
       return;
@@ -1454,7 +1452,6 @@ namespace Isis {
 
       *m_solarLongitude = Longitude(ls, Angle::Radians).force360Domain();
 
-      NaifStatus::CheckErrors();
       m_bodyRotation->SetEphemerisTime(og_time);
       m_sunPosition->SetEphemerisTime(og_time);
       return;
@@ -1462,6 +1459,8 @@ namespace Isis {
 
     if (m_bodyRotation->IsCached()) return;
 
+    NaifStatus::CheckErrors();
+
     double tipm[3][3], npole[3];
     char frameName[32];
     SpiceInt frameCode;
@@ -1638,4 +1637,43 @@ namespace Isis {
   bool Spice::isUsingAle(){
     return m_usingAle;
   }
+
+
+  /**
+   * Returns whether setting the time only reads cached SPICE. That is the case
+   * when the NAIF keywords come from the labels or the ISD, the body and instrument
+   * rotations interpolate Memcache tables, and the sun and instrument positions
+   * are cached. Setting the time then makes no NAIF calls that use the kernel
+   * pool or the NAIF error state, so different Spice objects like this can set
+   * their times from different threads at once.
+   *
+   * @return @b bool True if setting the time only reads the caches
+   */
+  bool Spice::isCachedWithoutNaif() const {
+    if (!m_bodyRotation || !m_instrumentRotation || !m_sunPosition || !m_instrumentPosition) {
+      return false;
+    }
+
+    return (!m_usingNaif || m_usingAle) &&
+           m_bodyRotation->GetSource() == SpiceRotation::Memcache &&
+           m_instrumentRotation->GetSource() == SpiceRotation::Memcache &&
+           m_sunPosition->IsCached() &&
+           m_instrumentPosition->IsCached();
+  }
+
+
+  /**
+   * Replaces the rotations and positions of this Spice with copies of the ones
+   * of another Spice for the same image. The copies share the cached tables of
+   * the other Spice instead of holding their own, and carry any changes made
+   * to it since it was created, such as updated pointing.
+   *
+   * @param spice The Spice to share the caches of
+   */
+  void Spice::shareCaches(const Spice &spice) {
+    *m_bodyRotation = *spice.m_bodyRotation;
+    *m_instrumentRotation = *spice.m_instrumentRotation;
+    *m_sunPosition = *spice.m_sunPosition;
+    *m_instrumentPosition = *spice.m_instrumentPosition;
+  }
 }
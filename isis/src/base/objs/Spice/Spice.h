@@ -279,6 +279,9 @@ namespace Isis {
    *  @history 2021-02-17 Kristin Berry, Jesse Mapel, and Stuart Sides - Made several methods virtual,
    *                           moved several member variables to protected, and added initialization
    *                           path for a sensor model without SPICE data.
+   *   @history 2026-10-16 Isis Development Team - Added isCachedWithoutNaif() and shareCaches()
+   *                           for cameras cloned for other threads. Computing the solar longitude
+   *                           from the tables no longer checks the NAIF error state.
    */
   class Spice {
     public:
@@ -327,6 +330,7 @@ namespace Isis {
       virtual SpiceRotation *instrumentRotation() const;
 
       bool isUsingAle();
+      bool isCachedWithoutNaif() const;
       bool hasKernels(Pvl &lab);
       bool isTimeSet();
 
@@ -361,6 +365,7 @@ namespace Isis {
                       QVariant value);
       QVariant readStoredValue(QString key, SpiceValueType type, int index);
       virtual void computeSolarLongitude(iTime et);
+      void shareCaches(const Spice &spice);
 
       // Leave these protected so that inheriting classes don't
       // have to convert between double and spicedouble
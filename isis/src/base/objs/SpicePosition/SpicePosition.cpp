@@ -111,7 +111,6 @@ namespace Isis {
 
     m_swapObserverTarget = swapObserverTarget;
     m_lt = 0.0;
-    m_state = NULL;
 
     // Determine observer/target ordering
     if ( m_swapObserverTarget ) {
@@ -247,8 +246,6 @@ namespace Isis {
    *                      to make software more readable.
    */
   const std::vector<double> &SpicePosition::SetEphemerisTime(double et) {
-    NaifStatus::CheckErrors();
-
     // Save the time
     if(et == p_et) {
       return p_coordinate;
@@ -270,11 +267,11 @@ namespace Isis {
       SetEphemerisTimePolyFunctionOverHermiteConstant();
     }
     else {  // Read from the kernel
+      NaifStatus::CheckErrors();
       SetEphemerisTimeSpice();
+      NaifStatus::CheckErrors();
     }
 
-    NaifStatus::CheckErrors();
-
     // Return the coordinate
     return p_coordinate;
   }
@@ -329,11 +326,7 @@ namespace Isis {
       stateCache.push_back(currentState);
     }
 
-    if (m_state != NULL) {
-      delete m_state;
-    }
-
-    m_state = new ale::States(p_cacheTime, stateCache);
+    m_state.reset(new ale::States(p_cacheTime, stateCache));
     p_source = Memcache;
   }
 
@@ -394,11 +387,7 @@ namespace Isis {
       }
     }
 
-    if (m_state != NULL) {
-      delete m_state;
-    }
-
-    m_state = new ale::States(p_cacheTime, stateCache);
+    m_state.reset(new ale::States(p_cacheTime, stateCache));
 
     p_source = Memcache;
     SetEphemerisTime(p_cacheTime[0]);
@@ -499,11 +488,7 @@ namespace Isis {
         stateCache.push_back(currentState);
         p_cacheTime.push_back((double)rec[inext]);
       }
-
-      if (m_state != NULL) {
-        delete m_state;
-      }
-      m_state = new ale::States(p_cacheTime, stateCache);
+      m_state.reset(new ale::States(p_cacheTime, stateCache));
     }
     else {
       // Coefficient table for postion coordinates x, y, and z
@@ -752,10 +737,7 @@ namespace Isis {
         SetEphemerisTime(p_cacheTime.at(pos));
         stateCache.push_back(ale::State(ale::Vec3d(p_coordinate), ale::Vec3d(p_velocity)));
       }
-      if (m_state != NULL) {
-        delete m_state;
-      }
-      m_state = new ale::States(p_cacheTime, stateCache);
+      m_state.reset(new ale::States(p_cacheTime, stateCache));
     }
     else {
     // Load the position for the single updated time instance
@@ -765,10 +747,7 @@ namespace Isis {
       stateCache.push_back(ale::Vec3d(p_coordinate));
       std::vector<double> timeCache;
       timeCache.push_back(p_cacheTime[0]);
-      if (m_state != NULL) {
-        delete m_state;
-      }
-      m_state = new ale::States(timeCache, stateCache);
+      m_state.reset(new ale::States(timeCache, stateCache));
     }
 
     // Set source to cache and reset current et
@@ -907,10 +886,7 @@ namespace Isis {
       p_velocity[2] = b3 + 2 * c3 * (p_cacheTime[i] - p_baseTime);
       stateCache.push_back(ale::State(p_coordinate, p_velocity));
     }
-    if (m_state != NULL) {
-      delete m_state;
-    }
-    m_state = new ale::States(p_cacheTime, stateCache);
+    m_state.reset(new ale::States(p_cacheTime, stateCache));
 
     p_source = HermiteCache;
     double et = p_et;
@@ -1470,9 +1446,7 @@ namespace Isis {
                        _FILEINFO_);
     }
 
-    ale::States *tempStates = new ale::States(m_state->minimizeCache(tolerance));
-    delete m_state;
-    m_state = tempStates;
+    m_state.reset(new ale::States(m_state->minimizeCache(tolerance)));
     p_cacheTime = m_state->getTimes();
     p_source = HermiteCache;
   }
@@ -1482,10 +1456,7 @@ namespace Isis {
    * Removes the entire cache from memory.
    */
   void SpicePosition::ClearCache() {
-    if (m_state) {
-      delete m_state;
-      m_state = NULL;
-    }
+    m_state.clear();
 
     p_cacheTime.clear();
   }
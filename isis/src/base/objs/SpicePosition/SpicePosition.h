@@ -9,6 +9,8 @@ find files of those names at the top level of this repository. **/
 #include <string>
 #include <vector>
 
+#include <QSharedPointer>
+
 #include <SpiceUsr.h>
 #include <SpiceZfc.h>
 #include <SpiceZmc.h>
@@ -172,6 +174,9 @@ namespace Isis {
    *                           under C++14. References #4809.
    *   @history 2018-06-22 Ken Edmundson - Added scaledTime() method to return current scaled time.
    *   @history 2020-07-01 Kristin Berry - Updated to use ale::States for internal state cache.
+   *   @history 2026-10-16 Isis Development Team - Assigning a SpicePosition now shares the cached
+   *                           states, which are replaced rather than changed. Setting the time
+   *                           from a cache no longer checks the NAIF error state.
    */
   class SpicePosition {
     public:
@@ -193,6 +198,8 @@ namespace Isis {
       //! Destructor
       virtual ~SpicePosition();
 
+      SpicePosition &operator=(const SpicePosition &position) = default;
+
       void SetTimeBias(double timeBias);
       double GetTimeBias() const;
 
@@ -240,7 +247,7 @@ namespace Isis {
 
       //! Is this position cached
       bool IsCached() const {
-        return (m_state != NULL);
+        return (!m_state.isNull());
       };
 
       //! Get the size of the current cached positions
@@ -356,7 +363,7 @@ namespace Isis {
       bool   m_swapObserverTarget;  ///!< Swap traditional order
       double m_lt;                 ///!<  Light time correction
 
-      ale::States *m_state; ///!< State: stores times, positions, velocities;
+      QSharedPointer<ale::States> m_state; ///!< State: stores times, positions, velocities;
   };
 };
 
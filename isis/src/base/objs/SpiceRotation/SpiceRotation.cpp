@@ -76,7 +76,6 @@ namespace Isis {
     p_fullCacheSize = 0;
     m_frameType = UNKNOWN;
     m_tOrientationAvailable = false;
-    m_orientation = NULL;
   }
 
 
@@ -116,7 +115,6 @@ namespace Isis {
     p_fullCacheSize = 0;
     m_frameType = DYN;
     m_tOrientationAvailable = false;
-    m_orientation = NULL;
 
     // Determine the axis for the velocity vector
     QString key = "INS" + toString(frameCode) + "_TRANSX";
@@ -184,13 +182,8 @@ namespace Isis {
     p_hasAngularVelocity = rotToCopy.p_hasAngularVelocity;
     m_frameType = rotToCopy.m_frameType;
 
-    if (rotToCopy.m_orientation) {
-      m_orientation = new ale::Orientations;
-      *m_orientation = *rotToCopy.m_orientation;
-    }
-    else {
-      m_orientation = NULL;
-    }
+    // The cache is never changed in place, so the copy shares it
+    m_orientation = rotToCopy.m_orientation;
   }
 
 
@@ -198,10 +191,6 @@ namespace Isis {
    * Destructor for SpiceRotation object.
    */
   SpiceRotation::~SpiceRotation() {
-    if (m_orientation) {
-      delete m_orientation;
-      m_orientation = NULL;
-    }
   }
 
 
@@ -314,7 +303,7 @@ namespace Isis {
    * @return @b bool Indicates whether this rotation is cached.
    */
   bool SpiceRotation::IsCached() const {
-    return (m_orientation != NULL);
+    return (!m_orientation.isNull());
   }
 
 
@@ -375,10 +364,7 @@ namespace Isis {
     p_fullCacheEndTime = endTime;
     p_fullCacheSize = size;
 
-    if (m_orientation != NULL) {
-      delete m_orientation;
-      m_orientation = NULL;
-    }
+    m_orientation.clear();
 
     // Make sure the constant frame is loaded.  This method also does the frame trace.
     if (p_timeFrames.size() == 0) InitConstantRotation(startTime);
@@ -407,12 +393,12 @@ namespace Isis {
     }
 
     if (p_TC.size() > 1) {
-      m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                            ale::Rotation(p_TC), p_constantFrames, p_timeFrames);
+      m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                ale::Rotation(p_TC), p_constantFrames, p_timeFrames));
     }
     else {
-      m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                            ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames);
+      m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames));
     }
 
     p_source = Memcache;
@@ -462,10 +448,7 @@ namespace Isis {
     p_hasAngularVelocity = false;
     m_frameType = CK;
 
-    if (m_orientation) {
-      delete m_orientation;
-      m_orientation = NULL;
-    }
+    m_orientation.clear();
 
     // Load the full cache time information from the label if available
     p_fullCacheStartTime = isdRot["ck_table_start_time"].get<double>();
@@ -494,14 +477,14 @@ namespace Isis {
     if (isdRot.contains("constant_frames")) {
       p_constantFrames = isdRot["constant_frames"].get<std::vector<int>>();
       p_TC = isdRot["constant_rotation"].get<std::vector<double>>();
-      m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                          ale::Rotation(p_TC), p_constantFrames, p_timeFrames);
+      m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                              ale::Rotation(p_TC), p_constantFrames, p_timeFrames));
     }
     else {
       p_TC.resize(9);
       ident_c((SpiceDouble( *)[3]) &p_TC[0]);
-      m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                          ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames);
+      m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                              ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames));
     }
 
 
@@ -542,10 +525,7 @@ namespace Isis {
 
     p_hasAngularVelocity = false;
 
-    if (m_orientation) {
-      delete m_orientation;
-      m_orientation = NULL;
-    }
+    m_orientation.clear();
 
     // Load the constant and time-based frame traces and the constant rotation
     if (table.Label().hasKeyword("TimeDependentFrames")) {
@@ -630,12 +610,12 @@ namespace Isis {
         p_cacheTime.push_back((double)rec[4]);
       }
       if (p_TC.size() > 1) {
-        m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                              ale::Rotation(p_TC), p_constantFrames, p_timeFrames);
+        m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                  ale::Rotation(p_TC), p_constantFrames, p_timeFrames));
       }
       else {
-        m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                              ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames);
+        m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                  ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames));
       }
       p_source = Memcache;
     }
@@ -670,12 +650,12 @@ namespace Isis {
       }
 
       if (p_TC.size() > 1) {
-        m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                              ale::Rotation(p_TC), p_constantFrames, p_timeFrames);
+        m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                  ale::Rotation(p_TC), p_constantFrames, p_timeFrames));
       }
       else {
-        m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                              ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames);
+        m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                  ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames));
       }
       p_source = Memcache;
     }
@@ -780,18 +760,15 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
-    if (m_orientation) {
-      delete m_orientation;
-      m_orientation = NULL;
-    }
+    m_orientation.clear();
 
     if (p_TC.size() > 1) {
-      m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                            ale::Rotation(p_TC), p_constantFrames, p_timeFrames);
+      m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                ale::Rotation(p_TC), p_constantFrames, p_timeFrames));
     }
     else {
-        m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                              ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames);
+        m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                  ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames));
     }
 
     // Set source to cache and reset current et
@@ -1323,19 +1300,16 @@ namespace Isis {
   void SpiceRotation::SetAngles(std::vector<double> angles, int axis3, int axis2, int axis1) {
     eul2m_c(angles[2], angles[1], angles[0], axis3, axis2, axis1, (SpiceDouble (*)[3]) &(p_CJ[0]));
 
-    if (m_orientation) {
-      delete m_orientation;
-      m_orientation = NULL;
-    }
+    m_orientation.clear();
     std::vector<ale::Rotation> rotationCache;
     rotationCache.push_back(ale::Rotation(p_CJ));
     if (p_TC.size() > 1) {
-      m_orientation = new ale::Orientations(rotationCache, p_cacheTime,  std::vector<ale::Vec3d>(),
-                                            ale::Rotation(p_TC), p_constantFrames, p_timeFrames);
+      m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime,  std::vector<ale::Vec3d>(),
+                                                ale::Rotation(p_TC), p_constantFrames, p_timeFrames));
     }
     else {
-      m_orientation = new ale::Orientations(rotationCache, p_cacheTime,  std::vector<ale::Vec3d>(),
-                                            ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames);
+      m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime,  std::vector<ale::Vec3d>(),
+                                                ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames));
     }
 
     // Reset to get the new values
@@ -1393,8 +1367,6 @@ namespace Isis {
    * @return vector<double>  A direction vector in J2000 frame.
    */
   std::vector<double> SpiceRotation::J2000Vector(const std::vector<double> &rVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> jVec;
     if (rVec.size() == 3) {
       double TJ[3][3];
@@ -1409,6 +1381,7 @@ namespace Isis {
       if (!p_hasAngularVelocity) {
         // throw an error
       }
+      NaifStatus::CheckErrors();
       std::vector<double> stateTJ(36);
       stateTJ = StateTJ();
 
@@ -1420,8 +1393,8 @@ namespace Isis {
       jVec.resize(6);
 
       mxvg_c(stateJT, (SpiceDouble *) &rVec[0], 6, 6, (SpiceDouble *) &jVec[0]);
+      NaifStatus::CheckErrors();
     }
-    NaifStatus::CheckErrors();
     return (jVec);
   }
 
@@ -1685,8 +1658,6 @@ namespace Isis {
    * @return @b vector<double> A direction vector in reference frame.
    */
   std::vector<double> SpiceRotation::ReferenceVector(const std::vector<double> &jVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> rVec(3);
 
     if (jVec.size() == 3) {
@@ -1701,13 +1672,14 @@ namespace Isis {
       if (!p_hasAngularVelocity) {
         // throw an error
       }
+      NaifStatus::CheckErrors();
       std::vector<double>  stateTJ(36);
       stateTJ = StateTJ();
       rVec.resize(6);
       mxvg_c((SpiceDouble *) &stateTJ[0], (SpiceDouble *) &jVec[0], 6, 6, (SpiceDouble *) &rVec[0]);
+      NaifStatus::CheckErrors();
     }
 
-    NaifStatus::CheckErrors();
     return (rVec);
   }
 
@@ -2519,10 +2491,7 @@ namespace Isis {
       std::vector<double> av;
       av.resize(3);
 
-      if (m_orientation) {
-        delete m_orientation;
-        m_orientation = NULL;
-      }
+      m_orientation.clear();
 
       std::vector<ale::Rotation> rotationCache;
       std::vector<ale::Vec3d> avCache;
@@ -2540,12 +2509,12 @@ namespace Isis {
       }
 
       if (p_TC.size() > 1 ) {
-        m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
-                                              ale::Rotation(p_TC), p_constantFrames, p_timeFrames);
+        m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime, avCache,
+                                                  ale::Rotation(p_TC), p_constantFrames, p_timeFrames));
       }
       else {
-        m_orientation = new ale::Orientations(rotationCache, p_cacheTime,  std::vector<ale::Vec3d>(),
-                                            ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames);
+        m_orientation.reset(new ale::Orientations(rotationCache, p_cacheTime,  std::vector<ale::Vec3d>(),
+                                                ale::Rotation(1,0,0,0), p_constantFrames, p_timeFrames));
       }
       timeLoaded = true;
       p_minimizeCache = Done;
@@ -2850,11 +2819,9 @@ namespace Isis {
    * @return @b vector<double> Returned matrix.
    */
   std::vector<double> SpiceRotation::Matrix() {
-    NaifStatus::CheckErrors();
     std::vector<double> TJ;
     TJ.resize(9);
     mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], (SpiceDouble( *) [3]) &TJ[0]);
-    NaifStatus::CheckErrors();
     return TJ;
   }
 
@@ -3254,7 +3221,6 @@ namespace Isis {
    */
   void SpiceRotation::setEphemerisTimeMemcache() {
    // If the cache has only one rotation, set it
-    NaifStatus::CheckErrors();
     if (p_cacheTime.size() == 1) {
       p_CJ = m_orientation->getRotations()[0].toRotationMatrix();
       if (p_hasAngularVelocity) {
@@ -3275,7 +3241,6 @@ namespace Isis {
         p_av[2] = av.z;
       }
     }
-    NaifStatus::CheckErrors();
   }
 
 
@@ -9,6 +9,8 @@ find files of those names at the top level of this repository. **/
 #include <string>
 #include <vector>
 
+#include <QSharedPointer>
+
 #include <nlohmann/json.hpp>
 #include <ale/Orientations.h>
 
@@ -200,6 +202,10 @@ namespace Isis {
    *                           The current example is the comet 67P/CHURYUMOV-GERASIMENKO
    *                           imaged by Rosetta. Some future comet/astroid missions are expected
    *                           to use a CK defined body fixed reference frame. Fixes #5408.
+   *   @history 2026-10-16 Isis Development Team - Copies now share the cached orientations, which
+   *                           are replaced rather than changed, and added an assignment operator.
+   *                           Reading the cache and rotating 3-vectors no longer check the NAIF
+   *                           error state, because they make no NAIF calls that can fail.
    *
    *  @todo Downsize using Hermite cubic spline and allow Nadir tables to be downsized again.
    *  @todo Consider making this a base class with child classes based on frame type or
@@ -218,6 +224,8 @@ namespace Isis {
       // Destructor
       virtual ~SpiceRotation();
 
+      SpiceRotation &operator=(const SpiceRotation &rotToCopy) = default;
+
       // Change the frame (has no effect if cached)
       void SetFrame(int frameCode);
       int Frame();
@@ -427,7 +435,8 @@ namespace Isis {
       int p_axis1;                      //!< Axis of rotation for angle 1 of rotation
       int p_axis2;                      //!< Axis of rotation for angle 2 of rotation
       int p_axis3;                      //!< Axis of rotation for angle 3 of rotation
-      ale::Orientations *m_orientation; //! Cached orientation information
+      //! Cached orientation information, shared with copies of this rotation
+      QSharedPointer<ale::Orientations> m_orientation;
 
     private:
       // method
@@ -12,8 +12,15 @@ find files of those names at the top level of this repository. **/
 #include <QUuid>
 #include <QXmlStreamWriter>
 
+#include <algorithm>
+#include <cmath>
+
 #include <float.h>
 
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include "IException.h"
 #include "IString.h"
 #include "Project.h"
@@ -55,6 +62,8 @@ namespace Isis {
   Statistics::Statistics(const Statistics &other)
     : m_sum(other.m_sum),
       m_sumsum(other.m_sumsum),
+      m_sumError(other.m_sumError),
+      m_sumsumError(other.m_sumsumError),
       m_minimum(other.m_minimum),
       m_maximum(other.m_maximum),
       m_validMinimum(other.m_validMinimum),
@@ -89,6 +98,8 @@ namespace Isis {
 
       m_sum = other.m_sum;
       m_sumsum = other.m_sumsum;
+      m_sumError = other.m_sumError;
+      m_sumsumError = other.m_sumsumError;
       m_minimum = other.m_minimum;
       m_maximum = other.m_maximum;
       m_validMinimum = other.m_validMinimum;
@@ -113,6 +124,8 @@ namespace Isis {
   void Statistics::Reset() {
     m_sum = 0.0;
     m_sumsum = 0.0;
+    m_sumError = 0.0;
+    m_sumsumError = 0.0;
     m_minimum = DBL_MAX;
     m_maximum = -DBL_MAX;
     m_totalPixels = 0;
@@ -139,9 +152,115 @@ namespace Isis {
    * @param count The number of elements in the incoming data to be added.
    */
   void Statistics::AddData(const double *data, const unsigned int count) {
-    for(unsigned int i = 0; i < count; i++) {
-      double value = data[i];
-      AddData(value);
+    // A value at or above VALID_MIN8 can not be a special pixel, so a value
+    //   in this range is always valid and the classification in
+    //   AddData(double) can be skipped. Everything else still goes through it.
+    const double validMinimum = std::max(m_validMinimum, Isis::VALID_MIN8);
+    const double validMaximum = m_validMaximum;
+
+    // The extremes of the valid values are gathered separately and merged in
+    //   at the end. The sums are always accumulated in order so that they are
+    //   identical to adding the values one at a time.
+    double minimum = DBL_MAX;
+    double maximum = -DBL_MAX;
+
+    auto addValue = [&](const double value) {
+      if (value >= validMinimum && value <= validMaximum) {
+        m_sum += value;
+        m_sumsum += value * value;
+        if (value < minimum) minimum = value;
+        if (value > maximum) maximum = value;
+        m_validPixels++;
+        m_totalPixels++;
+      }
+      else {
+        AddData(value);
+      }
+    };
+
+    unsigned int i = 0;
+
+#if defined(__AVX__)
+    const unsigned int blockSize = 4;
+    const __m256d lowLimit = _mm256_set1_pd(validMinimum);
+    const __m256d highLimit = _mm256_set1_pd(validMaximum);
+    __m256d blockMinimum = _mm256_set1_pd(DBL_MAX);
+    __m256d blockMaximum = _mm256_set1_pd(-DBL_MAX);
+
+    for (; i + blockSize <= count; i += blockSize) {
+      __m256d values = _mm256_loadu_pd(data + i);
+      __m256d valid = _mm256_and_pd(_mm256_cmp_pd(values, lowLimit, _CMP_GE_OQ),
+                                    _mm256_cmp_pd(values, highLimit, _CMP_LE_OQ));
+
+      if (_mm256_movemask_pd(valid) == 0xF) {
+        blockMinimum = _mm256_min_pd(blockMinimum, values);
+        blockMaximum = _mm256_max_pd(blockMaximum, values);
+        for (unsigned int j = i; j < i + blockSize; j++) {
+          m_sum += data[j];
+          m_sumsum += data[j] * data[j];
+        }
+        m_validPixels += blockSize;
+        m_totalPixels += blockSize;
+      }
+      else {
+        for (unsigned int j = i; j < i + blockSize; j++) {
+          addValue(data[j]);
+        }
+      }
+    }
+
+    double lanes[blockSize];
+    _mm256_storeu_pd(lanes, blockMinimum);
+    minimum = std::min(minimum, *std::min_element(lanes, lanes + blockSize));
+    _mm256_storeu_pd(lanes, blockMaximum);
+    maximum = std::max(maximum, *std::max_element(lanes, lanes + blockSize));
+#elif defined(__SSE2__)
+    const unsigned int blockSize = 2;
+    const __m128d lowLimit = _mm_set1_pd(validMinimum);
+    const __m128d highLimit = _mm_set1_pd(validMaximum);
+    __m128d blockMinimum = _mm_set1_pd(DBL_MAX);
+    __m128d blockMaximum = _mm_set1_pd(-DBL_MAX);
+
+    for (; i + blockSize <= count; i += blockSize) {
+      __m128d values = _mm_loadu_pd(data + i);
+      __m128d valid = _mm_and_pd(_mm_cmpge_pd(values, lowLimit),
+                                 _mm_cmple_pd(values, highLimit));
+
+      if (_mm_movemask_pd(valid) == 0x3) {
+        blockMinimum = _mm_min_pd(blockMinimum, values);
+        blockMaximum = _mm_max_pd(blockMaximum, values);
+        m_sum += data[i];
+        m_sumsum += data[i] * data[i];
+        m_sum += data[i + 1];
+        m_sumsum += data[i + 1] * data[i + 1];
+        m_validPixels += blockSize;
+        m_totalPixels += blockSize;
+      }
+      else {
+        addValue(data[i]);
+        addValue(data[i + 1]);
+      }
+    }
+
+    double lanes[blockSize];
+    _mm_storeu_pd(lanes, blockMinimum);
+    minimum = std::min(minimum, std::min(lanes[0], lanes[1]));
+    _mm_storeu_pd(lanes, blockMaximum);
+    maximum = std::max(maximum, std::max(lanes[0], lanes[1]));
+#endif
+
+    for (; i < count; i++) {
+      addValue(data[i]);
+    }
+
+    // Equal values are interchangeable, except that 0.0 and -0.0 compare
+    //   equal. AddData(double) keeps the first of equal extremes, so find the
+    //   first zero when a zero is the new extreme.
+    if (minimum < m_minimum) {
+      m_minimum = (minimum == 0.0) ? *std::find(data, data + count, 0.0) : minimum;
+    }
+    if (maximum > m_maximum) {
+      m_maximum = (maximum == 0.0) ? *std::find(data, data + count, 0.0) : maximum;
     }
   }
 
@@ -252,6 +371,63 @@ namespace Isis {
   }
 
 
+  /**
+   * Adds a value to a sum, keeping the rounding error of the addition in a
+   *   separate error term (Neumaier's compensated summation).
+   *
+   * @param sum The sum to add the value to
+   * @param error The accumulated rounding error of the sum
+   * @param value The value to add
+   */
+  static void addCompensated(double &sum, double &error, double value) {
+    double total = sum + value;
+    if (fabs(sum) >= fabs(value)) {
+      error += (sum - total) + value;
+    }
+    else {
+      error += (value - total) + sum;
+    }
+    sum = total;
+  }
+
+
+  /**
+   * Add everything that was added to another Statistics object to this one,
+   *   as if its data had been added here. This allows data to be gathered in
+   *   parts, for example on separate threads, and then combined. The sums of
+   *   the parts are added with compensated summation, so merging many parts
+   *   in a fixed order gives an accurate and reproducible result.
+   *
+   * @param other The statistics to combine with these statistics
+   *
+   * @throws IException::Programmer The valid ranges of the statistics differ
+   */
+  void Statistics::merge(const Statistics &other) {
+    if (m_validMinimum != other.m_validMinimum ||
+        m_validMaximum != other.m_validMaximum) {
+      QString msg = "Cannot merge statistics with different valid ranges";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    addCompensated(m_sum, m_sumError, other.m_sum);
+    addCompensated(m_sumsum, m_sumsumError, other.m_sumsum);
+    m_sumError += other.m_sumError;
+    m_sumsumError += other.m_sumsumError;
+    if (other.m_minimum < m_minimum) m_minimum = other.m_minimum;
+    if (other.m_maximum > m_maximum) m_maximum = other.m_maximum;
+    m_totalPixels += other.m_totalPixels;
+    m_validPixels += other.m_validPixels;
+    m_nullPixels += other.m_nullPixels;
+    m_lisPixels += other.m_lisPixels;
+    m_lrsPixels += other.m_lrsPixels;
+    m_hrsPixels += other.m_hrsPixels;
+    m_hisPixels += other.m_hisPixels;
+    m_overRangePixels += other.m_overRangePixels;
+    m_underRangePixels += other.m_underRangePixels;
+    m_removedData = m_removedData || other.m_removedData;
+  }
+
+
   void Statistics::SetValidRange(const double minimum, const double maximum) {
     m_validMinimum = minimum;
     m_validMaximum = maximum;
@@ -299,7 +475,7 @@ namespace Isis {
    */
   double Statistics::Average() const {
     if (m_validPixels < 1) return Isis::NULL8;
-    return m_sum / m_validPixels;
+    return Sum() / m_validPixels;
   }
 
 
@@ -327,7 +503,8 @@ namespace Isis {
    */
   double Statistics::Variance() const {
     if (m_validPixels <= 1) return Isis::NULL8;
-    double temp = m_validPixels * m_sumsum - m_sum * m_sum;
+    double sum = Sum();
+    double temp = m_validPixels * SumSquare() - sum * sum;
     if (temp < 0.0) temp = 0.0;  // This should happen unless roundoff occurs
     return temp / ((m_validPixels - 1.0) * m_validPixels);
   }
@@ -339,7 +516,7 @@ namespace Isis {
    * @return The sum of the data
    */
   double Statistics::Sum() const {
-    return m_sum;
+    return m_sum + m_sumError;
   }
 
 
@@ -349,7 +526,7 @@ namespace Isis {
    * @return The sum of the squared data
    */
   double Statistics::SumSquare() const {
-    return m_sumsum;
+    return m_sumsum + m_sumsumError;
   }
 
 
@@ -364,7 +541,7 @@ namespace Isis {
    */
   double Statistics::Rms() const {
     if (m_validPixels < 1) return Isis::NULL8;
-    double temp = m_sumsum / m_validPixels;
+    double temp = SumSquare() / m_validPixels;
     if (temp < 0.0) temp = 0.0;
     return sqrt(temp);
   }
@@ -728,8 +905,8 @@ namespace Isis {
     stream.writeStartElement("statistics");
 //    stream.writeTextElement("id", m_id->toString());
  
-    stream.writeTextElement("sum", toString(m_sum));
-    stream.writeTextElement("sumSquares", toString(m_sumsum));
+    stream.writeTextElement("sum", toString(Sum()));
+    stream.writeTextElement("sumSquares", toString(SumSquare()));
 
     stream.writeStartElement("range");
     stream.writeTextElement("minimum", toString(m_minimum));
@@ -855,8 +1032,8 @@ namespace Isis {
    */ 
   QDataStream &Statistics::write(QDataStream &stream) const {
     stream.setByteOrder(QDataStream::LittleEndian);
-    stream << m_sum
-           << m_sumsum
+    stream << Sum()
+           << SumSquare()
            << m_minimum
            << m_maximum
            << m_validMinimum
@@ -906,6 +1083,8 @@ namespace Isis {
 //    m_id = NULL;
 //    m_id = new QUuid(id);
 
+    m_sumError         = 0.0;
+    m_sumsumError      = 0.0;
     m_totalPixels      = (BigInt)totalPixels;
     m_validPixels      = (BigInt)validPixels;
     m_nullPixels       = (BigInt)nullPixels;
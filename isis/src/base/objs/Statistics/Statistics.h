@@ -85,6 +85,8 @@ namespace Isis {
    *                           Statistics serialization/unserialization. References #2282.
    *   @history 2017-04-20 Makayla Shepherd - Removed the hdf5 code because we are using XML for
    *                           serialization. Fixes #4795.
+   *   @history 2026-10-16 Isis Development Team - Added merge(), which adds the sums of the
+   *                           merged statistics with compensated summation.
    *
    *   @todo 2005-02-07 Deborah Lee Soltesz - add example using cube data to the class documentation
    *   @todo 2015-08-13 Jeannie Backer - Clean up header and implementation files once
@@ -110,6 +112,8 @@ namespace Isis {
       void RemoveData(const double *data, const unsigned int count);
       void RemoveData(const double data);
 
+      void merge(const Statistics &other);
+
       void SetValidRange(const double minimum = Isis::ValidMinimum,
                          const double maximum = Isis::ValidMaximum);
 
@@ -190,6 +194,9 @@ namespace Isis {
       double m_sum;              //!< The sum accumulator, i.e. the sum of added data values.
       double m_sumsum;           /**< The sum-squared accumulator, i.e. the sum of the squares
                                       of the  data values.*/
+      double m_sumError;         //!< Rounding error of m_sum from merging, added back by Sum()
+      double m_sumsumError;      /**< Rounding error of m_sumsum from merging, added back by
+                                      SumSquare()*/
       double m_minimum;          //!< Minimum double value encountered.
       double m_maximum;          //!< Maximum double value encountered.
       double m_validMinimum;     //!< Minimum valid pixel value
@@ -126,6 +126,23 @@ namespace Isis {
         return true;
       }
 
+      /**
+       * Creates a copy of this transform for another thread. The copy must
+       * give the same results as this transform and must not share any state
+       * that Xform changes. ProcessRubberSheet transforms on several threads
+       * at once, each with its own copy, when this returns a copy. Copies that
+       * make NAIF calls in Xform must hold NaifStatus::mutex()
+       * while doing so. Cameras for which Camera::evaluatesWithoutNaif() is
+       * true make none and can be evaluated without it.
+       *
+       * @return Transform* A new transform the caller takes ownership of, or
+       *                    NULL if this transform cannot be copied, which is
+       *                    the default.
+       */
+      virtual Transform *clone() const {
+        return NULL;
+      }
+
   };
 };
 
@@ -10,6 +10,16 @@ find files of those names at the top level of this repository. **/
 
 #include "Isis.h"
 
+#include <algorithm>
+#include <vector>
+
+#include <QAtomicInt>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
 #include "AutoReg.h"
 #include "AutoRegFactory.h"
 #include "Chip.h"
@@ -18,6 +28,7 @@ find files of those names at the top level of this repository. **/
 #include "ControlNet.h"
 #include "ControlPoint.h"
 #include "Cube.h"
+#include "Preference.h"
 #include "ProgramLauncher.h"
 #include "Progress.h"
 #include "PvlGroup.h"
@@ -34,6 +45,18 @@ using namespace Isis;
 //helper button functins in the code
 void helperButtonLog();
 
+/**
+ * The registration of one point of the grid.
+ */
+struct GridRegistration {
+  bool success;
+  double cubeSample;
+  double cubeLine;
+  double goodnessOfFit;
+};
+
+QList<AutoReg *> createRegistrations(AutoReg *ar, Pvl &regdef);
+
 map <QString, void *> GuiHelpers() {
   map <QString, void *> helper;
   helper ["helperButtonLog"] = (void *) helperButtonLog;
@@ -137,17 +160,69 @@ void IsisMain() {
     cn.SetTarget(*trans.label());
   }
 
+  // The points of the grid are registered in batches, on the global threads
+  // if there is more than one registration. Each batch is then added to the
+  // network in row and column order.
+  QList<AutoReg *> registrations = createRegistrations(ar, regdef);
+  int numPoints = rows * cols;
+  int batchSize = 4 * registrations.size();
+
   // Loop through grid of points and get statistics to compute
   // translation values
   Statistics sStats, lStats;
-  for (int r = 0; r < rows; r++) {
-    for (int c = 0; c < cols; c++) {
+  for (int batchStart = 0; batchStart < numPoints; batchStart += batchSize) {
+    int batchCount = min(batchSize, numPoints - batchStart);
+
+    std::vector<GridRegistration> batch(batchCount);
+    QAtomicInt nextPoint(0);
+    QMap<int, IException> errors;
+    QMutex errorsMutex;
+
+    auto registerBatch = [&](AutoReg *registration) {
+      int batchIndex;
+      while ( (batchIndex = nextPoint.fetchAndAddOrdered(1)) < batchCount ) {
+        try {
+          int r = (batchStart + batchIndex) / cols;
+          int c = (batchStart + batchIndex) % cols;
+          int line = (int)(lSpacing / 2.0 + lSpacing * r + 0.5);
+          int samp = (int)(sSpacing / 2.0 + sSpacing * c + 0.5);
+          registration->PatternChip()->TackCube(samp, line);
+          registration->PatternChip()->Load(match);
+          registration->SearchChip()->TackCube(samp, line);
+          registration->SearchChip()->Load(trans);
+
+          registration->Register();
+
+          GridRegistration &result = batch[batchIndex];
+          result.success = registration->Success();
+          result.cubeSample = registration->CubeSample();
+          result.cubeLine = registration->CubeLine();
+          result.goodnessOfFit = registration->GoodnessOfFit();
+        }
+        catch (IException &e) {
+          QMutexLocker locker(&errorsMutex);
+          errors.insert(batchIndex, e);
+        }
+      }
+    };
+
+    if (registrations.size() == 1) {
+      registerBatch(ar);
+    }
+    else {
+      QtConcurrent::blockingMap(registrations, registerBatch);
+    }
+
+    if ( !errors.isEmpty() ) {
+      throw errors.first();
+    }
+
+    for (int batchIndex = 0; batchIndex < batchCount; batchIndex++) {
+      int r = (batchStart + batchIndex) / cols;
+      int c = (batchStart + batchIndex) % cols;
       int line = (int)(lSpacing / 2.0 + lSpacing * r + 0.5);
       int samp = (int)(sSpacing / 2.0 + sSpacing * c + 0.5);
-      ar->PatternChip()->TackCube(samp, line);
-      ar->PatternChip()->Load(match);
-      ar->SearchChip()->TackCube(samp, line);
-      ar->SearchChip()->Load(trans);
+      const GridRegistration &result = batch[batchIndex];
 
       // Set up ControlMeasure for cube to translate
       ControlMeasure * cmTrans = new ControlMeasure;
@@ -161,20 +236,18 @@ void IsisMain() {
       cmMatch->SetCoordinate(samp, line, ControlMeasure::RegisteredPixel);
       cmMatch->SetChooserName("coreg");
 
-      ar->Register();
-
       // Match found
-      if (ar->Success()) {
-        double sDiff = samp - ar->CubeSample();
-        double lDiff = line - ar->CubeLine();
+      if (result.success) {
+        double sDiff = samp - result.cubeSample;
+        double lDiff = line - result.cubeLine;
         sStats.AddData(&sDiff, (unsigned int)1);
         lStats.AddData(&lDiff, (unsigned int)1);
-        cmTrans->SetCoordinate(ar->CubeSample(), ar->CubeLine(),
+        cmTrans->SetCoordinate(result.cubeSample, result.cubeLine,
                               ControlMeasure::RegisteredPixel);
         cmTrans->SetResidual(sDiff, lDiff);
         cmTrans->SetLogData(ControlMeasureLogData(
               ControlMeasureLogData::GoodnessOfFit,
-              ar->GoodnessOfFit()));
+              result.goodnessOfFit));
       }
 
       // Add the measures to a control point
@@ -211,6 +284,11 @@ void IsisMain() {
   results += PvlKeyword("LineStandardDeviation", toString(lDev));
   Application::Log(results);
 
+  for (int i = 1; i < registrations.size(); i++) {
+    ar->AddStatistics(*registrations[i]);
+    delete registrations[i];
+  }
+
   Pvl arPvl = ar->RegistrationStatistics();
 
   for (int i = 0; i < arPvl.groups(); i++) {
@@ -284,6 +362,30 @@ void IsisMain() {
   }
 }
 
+/**
+ * Returns the registrations to register the grid with: the application's
+ * registration, and if the PointRegistration Performance preference is
+ * Threaded, another one from the same definition for each other global
+ * thread.
+ */
+QList<AutoReg *> createRegistrations(AutoReg *ar, Pvl &regdef) {
+  QList<AutoReg *> registrations;
+  registrations.append(ar);
+
+  PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+  if (performancePrefs.hasKeyword("PointRegistration")) {
+    IString registrationPerfOpt = performancePrefs["PointRegistration"][0];
+    if (registrationPerfOpt.DownCase() == "threaded") {
+      int numThreads = QThreadPool::globalInstance()->maxThreadCount();
+      for (int i = 1; i < numThreads; i++) {
+        registrations.append(AutoRegFactory::Create(regdef));
+      }
+    }
+  }
+
+  return registrations;
+}
+
 //Helper function to output the regdeft file to log.
 void helperButtonLog() {
   UserInterface &ui = Application::GetUserInterface();
@@ -8,6 +8,18 @@ find files of those names at the top level of this repository. **/
 
 #include <sys/resource.h>
 
+#include <algorithm>
+#include <vector>
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
 #include "pointreg.h"
 
 #include "AutoReg.h"
@@ -21,33 +33,72 @@ find files of those names at the top level of this repository. **/
 #include "Cube.h"
 #include "CubeManager.h"
 #include "Pixel.h"
+#include "Preference.h"
 #include "Progress.h"
 #include "SerialNumberList.h"
 #include "UserInterface.h"
 #include "Application.h"
 #include "IException.h"
+#include "IString.h"
+#include "NaifStatus.h"
 #include "iTime.h"
 
 using namespace std;
 namespace Isis {
 
-  AutoReg *ar;
-  AutoReg *validator;
-  CubeManager *cubeMgr;
   SerialNumberList *files;
   QList<QString> *falsePositives;
 
   int ignored;
-  int locked;
-  int registered;
-  int notintersected;
-  int unregistered;
+
+  QString registerPoints;
+  QString registerMeasures;
+  QString validate;
+  bool outputFailed;
+  double shiftTolerance;
 
   bool logFalsePositives;
   bool revertFalsePositives;
   int expansion;
   double resTolerance;
 
+  /**
+   * The registration and validation AutoRegs, opened cubes and measure
+   * counts used to register points. pointreg registers every point with one
+   * Registrar, unless the PointRegistration Performance preference is
+   * Threaded, in which case each global thread registers points with its
+   * own.
+   *
+   * @internal
+   */
+  class Registrar {
+    public:
+      Registrar(Pvl &pvl, UserInterface &ui, unsigned int maxOpenCubes);
+      ~Registrar();
+
+      AutoReg *ar;
+      AutoReg *validator;
+      CubeManager *cubeMgr;
+
+      int locked;
+      int registered;
+      int notintersected;
+      int unregistered;
+  };
+
+
+  /**
+   * A copy of a point of the output network registered by one of the global
+   * threads, and the false positives found validating it. The copy is applied
+   * to the network on the main thread, in point order.
+   *
+   * @internal
+   */
+  struct RegisteredPoint {
+    QSharedPointer<ControlPoint> point;
+    QList<QString> falsePositives;
+  };
+
   /**
    * @author 2012-04-06 Travis Addair
    *
@@ -184,12 +235,26 @@ namespace Isis {
   };
 
 
-  void registerPoint(ControlPoint *outPoint, ControlMeasure *patternCM,
-      QString registerMeasures, bool outputFailed);
-  void validatePoint(ControlPoint *point, ControlMeasure *reference,
-      double shiftTolerance);
-  Validation backRegister(ControlMeasure *measure, ControlMeasure *reference,
-      double shiftTolerance);
+  bool wantToRegister(const ControlPoint *point);
+  void registerAndValidate(Registrar &registrar, ControlPoint *point,
+      QList<QString> *pointFalsePositives);
+  QList< QSharedPointer<Registrar> > createRegistrars(Pvl &pvl,
+      UserInterface &ui, unsigned int maxOpenFiles);
+  void registerPointsInParallel(QList< QSharedPointer<Registrar> > &registrars,
+      ControlNet &outNet, int first,
+      QHash<QString, RegisteredPoint> &registeredPoints);
+  void applyRegistration(ControlPoint *outPoint,
+      const RegisteredPoint &registeredPoint);
+
+  void registerPoint(Registrar &registrar, ControlPoint *outPoint,
+      ControlMeasure *patternCM, QString registerMeasures, bool outputFailed);
+  void validatePoint(Registrar &registrar, ControlPoint *point,
+      ControlMeasure *reference, double shiftTolerance,
+      QList<QString> *pointFalsePositives);
+  Validation backRegister(Registrar &registrar, ControlMeasure *measure,
+      ControlMeasure *reference, double shiftTolerance);
+
+  Cube &openCube(Registrar &registrar, QString serialNumber);
 
   double getResolution(Cube &cube, ControlMeasure &measure);
   void verifyCube(Cube & cube);
@@ -206,16 +271,9 @@ namespace Isis {
 
   void pointreg(UserInterface &ui, Pvl *appLog) {
     // Initialize variables
-    ar = NULL;
-    validator = NULL;
-    cubeMgr = NULL;
     falsePositives = NULL;
 
     ignored = 0;
-    locked = 0;
-    registered = 0;
-    notintersected = 0;
-    unregistered = 0;
 
     logFalsePositives = false;
     revertFalsePositives = false;
@@ -226,10 +284,10 @@ namespace Isis {
     }
 
     // Determine which points/measures to register
-    QString registerPoints = ui.GetString("POINTS");
-    QString registerMeasures = ui.GetString("MEASURES");
+    registerPoints = ui.GetString("POINTS");
+    registerMeasures = ui.GetString("MEASURES");
 
-    bool outputFailed = ui.GetBoolean("OUTPUTFAILED");
+    outputFailed = ui.GetBoolean("OUTPUTFAILED");
     bool outputIgnored = ui.GetBoolean("OUTPUTIGNORED");
 
     // Open the files list in a SerialNumberList for
@@ -247,9 +305,7 @@ namespace Isis {
 
     outNet.SetUserName(Application::UserName());
 
-    // Create an AutoReg from the template file
     Pvl pvl(ui.GetFileName("DEFFILE"));
-    ar = AutoRegFactory::Create(pvl);
 
     Progress progress;
     progress.SetText("Registering Points");
@@ -265,34 +321,19 @@ namespace Isis {
     //  Allow for library files, etc
     unsigned int maxOpenFiles = limit.rlim_cur * .60;
 
-
-    cubeMgr = new CubeManager;
-    cubeMgr->SetNumOpenCubes(maxOpenFiles);
-
-    QString validate = ui.GetString("VALIDATE");
+    validate = ui.GetString("VALIDATE");
     if (validate != "SKIP") {
-      validator = AutoRegFactory::Create(pvl);
-
-      validator->SetTolerance(validator->MostLenientTolerance());
-      validator->SetPatternZScoreMinimum(DBL_MIN);
-      validator->SetPatternValidPercent(DBL_MIN);
-      validator->SetSubsearchValidPercent(DBL_MIN);
-
-      validator->SetSurfaceModelDistanceTolerance(validator->WindowSize());
-
-      expansion = ui.WasEntered("SEARCH") ?
-        ui.GetInteger("SEARCH") : validator->WindowSize();
-      expansion *= 2;
-
-      int patternSamples = validator->PatternChip()->Samples();
-      int patternLines = validator->PatternChip()->Lines();
-      validator->SearchChip()->SetSize(
-          patternSamples + expansion, patternLines + expansion);
-
       revertFalsePositives = ui.GetBoolean("REVERT");
       resTolerance = ui.GetDouble("RESTOLERANCE");
+      shiftTolerance = ui.GetDouble("SHIFT");
     }
 
+    // Create the AutoRegs from the template file. The first registrar's
+    // statistics are the totals once the points are registered.
+    QList< QSharedPointer<Registrar> > registrars =
+        createRegistrars(pvl, ui, maxOpenFiles);
+    QHash<QString, RegisteredPoint> registeredPoints;
+
     // Register the points and create a new
     // ControlNet containing the refined measurements
     int i = 0;
@@ -302,17 +343,8 @@ namespace Isis {
 
       ControlPoint * outPoint = outNet.GetPoint(i);
 
-      // Establish whether or not we want to attempt to register this point.
-      bool wantToRegister = true;
-      if (outPoint->IsIgnored()) {
-        if (registerPoints == "NONIGNORED") wantToRegister = false;
-      }
-      else {
-        if (registerPoints == "IGNORED") wantToRegister = false;
-      }
-
       // Check if this is a point we wish to disregard.
-      if (!wantToRegister) {
+      if (!wantToRegister(outPoint)) {
         // Keep track of how many ignored points we didn't register.
         if (outPoint->IsIgnored()) {
           ignored++;
@@ -325,21 +357,15 @@ namespace Isis {
         }
       }
       else {  // "Ignore" or "valid" point to be registered
-        if (outPoint->IsIgnored()) {
-          outPoint->SetIgnored(false);
+        if (registrars.size() == 1) {
+          registerAndValidate(*registrars[0], outPoint, falsePositives);
         }
-
-        ControlMeasure * patternCM = outPoint->GetRefMeasure();
-
-        // In case this is an implicit reference, make it explicit since we'll be
-        // registering measures to it
-        outPoint->SetRefMeasure(patternCM);
-
-        if (validate != "ONLY") {
-          registerPoint(outPoint, patternCM, registerMeasures, outputFailed);
-        }
-        if (validate != "SKIP") {
-          validatePoint(outPoint, patternCM, ui.GetDouble("SHIFT"));
+        else {
+          // Register this point and the next few on the global threads
+          if (!registeredPoints.contains(outPoint->GetId())) {
+            registerPointsInParallel(registrars, outNet, i, registeredPoints);
+          }
+          applyRegistration(outPoint, registeredPoints.take(outPoint->GetId()));
         }
 
         // Check to see if the control point has now been assigned
@@ -471,6 +497,27 @@ namespace Isis {
     pLog += PvlKeyword("Ignored", toString(ignored));
     appLog->addLogGroup(pLog);
 
+    AutoReg *ar = registrars[0]->ar;
+    AutoReg *validator = registrars[0]->validator;
+
+    int locked = 0;
+    int registered = 0;
+    int notintersected = 0;
+    int unregistered = 0;
+    for (int r = 0; r < registrars.size(); r++) {
+      locked += registrars[r]->locked;
+      registered += registrars[r]->registered;
+      notintersected += registrars[r]->notintersected;
+      unregistered += registrars[r]->unregistered;
+
+      if (r > 0) {
+        ar->AddStatistics(*registrars[r]->ar);
+        if (validator) {
+          validator->AddStatistics(*registrars[r]->validator);
+        }
+      }
+    }
+
     PvlGroup mLog("Measures");
     mLog += PvlKeyword("Locked", toString(locked));
     mLog += PvlKeyword("Registered", toString(registered));
@@ -511,6 +558,60 @@ namespace Isis {
 
     outNet.Write(ui.GetFileName("ONET"));
 
+    registrars.clear();
+
+    delete files;
+    files = NULL;
+
+    delete falsePositives;
+    falsePositives = NULL;
+  }
+
+
+  /**
+   * Creates the registration and validation AutoRegs from the registration
+   * template, and a cube manager that keeps at most the given number of
+   * cubes open.
+   *
+   * @param pvl The registration template
+   * @param ui The user interface
+   * @param maxOpenCubes The maximum number of cubes this registrar keeps open
+   */
+  Registrar::Registrar(Pvl &pvl, UserInterface &ui, unsigned int maxOpenCubes) {
+    ar = AutoRegFactory::Create(pvl);
+    validator = NULL;
+
+    cubeMgr = new CubeManager;
+    cubeMgr->SetNumOpenCubes(maxOpenCubes);
+
+    if (validate != "SKIP") {
+      validator = AutoRegFactory::Create(pvl);
+
+      validator->SetTolerance(validator->MostLenientTolerance());
+      validator->SetPatternZScoreMinimum(DBL_MIN);
+      validator->SetPatternValidPercent(DBL_MIN);
+      validator->SetSubsearchValidPercent(DBL_MIN);
+
+      validator->SetSurfaceModelDistanceTolerance(validator->WindowSize());
+
+      expansion = ui.WasEntered("SEARCH") ?
+        ui.GetInteger("SEARCH") : validator->WindowSize();
+      expansion *= 2;
+
+      int patternSamples = validator->PatternChip()->Samples();
+      int patternLines = validator->PatternChip()->Lines();
+      validator->SearchChip()->SetSize(
+          patternSamples + expansion, patternLines + expansion);
+    }
+
+    locked = 0;
+    registered = 0;
+    notintersected = 0;
+    unregistered = 0;
+  }
+
+
+  Registrar::~Registrar() {
     delete ar;
     ar = NULL;
 
@@ -519,26 +620,205 @@ namespace Isis {
 
     delete cubeMgr;
     cubeMgr = NULL;
+  }
 
-    delete files;
-    files = NULL;
 
-    delete falsePositives;
-    falsePositives = NULL;
+  /**
+   * Creates one registrar, or one for each global thread if the
+   * PointRegistration Performance preference is Threaded. The open file
+   * limit is split between the registrars.
+   *
+   * @param pvl The registration template
+   * @param ui The user interface
+   * @param maxOpenFiles The maximum number of cubes open at once
+   *
+   * @return QList<QSharedPointer<Registrar>> The registrars
+   */
+  QList< QSharedPointer<Registrar> > createRegistrars(Pvl &pvl,
+      UserInterface &ui, unsigned int maxOpenFiles) {
+
+    int numRegistrars = 1;
+
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("PointRegistration")) {
+      IString registrationPerfOpt = performancePrefs["PointRegistration"][0];
+      if (registrationPerfOpt.DownCase() == "threaded") {
+        numRegistrars = max(1, QThreadPool::globalInstance()->maxThreadCount());
+      }
+    }
+
+    QList< QSharedPointer<Registrar> > registrars;
+    for (int r = 0; r < numRegistrars; r++) {
+      registrars.append(QSharedPointer<Registrar>(
+          new Registrar(pvl, ui, max(1u, maxOpenFiles / numRegistrars))));
+    }
+
+    return registrars;
   }
 
 
-  void registerPoint(ControlPoint *outPoint, ControlMeasure *patternCM,
-      QString registerMeasures, bool outputFailed) {
+  // Establish whether or not we want to attempt to register this point.
+  bool wantToRegister(const ControlPoint *point) {
+    if (point->IsIgnored()) {
+      return registerPoints != "NONIGNORED";
+    }
+
+    return registerPoints != "IGNORED";
+  }
+
+
+  void registerAndValidate(Registrar &registrar, ControlPoint *point,
+      QList<QString> *pointFalsePositives) {
+
+    if (point->IsIgnored()) {
+      point->SetIgnored(false);
+    }
+
+    ControlMeasure * patternCM = point->GetRefMeasure();
+
+    // In case this is an implicit reference, make it explicit since we'll be
+    // registering measures to it
+    point->SetRefMeasure(patternCM);
+
+    if (validate != "ONLY") {
+      registerPoint(registrar, point, patternCM, registerMeasures, outputFailed);
+    }
+    if (validate != "SKIP") {
+      validatePoint(registrar, point, patternCM, shiftTolerance,
+          pointFalsePositives);
+    }
+  }
+
+
+  /**
+   * Registers copies of the points to be registered, starting at the given
+   * point, on the global threads. A few points are registered for each
+   * registrar, which each register the next point not yet taken. The copies
+   * are not part of the network, so the network is only changed on the main
+   * thread, when the copies are applied in point order.
+   *
+   * @param registrars The registrars, one for each thread
+   * @param outNet The output network
+   * @param first The index of the first point to register
+   * @param registeredPoints The registered copies, by point id
+   */
+  void registerPointsInParallel(QList< QSharedPointer<Registrar> > &registrars,
+      ControlNet &outNet, int first,
+      QHash<QString, RegisteredPoint> &registeredPoints) {
+
+    int batchSize = 4 * registrars.size();
+
+    std::vector<RegisteredPoint> batch;
+    for (int i = first; i < outNet.GetNumPoints() && (int) batch.size() < batchSize; i++) {
+      const ControlPoint *outPoint = outNet.GetPoint(i);
+      if (wantToRegister(outPoint)) {
+        RegisteredPoint registeredPoint;
+        registeredPoint.point = QSharedPointer<ControlPoint>(new ControlPoint(*outPoint));
+        batch.push_back(registeredPoint);
+      }
+    }
 
-    Cube &patternCube = *cubeMgr->OpenCube(
-        files->fileName(patternCM->GetCubeSerialNumber()));
+    int batchCount = batch.size();
+    QAtomicInt nextPoint(0);
+    QMap<int, IException> errors;
+    QMutex errorsMutex;
+
+    auto registerBatch = [&](QSharedPointer<Registrar> registrar) {
+      int batchIndex;
+      while ( (batchIndex = nextPoint.fetchAndAddOrdered(1)) < batchCount ) {
+        try {
+          registerAndValidate(*registrar, batch[batchIndex].point.data(),
+              &batch[batchIndex].falsePositives);
+        }
+        catch (IException &e) {
+          QMutexLocker locker(&errorsMutex);
+          errors.insert(batchIndex, e);
+        }
+      }
+    };
+
+    QtConcurrent::blockingMap(registrars, registerBatch);
+
+    if ( !errors.isEmpty() ) {
+      throw errors.first();
+    }
+
+    for (int batchIndex = 0; batchIndex < batchCount; batchIndex++) {
+      registeredPoints.insert(batch[batchIndex].point->GetId(), batch[batchIndex]);
+    }
+  }
+
+
+  /**
+   * Makes a point of the output network match its registered copy. Measures
+   * that were deleted from the copy are deleted and the others are assigned
+   * through the point, so the network is notified of the changes.
+   *
+   * @param outPoint The point of the output network
+   * @param registeredPoint The registered copy of the point
+   */
+  void applyRegistration(ControlPoint *outPoint,
+      const RegisteredPoint &registeredPoint) {
+
+    const ControlPoint *registeredCopy = registeredPoint.point.data();
+
+    if (outPoint->IsIgnored()) {
+      outPoint->SetIgnored(false);
+    }
+    outPoint->SetRefMeasure(outPoint->GetRefMeasure());
+
+    int j = 0;
+    while (j < outPoint->GetNumMeasures()) {
+      ControlMeasure *measure = outPoint->GetMeasure(j);
+      QString serialNumber = measure->GetCubeSerialNumber();
+
+      if (!registeredCopy->HasSerialNumber(serialNumber)) {
+        outPoint->Delete(j);
+        continue;
+      }
+
+      // Locked measures are never registered
+      if (!measure->IsEditLocked()) {
+        const ControlMeasure *registeredMeasure = registeredCopy->GetMeasure(serialNumber);
+        *measure = *registeredMeasure;
+
+        // Assigning a measure clears who last changed it and when
+        if (registeredMeasure->HasChooserName()) {
+          measure->SetChooserName(registeredMeasure->GetChooserName());
+        }
+        if (registeredMeasure->HasDateTime()) {
+          measure->SetDateTime(registeredMeasure->GetDateTime());
+        }
+      }
+
+      j++;
+    }
+
+    outPoint->SetIgnored(registeredCopy->IsIgnored());
+
+    if (logFalsePositives) {
+      falsePositives->append(registeredPoint.falsePositives);
+    }
+  }
+
+
+  void registerPoint(Registrar &registrar, ControlPoint *outPoint,
+      ControlMeasure *patternCM, QString registerMeasures, bool outputFailed) {
+
+    AutoReg *ar = registrar.ar;
+
+    // Loading chips evaluates the cameras, which makes NAIF calls
+    QMutexLocker naifLocker(NaifStatus::mutex());
+
+    Cube &patternCube = openCube(registrar, patternCM->GetCubeSerialNumber());
 
     ar->PatternChip()->TackCube(patternCM->GetSample(), patternCM->GetLine());
     ar->PatternChip()->Load(patternCube);
 
+    naifLocker.unlock();
+
     if (patternCM->IsEditLocked()) {
-      locked++;
+      registrar.locked++;
     }
 
     if (outPoint->GetRefMeasure() != patternCM) {
@@ -553,15 +833,15 @@ namespace Isis {
         ControlMeasure * measure = outPoint->GetMeasure(j);
         if (measure->IsEditLocked()) {
           // If the measurement is locked, keep it as is and go to next measure
-          locked++;
+          registrar.locked++;
         }
         else if (!measure->IsMeasured() || registerMeasures != "CANDIDATES") {
 
+          naifLocker.relock();
+
           // refresh pattern cube pointer to ensure it stays valid
-          Cube &patternCube = *cubeMgr->OpenCube(files->fileName(
-                patternCM->GetCubeSerialNumber()));
-          Cube &searchCube = *cubeMgr->OpenCube(files->fileName(
-                measure->GetCubeSerialNumber()));
+          Cube &patternCube = openCube(registrar, patternCM->GetCubeSerialNumber());
+          Cube &searchCube = openCube(registrar, measure->GetCubeSerialNumber());
 
           ar->SearchChip()->TackCube(measure->GetSample(), measure->GetLine());
 
@@ -570,6 +850,7 @@ namespace Isis {
 
           try {
             ar->SearchChip()->Load(searchCube, *(ar->PatternChip()), patternCube);
+            naifLocker.unlock();
 
             // If the measurements were correctly registered
             // Write them to the new ControlNet
@@ -589,11 +870,13 @@ namespace Isis {
             if (ar->Success()) {
               // Check to make sure the newly calculated measure position is on
               // the surface of the planet
+              naifLocker.relock();
               Camera *cam = searchCube.camera();
               bool foundLatLon = cam->SetImage(ar->CubeSample(), ar->CubeLine());
+              naifLocker.unlock();
 
               if (foundLatLon) {
-                registered++;
+                registrar.registered++;
 
                 if (res == AutoReg::SuccessSubPixel) {
                   measure->SetType(ControlMeasure::RegisteredSubPixel);
@@ -618,7 +901,7 @@ namespace Isis {
                 patternCM->SetIgnored(false);
               }
               else {
-                notintersected++;
+                registrar.notintersected++;
 
                 if (outputFailed) {
                   measure->SetType(ControlMeasure::Candidate);
@@ -632,7 +915,7 @@ namespace Isis {
             }
             // Else use the original marked as "Candidate"
             else {
-              unregistered++;
+              registrar.unregistered++;
 
               if (outputFailed) {
                 measure->SetType(ControlMeasure::Candidate);
@@ -651,7 +934,8 @@ namespace Isis {
             }
           }
           catch (IException &e) {
-            unregistered++;
+            naifLocker.unlock();
+            registrar.unregistered++;
 
             if (outputFailed) {
               measure->SetType(ControlMeasure::Candidate);
@@ -686,15 +970,16 @@ namespace Isis {
   }
 
 
-  void validatePoint(ControlPoint *point, ControlMeasure *reference,
-      double shiftTolerance) {
+  void validatePoint(Registrar &registrar, ControlPoint *point,
+      ControlMeasure *reference, double shiftTolerance,
+      QList<QString> *pointFalsePositives) {
 
     for (int i = 0; i < point->GetNumMeasures(); i++) {
       if (i != point->IndexOfRefMeasure()) {
         ControlMeasure *measure = point->GetMeasure(i);
         if (measure->IsMeasured() && !measure->IsEditLocked()) {
           Validation validation = backRegister(
-              reference, measure, shiftTolerance);
+              registrar, reference, measure, shiftTolerance);
 
           // If the validation failed, or we were unable to perform the validation
           // due to registration errors, we consider this registration to be a
@@ -713,7 +998,7 @@ namespace Isis {
           // failed, or skipped due to incompatible data), log the result
           if (logFalsePositives) {
             if (!validation.succeeded()) {
-              falsePositives->append(
+              pointFalsePositives->append(
                   validation.toString());
             }
           }
@@ -723,16 +1008,19 @@ namespace Isis {
   }
 
 
-  Validation backRegister(ControlMeasure *reference, ControlMeasure *measure,
-      double shiftTolerance) {
+  Validation backRegister(Registrar &registrar, ControlMeasure *reference,
+      ControlMeasure *measure, double shiftTolerance) {
+
+    AutoReg *validator = registrar.validator;
 
     Validation validation(
         "Back-Registration", measure, reference, shiftTolerance);
 
-    Cube &patternCube = *cubeMgr->OpenCube(files->fileName(
-          measure->GetCubeSerialNumber()));
-    Cube &searchCube = *cubeMgr->OpenCube(files->fileName(
-          reference->GetCubeSerialNumber()));
+    // Loading chips evaluates the cameras, which makes NAIF calls
+    QMutexLocker naifLocker(NaifStatus::mutex());
+
+    Cube &patternCube = openCube(registrar, measure->GetCubeSerialNumber());
+    Cube &searchCube = openCube(registrar, reference->GetCubeSerialNumber());
 
     double patternRes = getResolution(patternCube, *measure);
     double searchRes = getResolution(searchCube, *reference);
@@ -752,6 +1040,7 @@ namespace Isis {
     try {
       validator->SearchChip()->Load(
           searchCube, *(validator->PatternChip()), patternCube);
+      naifLocker.unlock();
 
       // If the measurements were correctly registered
       // Write them to the new ControlNet
@@ -762,9 +1051,11 @@ namespace Isis {
       if (validator->Success()) {
         // Check to make sure the newly calculated measure position is on
         // the surface of the planet
+        naifLocker.relock();
         Camera *cam = searchCube.camera();
         bool foundLatLon = cam->SetImage(
             validator->CubeSample(), validator->CubeLine());
+        naifLocker.unlock();
 
         if (foundLatLon) {
           validation.compare(
@@ -779,6 +1070,22 @@ namespace Isis {
   }
 
 
+  /**
+   * Opens the cube with the given serial number with the registrar's cube
+   * manager. Opening a cube can close the least recently used one, which
+   * unloads the NAIF kernels of its camera, so this holds the NAIF mutex.
+   *
+   * @param registrar The registrar opening the cube
+   * @param serialNumber The serial number of the cube
+   *
+   * @return Cube& The opened cube
+   */
+  Cube &openCube(Registrar &registrar, QString serialNumber) {
+    QMutexLocker naifLocker(NaifStatus::mutex());
+    return *registrar.cubeMgr->OpenCube(files->fileName(serialNumber));
+  }
+
+
   double getResolution(Cube &cube, ControlMeasure &measure) {
     // TODO retrieve for projection
     Camera *camera = cube.camera();
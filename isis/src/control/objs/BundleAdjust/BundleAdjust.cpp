@@ -432,6 +432,9 @@ namespace Isis {
     // - some of these not originally initialized.. better values???
     m_iteration = 0;
     m_rank = 0;
+    m_analyzeTime = 0.0;
+    m_factorTime = 0.0;
+    m_solveTime = 0.0;
     m_iterationSummary = "";
 
     // Get the cameras set up for all images
@@ -464,7 +467,7 @@ namespace Isis {
     // m_cholmodCommon, m_sparseNormals are not initialized
     m_L = NULL;
     m_cholmodNormal = NULL;
-    m_cholmodTriplet = NULL;
+    m_normalsPatternBlocks = 0;
 
       // set up BundleObservations and assign solve settings for each from BundleSettings class
       for (int i = 0; i < numImages; i++) {
@@ -711,7 +714,9 @@ namespace Isis {
       return false;
     }
 
-    m_cholmodTriplet = NULL;
+    m_cholmodNormal = NULL;
+    m_L = NULL;
+    m_normalsPatternBlocks = 0;
 
     cholmod_l_start(&m_cholmodCommon);
 
@@ -729,14 +734,13 @@ namespace Isis {
   /**
    * @brief Free CHOLMOD library variables.
    *
-   * Frees m_cholmodTriplet, m_cholmodNormal, and m_L.
+   * Frees m_cholmodNormal and m_L.
    * Calls cholmod_finish when complete.
    *
    * @return bool If the CHOLMOD library successfully cleaned up.
    */
   bool BundleAdjust::freeCHOLMODLibraryVariables() {
 
-    cholmod_l_free_triplet(&m_cholmodTriplet, &m_cholmodCommon);
     cholmod_l_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
     cholmod_l_free_factor(&m_L, &m_cholmodCommon);
 
@@ -1060,6 +1064,10 @@ namespace Isis {
                                                            fieldWidth,
                                                            format,
                                                            precision) );
+        emit statusUpdate( QString("CHOLMOD Analyze/Factor/Solve Time: %1 %2 %3 \n")
+                                   .arg(m_analyzeTime)
+                                   .arg(m_factorTime)
+                                   .arg(m_solveTime) );
 
         // check for maximum iterations
         if (m_iteration >= m_bundleSettings->convergenceCriteriaMaximumIterations()) {
@@ -1073,12 +1081,6 @@ namespace Isis {
           m_bundleResults.initializeResidualsProbabilityDistribution(101);
         }
 
-        // if we're using CHOLMOD and still going, release cholmod_factor
-        // (if we don't, memory leaks will occur), otherwise we need it for error propagation
-        if (!m_bundleResults.converged() || !m_bundleSettings->errorPropagation()) {
-          cholmod_l_free_factor(&m_L, &m_cholmodCommon);
-        }
-
         iterationSummary();
 
         m_iteration++;
@@ -1688,7 +1690,7 @@ namespace Isis {
                                     SparseBlockColumnMatrix &N12,
                                     SparseBlockRowMatrix &Q) {
 
-    QMapIterator< int, LinearAlgebra::Matrix * > N12it(N12);
+    SparseBlockMapIterator N12it(N12);
 
     while ( N12it.hasNext() ) {
       N12it.next();
@@ -1717,8 +1719,8 @@ namespace Isis {
   void BundleAdjust::productAB(SparseBlockColumnMatrix &N12,
                                SparseBlockRowMatrix &Q) {
     // iterators for N12 and Q
-    QMapIterator<int, LinearAlgebra::Matrix*> N12it(N12);
-    QMapIterator<int, LinearAlgebra::Matrix*> Qit(Q);
+    SparseBlockMapIterator N12it(N12);
+    SparseBlockMapIterator Qit(Q);
 
     // now multiply blocks and subtract from m_sparseNormals
     while ( N12it.hasNext() ) {
@@ -1770,7 +1772,7 @@ namespace Isis {
 
     int numParams;
 
-    QMapIterator<int, LinearAlgebra::Matrix*> Qit(Q);
+    SparseBlockMapIterator Qit(Q);
 
     while ( Qit.hasNext() ) {
       Qit.next();
@@ -1794,30 +1796,33 @@ namespace Isis {
    *
    * @return @b bool If the solution was successfully computed.
    *
-   * @throws IException::Programmer "CHOLMOD: Failed to load Triplet matrix"
+   * @throws IException::Programmer "CHOLMOD: Failed to load Sparse matrix"
    *
    * @see BundleAdjust::solveCholesky
    */
   bool BundleAdjust::solveSystem() {
 
-    // load cholmod triplet
-    if ( !loadCholmodTriplet() ) {
-      QString msg = "CHOLMOD: Failed to load Triplet matrix";
+    // load cholmod sparse matrix
+    if ( !loadCholmodSparse() ) {
+      QString msg = "CHOLMOD: Failed to load Sparse matrix";
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
-    // convert triplet to sparse matrix
-    m_cholmodNormal = cholmod_l_triplet_to_sparse(m_cholmodTriplet,
-                                                m_cholmodTriplet->nnz,
-                                                &m_cholmodCommon);
-
     // analyze matrix
-    // TODO should we analyze just 1st iteration?
-    m_L = cholmod_l_analyze(m_cholmodNormal, &m_cholmodCommon);
+    // The fill-reducing ordering and symbolic factorization only depend on the pattern of
+    // m_cholmodNormal, so they are kept until loadCholmodSparse rebuilds the pattern.
+    clock_t analyzeStartClock = clock();
+    if ( !m_L ) {
+      m_L = cholmod_l_analyze(m_cholmodNormal, &m_cholmodCommon);
+    }
+    m_analyzeTime = (clock() - analyzeStartClock) / (double)CLOCKS_PER_SEC;
 
     // create cholmod cholesky factor
     // CHOLMOD will choose LLT or LDLT decomposition based on the characteristics of the matrix.
+    // If m_L was already factored, this is a numeric refactorization using the same ordering.
+    clock_t factorStartClock = clock();
     cholmod_l_factorize(m_cholmodNormal, m_L, &m_cholmodCommon);
+    m_factorTime = (clock() - factorStartClock) / (double)CLOCKS_PER_SEC;
 
     // check for "matrix not positive definite" error
     if (m_cholmodCommon.status == CHOLMOD_NOT_POSDEF) {
@@ -1841,7 +1846,9 @@ namespace Isis {
     }
 
     // cholmod solve
+    clock_t solveStartClock = clock();
     x = cholmod_l_solve(CHOLMOD_A, m_L, b, &m_cholmodCommon);
+    m_solveTime = (clock() - solveStartClock) / (double)CLOCKS_PER_SEC;
 
     // copy solution vector x out into m_imageSolution
     double *sx = (double*)x->x;
@@ -1849,8 +1856,7 @@ namespace Isis {
       m_imageSolution[i] = sx[i];
     }
 
-    // free cholmod structures
-    cholmod_l_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
+    // free cholmod structures; m_cholmodNormal is kept to be refilled next iteration
     cholmod_l_free_dense(&b, &m_cholmodCommon);
     cholmod_l_free_dense(&x, &m_cholmodCommon);
 
@@ -1859,112 +1865,145 @@ namespace Isis {
 
 
   /**
-   * @brief Load sparse normal equations matrix into CHOLMOD triplet.
+   * @brief Load the sparse normal equations matrix into the CHOLMOD sparse matrix.
    *
-   * Blocks from the sparse block normal matrix are loaded into a CHOLMOD triplet.
-   * Before the triplet can be used with CHOLMOD, it must be converted to a
-   * CHOLMOD sparse matrix via cholmod_triplet_to_sparse.
+   * The lower triangle of the normal equations is stored in compressed column form, so column
+   * j of m_cholmodNormal holds row j of the upper triangle of m_sparseNormals. Blocks are only
+   * ever added to m_sparseNormals, so its pattern is built the first time and again only when
+   * the number of blocks changes. Every other call just copies the block values into place.
    *
-   * @return @b bool If the triplet was successfully formed.
+   * @return @b bool If the sparse matrix was successfully loaded.
    *
    * @see BundleAdjust::solveSystem
    */
-  bool BundleAdjust::loadCholmodTriplet() {
+  bool BundleAdjust::loadCholmodSparse() {
+    int numBlockColumns = m_sparseNormals.size();
+    int numBlocks = m_sparseNormals.numberOfBlocks();
 
-    if ( m_iteration == 1 ) {
-      int numElements = m_sparseNormals.numberOfElements();
-      m_cholmodTriplet = cholmod_l_allocate_triplet(m_rank, m_rank, numElements,
-                                                  -1, CHOLMOD_REAL, &m_cholmodCommon);
+    // the first parameter of each block row (and block column), and one past the last
+    QVector<int> blockStarts(numBlockColumns + 1);
+    for (int blockIndex = 0; blockIndex < numBlockColumns; blockIndex++) {
+      SparseBlockColumnMatrix *normalsColumn = m_sparseNormals.at(blockIndex);
 
-      if ( !m_cholmodTriplet ) {
-        outputBundleStatus("\nTriplet allocation failure\n");
+      if ( !normalsColumn ) {
+        QString status = "\nSparseBlockColumnMatrix retrieval failure at column " +
+                         QString::number(blockIndex);
+        outputBundleStatus(status);
         return false;
       }
-      m_cholmodTriplet->nnz = 0;
+
+      blockStarts[blockIndex] = normalsColumn->startColumn();
     }
+    blockStarts[numBlockColumns] = m_rank;
 
-    long *tripletColumns = (long*) m_cholmodTriplet->i;
-    long *tripletRows = (long*) m_cholmodTriplet->j;
-    double *tripletValues = (double*)m_cholmodTriplet->x;
+    if ( !m_cholmodNormal || numBlocks != m_normalsPatternBlocks ) {
+      cholmod_l_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
+      // the factor's symbolic analysis belongs to the old pattern
+      cholmod_l_free_factor(&m_L, &m_cholmodCommon);
 
-    double entryValue;
+      m_normalsBlockRowColumns = QVector< QVector<int> >(numBlockColumns);
+      for (int columnIndex = 0; columnIndex < numBlockColumns; columnIndex++) {
+        SparseBlockMapIterator it(*m_sparseNormals.at(columnIndex));
 
-    long numEntries = 0;
+        while ( it.hasNext() ) {
+          it.next();
 
-    long numBlockcolumns = m_sparseNormals.size();
-    for (int columnIndex = 0; columnIndex < numBlockcolumns; columnIndex++) {
+          if ( it.key() > columnIndex || !it.value() ) {
+            QString status = "\nmatrix block retrieval failure at column " +
+                             QString::number(columnIndex) + ", row " + QString::number(it.key());
+            outputBundleStatus(status);
+            return false;
+          }
 
-      SparseBlockColumnMatrix *normalsColumn = m_sparseNormals[columnIndex];
+          m_normalsBlockRowColumns[it.key()].append(columnIndex);
+        }
+      }
 
-      if ( !normalsColumn ) {
-        QString status = "\nSparseBlockColumnMatrix retrieval failure at column " +
-                         QString::number(columnIndex);
-        outputBundleStatus(status);
+      // count the entries of each column of the lower triangle
+      QVector<long> columnCounts(m_rank, 0);
+      for (int rowIndex = 0; rowIndex < numBlockColumns; rowIndex++) {
+        const QVector<int> &blockColumns = m_normalsBlockRowColumns.at(rowIndex);
+
+        for (int ii = 0; ii < blockStarts[rowIndex + 1] - blockStarts[rowIndex]; ii++) {
+          for (int k = 0; k < blockColumns.size(); k++) {
+            int columnIndex = blockColumns.at(k);
+            int blockWidth = blockStarts[columnIndex + 1] - blockStarts[columnIndex];
+            // diagonal blocks only contribute their upper triangle
+            columnCounts[blockStarts[rowIndex] + ii] +=
+                (columnIndex == rowIndex) ? blockWidth - ii : blockWidth;
+          }
+        }
+      }
+
+      long numEntries = std::accumulate(columnCounts.begin(), columnCounts.end(), 0L);
+      m_cholmodNormal = cholmod_l_allocate_sparse(m_rank, m_rank, numEntries, true, true, -1,
+                                                  CHOLMOD_REAL, &m_cholmodCommon);
+
+      if ( !m_cholmodNormal ) {
+        outputBundleStatus("\nSparse matrix allocation failure\n");
         return false;
       }
 
-      int numLeadingColumns = normalsColumn->startColumn();
+      long *columnPointers = (long*) m_cholmodNormal->p;
+      long *entryRows = (long*) m_cholmodNormal->i;
 
-      QMapIterator< int, LinearAlgebra::Matrix * > it(*normalsColumn);
+      columnPointers[0] = 0;
+      for (int column = 0; column < m_rank; column++) {
+        columnPointers[column + 1] = columnPointers[column] + columnCounts[column];
+      }
 
-      while ( it.hasNext() ) {
-        it.next();
+      for (int rowIndex = 0; rowIndex < numBlockColumns; rowIndex++) {
+        const QVector<int> &blockColumns = m_normalsBlockRowColumns.at(rowIndex);
 
-        int rowIndex = it.key();
+        for (int ii = 0; ii < blockStarts[rowIndex + 1] - blockStarts[rowIndex]; ii++) {
+          long entry = columnPointers[blockStarts[rowIndex] + ii];
 
-        // note: as the normal equations matrix is symmetric, the # of leading rows for a block is
-        //       equal to the # of leading columns for a block column at the "rowIndex" position
-        int numLeadingRows = m_sparseNormals.at(rowIndex)->startColumn();
+          for (int k = 0; k < blockColumns.size(); k++) {
+            int columnIndex = blockColumns.at(k);
+            int jj = (columnIndex == rowIndex) ? ii : 0;
 
-        LinearAlgebra::Matrix *normalsBlock = it.value();
-        if ( !normalsBlock ) {
-          QString status = "\nmatrix block retrieval failure at column ";
-          status.append(columnIndex);
-          status.append(", row ");
-          status.append(rowIndex);
-          outputBundleStatus(status);
-          status = "Total # of block columns: " + QString::number(numBlockcolumns);
-          outputBundleStatus(status);
-          status = "Total # of blocks: " + QString::number(m_sparseNormals.numberOfBlocks());
-          outputBundleStatus(status);
-          return false;
+            for (; jj < blockStarts[columnIndex + 1] - blockStarts[columnIndex]; jj++) {
+              entryRows[entry++] = blockStarts[columnIndex] + jj;
+            }
+          }
         }
+      }
 
-        if ( columnIndex == rowIndex )  {   // diagonal block (upper-triangular)
-          for (unsigned ii = 0; ii < normalsBlock->size1(); ii++) {
-            for (unsigned jj = ii; jj < normalsBlock->size2(); jj++) {
-              entryValue = normalsBlock->at_element(ii,jj);
-              int entryColumnIndex = jj + numLeadingColumns;
-              int entryRowIndex = ii + numLeadingRows;
-
-              if ( m_iteration == 1 ) {
-                tripletColumns[numEntries] = entryColumnIndex;
-                tripletRows[numEntries] = entryRowIndex;
-                m_cholmodTriplet->nnz++;
-              }
+      m_normalsPatternBlocks = numBlocks;
+    }
 
-              tripletValues[numEntries] = entryValue;
+    long *columnPointers = (long*) m_cholmodNormal->p;
+    double *entryValues = (double*) m_cholmodNormal->x;
 
-              numEntries++;
-            }
-          }
+    for (int rowIndex = 0; rowIndex < numBlockColumns; rowIndex++) {
+      const QVector<int> &blockColumns = m_normalsBlockRowColumns.at(rowIndex);
+
+      for (int k = 0; k < blockColumns.size(); k++) {
+        int columnIndex = blockColumns.at(k);
+        LinearAlgebra::Matrix *normalsBlock = m_sparseNormals.at(columnIndex)->value(rowIndex);
+
+        // the entries of the blocks before this one in the block row
+        long blockOffset = 0;
+        for (int previous = 0; previous < k; previous++) {
+          int previousColumn = blockColumns.at(previous);
+          blockOffset += blockStarts[previousColumn + 1] - blockStarts[previousColumn];
         }
-        else {                // off-diagonal block (square)
-          for (unsigned ii = 0; ii < normalsBlock->size1(); ii++) {
-            for (unsigned jj = 0; jj < normalsBlock->size2(); jj++) {
-              entryValue = normalsBlock->at_element(ii,jj);
-              int entryColumnIndex = jj + numLeadingColumns;
-              int entryRowIndex = ii + numLeadingRows;
-
-              if ( m_iteration ==1 ) {
-                tripletColumns[numEntries] = entryRowIndex;
-                tripletRows[numEntries] = entryColumnIndex;
-                m_cholmodTriplet->nnz++;
-              }
 
-              tripletValues[numEntries] = entryValue;
+        for (unsigned ii = 0; ii < normalsBlock->size1(); ii++) {
+          long entry = columnPointers[blockStarts[rowIndex] + ii] + blockOffset;
 
-              numEntries++;
+          if (columnIndex == rowIndex) {   // diagonal block (upper-triangular)
+            for (unsigned jj = ii; jj < normalsBlock->size2(); jj++) {
+              entryValues[entry++] = normalsBlock->at_element(ii, jj);
+            }
+          }
+          else {                           // off-diagonal block (square)
+            // the diagonal block before this one only has the upper triangle of row ii
+            if (blockColumns.at(0) == rowIndex) {
+              entry -= ii;
+            }
+            for (unsigned jj = 0; jj < normalsBlock->size2(); jj++) {
+              entryValues[entry++] = normalsBlock->at_element(ii, jj);
             }
           }
         }
@@ -2529,7 +2568,6 @@ namespace Isis {
   bool BundleAdjust::errorPropagation() {
     emit(statusBarUpdate("Error Propagation"));
     // free unneeded memory
-    cholmod_l_free_triplet(&m_cholmodTriplet, &m_cholmodCommon);
     cholmod_l_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
 
     LinearAlgebra::Matrix T(3, 3);
@@ -2554,13 +2592,14 @@ namespace Isis {
       pointCovariances[d].clear();
     }
 
-    cholmod_dense *x;        // solution vector
-    cholmod_dense *b;        // right-hand side (column vectors of identity)
+    // The columns of the inverse are solved for a group of block columns at a time, with a
+    //   right-hand side that holds the matching columns of the identity. Solving many columns
+    //   at once lets CHOLMOD use matrix-matrix kernels instead of one solve per column.
+    const int maxSolveColumns = 64;
 
-    b = cholmod_l_zeros ( m_rank, 1, CHOLMOD_REAL, &m_cholmodCommon );
-    double *pb = (double*)b->x;
-
-    double *px = NULL;
+    cholmod_dense *x = NULL; // solution vectors for columns [solvedColumnStart, solvedColumnEnd)
+    int solvedColumnStart = 0;
+    int solvedColumnEnd = 0;
 
     SparseBlockColumnMatrix inverseMatrix;
 
@@ -2616,15 +2655,36 @@ namespace Isis {
 
       int localCol = 0;
 
-      // solve for inverse for nCols
-      for (j = 0; j < numColumns; j++) {
-        if ( columnIndex > 0 ) {
-          pb[columnIndex - 1] = 0.0;
+      // solve for this block column and the block columns after it that fit in one solve
+      if (columnIndex >= solvedColumnEnd) {
+        cholmod_l_free_dense(&x, &m_cholmodCommon);
+
+        int solveColumns = 0;
+        for (int blockColumn = i; blockColumn < numBlockColumns; blockColumn++) {
+          int blockColumnColumns = m_sparseNormals.at(blockColumn)->numberOfColumns();
+          if (solveColumns > 0 && solveColumns + blockColumnColumns > maxSolveColumns) {
+            break;
+          }
+          solveColumns += blockColumnColumns;
         }
-        pb[columnIndex] = 1.0;
 
-        x = cholmod_l_solve ( CHOLMOD_A, m_L, b, &m_cholmodCommon );
-        px = (double*)x->x;
+        // right-hand side (column vectors of identity)
+        cholmod_dense *b = cholmod_l_zeros(m_rank, solveColumns, CHOLMOD_REAL, &m_cholmodCommon);
+        double *pb = (double*)b->x;
+        for (j = 0; j < solveColumns; j++) {
+          pb[j * b->d + columnIndex + j] = 1.0;
+        }
+
+        x = cholmod_l_solve(CHOLMOD_A, m_L, b, &m_cholmodCommon);
+        cholmod_l_free_dense(&b, &m_cholmodCommon);
+
+        solvedColumnStart = columnIndex;
+        solvedColumnEnd = columnIndex + solveColumns;
+      }
+
+      // copy the solution into the inverse for nCols
+      for (j = 0; j < numColumns; j++) {
+        double *px = (double*)x->x + (columnIndex - solvedColumnStart) * x->d;
         int rp = 0;
 
         // store solution in corresponding column of inverse
@@ -2641,8 +2701,6 @@ namespace Isis {
 
         columnIndex++;
         localCol++;
-
-        cholmod_l_free_dense(&x,&m_cholmodCommon);
       }
 
       // save adjusted target body sigmas if solving for target
@@ -2715,7 +2773,7 @@ namespace Isis {
 
         // iterate over Q
         // secondQBlock is current map value
-        QMapIterator< int, LinearAlgebra::Matrix * > it(Q);
+        SparseBlockMapIterator it(Q);
         while ( it.hasNext() ) {
           it.next();
 
@@ -2769,8 +2827,8 @@ namespace Isis {
     // can free sparse normals now
     m_sparseNormals.wipe();
 
-    // free b (right-hand side vector)
-    cholmod_l_free_dense(&b,&m_cholmodCommon);
+    // free the last solution vectors
+    cholmod_l_free_dense(&x, &m_cholmodCommon);
 
     outputBundleStatus("\n\n");
 
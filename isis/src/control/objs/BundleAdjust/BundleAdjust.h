@@ -10,6 +10,7 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 
 #include <QObject> // parent class
+#include <QVector>
 
 // std lib
 #include <vector>
@@ -457,7 +458,7 @@ namespace Isis {
 
       bool initializeCHOLMODLibraryVariables();
       bool freeCHOLMODLibraryVariables();
-      bool loadCholmodTriplet();
+      bool loadCholmodSparse();
 
       // member variables
 
@@ -492,6 +493,13 @@ namespace Isis {
       int m_rank;                                            //!< The rank of the system.
       int m_iteration;                                       //!< The current iteration.
       double m_iterationTime;                                //!< Time for last iteration
+      double m_analyzeTime;                                  /**!< Time spent in cholmod_analyze
+                                                                   in the last iteration.*/
+      double m_factorTime;                                   /**!< Time spent in
+                                                                   cholmod_factorize in the last
+                                                                   iteration.*/
+      double m_solveTime;                                    /**!< Time spent in cholmod_solve
+                                                                   in the last iteration.*/
       int m_numberOfImagePartials;                           //!< number of image-related partials.
       QList<ImageList *> m_imageLists;                        /**!< The lists of images used in the
                                                                    bundle.*/
@@ -514,23 +522,31 @@ namespace Isis {
                                                                    normal equations.*/
       SparseBlockMatrix m_sparseNormals;                     /**!< The sparse block normal
                                                                    equations matrix.  Used to
-                                                                   populate m_cholmodTriplet and
+                                                                   populate m_cholmodNormal and
                                                                    for error propagation.*/
-      cholmod_triplet  *m_cholmodTriplet;                    /**!< The CHOLMOD triplet
-                                                                   representation of the sparse
-                                                                   normal equations matrix.
-                                                                   Created from m_sparseNormals
-                                                                   and then used to create
-                                                                   m_cholmodNormal.*/
       cholmod_sparse *m_cholmodNormal;                       /**!< The CHOLMOD sparse normal
                                                                    equations matrix used by
                                                                    cholmod_factorize to solve the
-                                                                   system. Created from
-                                                                   m_cholmodTriplet.*/
+                                                                   system. Its pattern is built
+                                                                   from m_sparseNormals once and
+                                                                   its values are refilled every
+                                                                   iteration.*/
+      QVector< QVector<int> > m_normalsBlockRowColumns;     /**!< The block columns of
+                                                                   m_sparseNormals that have a
+                                                                   block in each block row, in
+                                                                   order. This is the block
+                                                                   pattern of m_cholmodNormal.*/
+      int m_normalsPatternBlocks;                            /**!< The number of blocks in
+                                                                   m_sparseNormals when the
+                                                                   pattern of m_cholmodNormal was
+                                                                   built.*/
       cholmod_factor *m_L;                                   /**!< The lower triangular L matrix
                                                                    from Cholesky decomposition.
                                                                    Created from m_cholmodNormal by
-                                                                   cholmod_factorize.*/
+                                                                   cholmod_factorize. Its symbolic
+                                                                   analysis is reused until the
+                                                                   pattern of m_cholmodNormal
+                                                                   changes.*/
       LinearAlgebra::Vector m_imageSolution;                 /**!< The image parameter solution
                                                                    vector.*/
 
@@ -368,7 +368,7 @@ namespace Isis {
                                     SparseBlockMatrix &sparseNormals,
                                     LinearAlgebra::Vector &v1) {
 
-    QMapIterator< int, LinearAlgebra::Matrix * > Qit(m_cholmodQMatrix);
+    SparseBlockMapIterator Qit(m_cholmodQMatrix);
 
     int subrangeStart, subrangeEnd;
 
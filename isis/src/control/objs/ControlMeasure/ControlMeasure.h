@@ -10,17 +10,18 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 
 #include <QObject>
+#include <QString>
+#include <QVector>
+
+#include "ControlMeasureLogData.h"
 
-template< class A> class QVector;
 template< class A> class QList;
-class QString;
 class QStringList;
 class QVariant;
 
 namespace Isis {
   class Application;
   class Camera;
-  class ControlMeasureLogData;
   class ControlPoint;
   class PvlGroup;
   class PvlKeyword;
@@ -343,18 +344,17 @@ namespace Isis {
       ControlPoint *parentPoint;  //!< Pointer to parent ControlPoint, may be null
       // structure connecting measures in an image
 
-      QString *p_serialNumber;
+      QString p_serialNumber;
       MeasureType p_measureType;
 
-      QVector<ControlMeasureLogData> * p_loggedData;
-      PvlGroup *p_comments;
+      QVector<ControlMeasureLogData> p_loggedData;
 
       /**
        * list the program used and the definition file or include the user
        * name for qnet
        */
-      QString *p_chooserName;
-      QString *p_dateTime;
+      QString p_chooserName;
+      QString p_dateTime;
       bool p_editLock;        //!< If true do not edit anything in measure.
       bool p_ignore;
       bool p_jigsawRejected;  //!< Status of measure for last bundle adjust iteration
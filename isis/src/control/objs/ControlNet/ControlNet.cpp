@@ -285,6 +285,9 @@ namespace Isis {
       progress->CheckStatus();
     }
 
+    points->reserve(points->size() + numPoints);
+    pointIds->reserve(pointIds->size() + numPoints);
+
     for (int i = 0; i < numPoints; i++) {
       AddPoint( versionedReader.takeFirstPoint() );
       if (progress) {
@@ -11,8 +11,18 @@ find files of those names at the top level of this repository. **/
 #include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/numeric/ublas/io.hpp>
 
+#include <numeric>
+
 #include <QDebug>
+#include <QFile>
+#include <QFuture>
+#include <QMap>
+#include <QAtomicInt>
+#include <QMutex>
 #include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
 
 #include "ControlNetFileHeaderV0002.pb.h"
 #include "ControlNetFileHeaderV0005.pb.h"
@@ -93,6 +103,25 @@ namespace Isis {
   }
 
 
+  /**
+   * Construct a streaming ControlNetVersioner from a file. The header is read in like the
+   * other file constructor, but each ControlPoint is given to the visitor, in file order, and
+   * deleted right after instead of being kept. Binary networks are read a batch of points at a
+   * time, so only a batch of ControlPoints is ever in memory. Pvl networks are read whole and
+   * then visited. The versioner holds no points afterwards.
+   *
+   * @param netFile The control network file to read in.
+   * @param visitor The function to give each point to. It returns false to stop reading
+   *                the network.
+   * @param progress The progress object to track reading points.
+   */
+  ControlNetVersioner::ControlNetVersioner(const FileName netFile, PointVisitor visitor,
+                                           Progress *progress)
+      : m_pointVisitor(visitor), m_ownsPoints(true) {
+    read(netFile, progress);
+  }
+
+
   /**
    * Destroy a ControlNetVersioner. If the versioner owns the control points stored in it,
    * they will also be deleted.
@@ -565,6 +594,13 @@ namespace Isis {
         QString msg = "Could not determine the control network file type";
         throw IException(IException::Io, msg, _FILEINFO_);
       }
+
+      // Only binary V0005 networks are streamed; visit the points of the others now
+      if ( m_pointVisitor && !m_points.isEmpty() ) {
+        QVector<ControlPoint *> points = QVector<ControlPoint *>::fromList(m_points);
+        m_points.clear();
+        visitPoints(points);
+      }
     }
     catch (IException &e) {
       QString msg = "Reading the control network [" + netFile.name()
@@ -1219,13 +1255,7 @@ namespace Isis {
       throw IException(e, IException::Io, msg, _FILEINFO_);
     }
 
-    // read each protobuf control point and then initialize it
-    // For some reason, reading the header causes the input stream to fail so reopen the file
     input.close();
-    input.open(netFile.expanded().toLatin1().data(), ios::in | ios::binary);
-    input.seekg(filePos, ios::beg);
-
-    IstreamInputStream pointInStream(&input);
 
     BigInt numberOfPoints = 0;
 
@@ -1242,6 +1272,30 @@ namespace Isis {
       }
     }
 
+    // Map the protobuf control points so that they can be parsed in parallel
+    QFile pointFile(netFile.expanded());
+    if ( !pointFile.open(QIODevice::ReadOnly) ) {
+      QString msg = "Failed to open control network file" + netFile.name();
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    const char *pointData = NULL;
+    if (pointsLength > 0) {
+      pointData = reinterpret_cast<const char *>(pointFile.map(filePos, pointsLength));
+
+      if (!pointData) {
+        QString msg = "Failed to map the control points of control network file ["
+                      + netFile.name() + "] into memory.";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+    }
+
+    // Each point message is preceded by its size as a 32-bit LSB integer.
+    //   The messages are found and then parsed and made into control points
+    //   on the global thread pool. Streaming versioners do this a batch at a
+    //   time so that only one batch of points is in memory at once.
+    const int streamBatchSize = 10000;
+
     if (progress && numberOfPoints != 0) {
       progress->SetText("Reading Control Points...");
       progress->SetMaximumSteps(numberOfPoints);
@@ -1249,46 +1303,189 @@ namespace Isis {
     }
 
     Isis::EndianSwapper lsb("LSB");
-    int pointIndex = -1;
-    while (pointInStream.ByteCount() < pointsLength) {
-      pointIndex += 1;
-      QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
+    BigInt messagePos = 0;
+    int firstPointIndex = 0;
+    bool keepReading = true;
 
-      try {
+    while (keepReading && messagePos < pointsLength) {
+      QVector<BigInt> messageStarts;
+      QVector<uint32_t> messageSizes;
 
-        CodedInputStream pointCodedInStream(&pointInStream);
-        pointCodedInStream.SetTotalBytesLimit(1024 * 1024 * 512);
+      while ( messagePos < pointsLength &&
+              (!m_pointVisitor || messageStarts.size() < streamBatchSize) ) {
+        uint32_t size = 0;
 
-        uint32_t size;
-        pointCodedInStream.ReadRaw(reinterpret_cast<char *>(&size), sizeof(size));
+        if (messagePos + (BigInt)sizeof(size) <= pointsLength) {
+          memcpy(&size, pointData + messagePos, sizeof(size));
+          size = lsb.Uint32_t(&size);
+        }
 
-        size = lsb.Uint32_t(&size);
+        messagePos += sizeof(size);
 
-        CodedInputStream::Limit oldPointLimit = pointCodedInStream.PushLimit(size);
-        newPoint->ParseFromCodedStream(&pointCodedInStream);
-        pointCodedInStream.PopLimit(oldPointLimit);
+        if (messagePos + size > pointsLength) {
+          QString msg = "Failed to read protobuf version 2 control point at index ["
+                        + toString(firstPointIndex + messageStarts.size()) + "].";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        messageStarts.append(messagePos);
+        messageSizes.append(size);
+        messagePos += size;
+      }
+
+      int pointCount = messageStarts.size();
+      QVector<ControlPoint *> points(pointCount, NULL);
+      ControlPoint **createdPoints = points.data();
+      QMap<int, IException> errors;
+      QMutex errorsMutex;
+      QAtomicInt pointsRead(0);
+
+      // Each thread reads a contiguous range of the points and shares strings through its
+      //   own pool, so the threads never wait on each other. The pools are merged once the
+      //   batch is read.
+      int rangeCount = qMax(1, qMin(pointCount, QThreadPool::globalInstance()->maxThreadCount()));
+      QVector< QSet<QString> > rangeStringPools(rangeCount);
+
+      auto readRange = [&](int range) {
+        int firstBatchIndex = (qint64)pointCount * range / rangeCount;
+        int endBatchIndex = (qint64)pointCount * (range + 1) / rangeCount;
+
+        for (int batchIndex = firstBatchIndex; batchIndex < endBatchIndex; batchIndex++) {
+          int pointIndex = firstPointIndex + batchIndex;
+          QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
+
+          if ( !newPoint->ParsePartialFromArray(pointData + messageStarts.at(batchIndex),
+                                                messageSizes.at(batchIndex)) ) {
+            QString msg = "Failed to read protobuf version 2 control point at index ["
+                          + toString(pointIndex) + "].";
+            QMutexLocker locker(&errorsMutex);
+            errors.insert(pointIndex, IException(IException::Io, msg, _FILEINFO_));
+          }
+          else {
+            try {
+              ControlPointV0005 point(newPoint);
+              createdPoints[batchIndex] = createPoint(point, rangeStringPools[range]);
+            }
+            catch (IException &e) {
+              QString msg = "Failed to convert protobuf version 2 control point at index ["
+                            + toString(pointIndex) + "] into a ControlPoint.";
+              QMutexLocker locker(&errorsMutex);
+              errors.insert(pointIndex, IException(e, IException::Io, msg, _FILEINFO_));
+            }
+          }
+
+          pointsRead.fetchAndAddRelaxed(1);
+        }
+      };
+
+      QVector<int> ranges(rangeCount);
+      std::iota(ranges.begin(), ranges.end(), 0);
+      QFuture<void> future = QtConcurrent::map(ranges, readRange);
+
+      if (progress && numberOfPoints != 0) {
+        int reportedProgress = 0;
+        QMutex sleeper;
+        sleeper.lock();
+        while ( !future.isFinished() ) {
+          sleeper.tryLock(100);
+
+          while ( reportedProgress < pointsRead.loadAcquire() ) {
+            progress->CheckStatus();
+            reportedProgress++;
+          }
+        }
+        sleeper.unlock();
+
+        while ( reportedProgress < pointsRead.loadAcquire() ) {
+          progress->CheckStatus();
+          reportedProgress++;
+        }
       }
-      catch (...) {
-        QString msg = "Failed to read protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "].";
-        throw IException(IException::Io, msg, _FILEINFO_);
+      else {
+        future.waitForFinished();
       }
 
-      try {
-        ControlPointV0005 point(newPoint);
-        m_points.append( createPoint(point) );
+      if ( !errors.isEmpty() ) {
+        qDeleteAll(points);
+        throw errors.first();
+      }
 
-        if (progress && numberOfPoints != 0) {
-          progress->CheckStatus();
+      if (m_pointVisitor) {
+        keepReading = visitPoints(points);
+      }
+      else {
+        m_points.reserve(m_points.size() + pointCount);
+        for (int i = 0; i < pointCount; i++) {
+          m_points.append(points[i]);
         }
 
+        // Later batches share the strings of this one
+        for (int range = 0; range < rangeCount; range++) {
+          m_stringPool.unite(rangeStringPools[range]);
+        }
       }
-      catch (IException &e) {
-        QString msg = "Failed to convert protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "] into a ControlPoint.";
-        throw IException(e, IException::Io, msg, _FILEINFO_);
+
+      firstPointIndex += pointCount;
+    }
+  }
+
+
+  /**
+   * Get a string with the same text as a string read from a file that shares its data with
+   * every other string of that text read by this versioner. Serial numbers, chooser names and
+   * date times repeat across most of the measures in a network, so this keeps one copy of
+   * each instead of one per measure. Strings read before are found in the versioner's pool,
+   * and new strings are added to the given pool. Threads reading at the same time each use
+   * their own pool, which is merged into the versioner's pool afterwards, so a string first
+   * read by several threads has one copy per thread.
+   *
+   * @param value The string read from a file.
+   * @param stringPool The pool new strings are added to. This is either the versioner's
+   *                   pool or a pool only used by the calling thread.
+   *
+   * @return @b QString The shared string.
+   */
+  QString ControlNetVersioner::sharedString(const std::string &value,
+                                            QSet<QString> &stringPool) {
+    QString string = QString::fromUtf8( value.data(), int(value.size()) );
+
+    QSet<QString>::const_iterator shared = m_stringPool.constFind(string);
+    if ( shared != m_stringPool.constEnd() ) {
+      return *shared;
+    }
+
+    return *stringPool.insert(string);
+  }
+
+
+  /**
+   * Give points to the visitor of a streaming versioner, in order, and delete them. Once the
+   * visitor asks to stop, the rest of the points are only deleted.
+   *
+   * @param points The points to visit. They are all deleted.
+   *
+   * @return @b bool If the visitor wants more points.
+   */
+  bool ControlNetVersioner::visitPoints(QVector<ControlPoint *> points) {
+    bool keepReading = true;
+    int pointIndex = 0;
+
+    try {
+      for (; pointIndex < points.size(); pointIndex++) {
+        if (keepReading) {
+          keepReading = m_pointVisitor(*points[pointIndex]);
+        }
+        delete points[pointIndex];
+      }
+    }
+    catch (...) {
+      for (; pointIndex < points.size(); pointIndex++) {
+        delete points[pointIndex];
       }
+      throw;
     }
+
+    return keepReading;
   }
 
 
@@ -1340,6 +1537,21 @@ namespace Isis {
    * @return @b ControlPoint* The ControlPoint constructed from the given point.
    */
   ControlPoint *ControlNetVersioner::createPoint(ControlPointV0003 &point) {
+    return createPoint(point, m_stringPool);
+  }
+
+
+  /**
+   * Create a pointer to a latest version ControlPoint from an object in a V0003 control net
+   * file, sharing its strings through the given pool. See sharedString.
+   *
+   * @param point The versioned control point to be updated.
+   * @param stringPool The pool new strings read from the point are added to.
+   *
+   * @return @b ControlPoint* The ControlPoint constructed from the given point.
+   */
+  ControlPoint *ControlNetVersioner::createPoint(ControlPointV0003 &point,
+                                                 QSet<QString> &stringPool) {
 
     ControlPointFileEntryV0002 protoPoint = point.pointData();
     ControlPoint *controlPoint = new ControlPoint;
@@ -1348,7 +1560,7 @@ namespace Isis {
     controlPoint->SetId(QString(protoPoint.id().c_str()));
 
     if ( protoPoint.has_choosername() ) {
-      controlPoint->SetChooserName(protoPoint.choosername().c_str());
+      controlPoint->SetChooserName(sharedString(protoPoint.choosername(), stringPool));
     }
 
     // point type is required, no need for if statement here
@@ -1513,7 +1725,7 @@ namespace Isis {
 
     // adding measure information
     for (int m = 0 ; m < protoPoint.measures_size(); m++) {
-      controlPoint->Add( createMeasure( protoPoint.measures(m) ) );
+      controlPoint->Add( createMeasure( protoPoint.measures(m), stringPool ) );
     }
 
     if ( protoPoint.has_referenceindex() ) {
@@ -1522,7 +1734,7 @@ namespace Isis {
 
     // Set DateTime after calling all setters that clear DateTime value
     if ( protoPoint.has_datetime() ) {
-      controlPoint->SetDateTime(protoPoint.datetime().c_str());
+      controlPoint->SetDateTime(sharedString(protoPoint.datetime(), stringPool));
     }
     // Set edit lock last
     if ( protoPoint.has_editlock() ) {
@@ -1538,17 +1750,19 @@ namespace Isis {
    * Create a pointer to a ControlMeasure from a V0006 file.
    *
    * @param measure The versioned control measure to be created.
+   * @param stringPool The pool new strings read from the measure are added to.
    *
    * @return The ControlMeasure constructed from the V0006 version
    *         file.
    */
   ControlMeasure *ControlNetVersioner::createMeasure(
-                                             const ControlPointFileEntryV0002_Measure &measure) {
+                                             const ControlPointFileEntryV0002_Measure &measure,
+                                             QSet<QString> &stringPool) {
 
     ControlMeasure *newMeasure = new ControlMeasure;
 
     // serial number is required, no need for if-statement
-    newMeasure->SetCubeSerialNumber(QString(measure.serialnumber().c_str()));
+    newMeasure->SetCubeSerialNumber(sharedString(measure.serialnumber(), stringPool));
 
     // measure type is required, no need for if-statement
     ControlMeasure::MeasureType measureType;
@@ -1615,11 +1829,11 @@ namespace Isis {
     }
 
     if ( measure.has_choosername() ) {
-      newMeasure->SetChooserName(QString(measure.choosername().c_str()));
+      newMeasure->SetChooserName(sharedString(measure.choosername(), stringPool));
     }
 
     if ( measure.has_datetime() ) {
-      newMeasure->SetDateTime(QString(measure.datetime().c_str()));
+      newMeasure->SetDateTime(sharedString(measure.datetime(), stringPool));
     }
 
     // It is VERY important that the edit lock flag is set last because it prevents
@@ -9,9 +9,13 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <functional>
+#include <string>
+
 #include <QString>
 
 #include <QList>
+#include <QSet>
 #include <QSharedPointer>
 #include <QVector>
 
@@ -412,8 +416,16 @@ namespace Isis {
   class ControlNetVersioner {
 
     public:
+      /**
+       * A function that is given each ControlPoint of a network that is streamed from a file.
+       * The point is deleted once the function returns. Returning false stops reading.
+       */
+      typedef std::function<bool(const ControlPoint &)> PointVisitor;
+
       ControlNetVersioner(ControlNet *net);
       ControlNetVersioner(const FileName netFile, Progress *progress=NULL);
+      ControlNetVersioner(const FileName netFile, PointVisitor visitor,
+                          Progress *progress=NULL);
       ~ControlNetVersioner();
 
       QString netId() const;
@@ -505,8 +517,13 @@ namespace Isis {
       ControlPoint *createPoint(ControlPointV0001 &point);
       ControlPoint *createPoint(ControlPointV0002 &point);
       ControlPoint *createPoint(ControlPointV0003 &point);
+      ControlPoint *createPoint(ControlPointV0003 &point, QSet<QString> &stringPool);
+
+      ControlMeasure *createMeasure(const ControlPointFileEntryV0002_Measure&,
+                                    QSet<QString> &stringPool);
 
-      ControlMeasure *createMeasure(const ControlPointFileEntryV0002_Measure&);
+      bool visitPoints(QVector<ControlPoint *> points);
+      QString sharedString(const std::string &value, QSet<QString> &stringPool);
 
       void createHeader(const ControlNetHeaderV0001 header);
 
@@ -517,6 +534,11 @@ namespace Isis {
                                            the whole network.*/
       QList<ControlPoint *> m_points; /**< ControlPoints that are read in from a file or
                                            ready to be written out to a file.*/
+      PointVisitor m_pointVisitor; /**< The function points are streamed to, if this
+                                        versioner was created to stream a file.*/
+      QSet<QString> m_stringPool; /**< The strings read in so far that are shared by the
+                                       measures and points that have the same text. It is
+                                       only read while points are read in parallel.*/
       bool m_ownsPoints; /**< Flag if the versioner owns the control points stored in it.
                              This will be true when the versioner created the points from a file.
                              This will be false when the versioner copied the points from an
@@ -244,7 +244,7 @@ namespace Isis {
       }
 
       // compute correlations
-      QMapIterator<int, LinearAlgebra::Matrix *> block(sbcm);
+      SparseBlockMapIterator block(sbcm);
 
       while ( block.hasNext() ) { // each block in the column
         block.next();
@@ -432,7 +432,7 @@ namespace Isis {
     QMapIterator<QString, QStringList> rowIterator( *corrMatrix.imagesAndParameters() );
     
     foreach ( SparseBlockColumnMatrix blockColumn, *( corrMatrix.visibleBlocks() ) ) {
-      QMapIterator<int, matrix<double>*> block(blockColumn);
+      SparseBlockMapIterator block(blockColumn);
       bool lastBlock = true;
       block.toBack(); // moves iterator to AFTER the last item
       colIterator.next();
@@ -0,0 +1,250 @@
+#include <cmath>
+
+#include <QVector>
+
+#include "Buffer.h"
+#include "Calculator.h"
+#include "CalculatorProgram.h"
+#include "IException.h"
+#include "InlineCalculator.h"
+#include "SpecialPixel.h"
+#include "TestUtilities.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+class CalculatorProgramBuffer : public ::testing::Test {
+  protected:
+    Buffer *buffer;
+    QVector<double> samples;
+
+    void SetUp() override {
+      // Longer than one block so the blocks and their remainder are both used
+      buffer = new Buffer(600, 1, 1, Real);
+      samples.resize(600);
+      for (int i = 0; i < 600; i++) {
+        (*buffer)[i] = (i % 7) - 2.5;
+        samples[i] = i + 1;
+      }
+      (*buffer)[3] = Null;
+      (*buffer)[4] = Lrs;
+      (*buffer)[300] = Lis;
+      (*buffer)[599] = Null;
+    }
+
+    void TearDown() override {
+      delete buffer;
+    }
+};
+
+
+TEST_F(CalculatorProgramBuffer, MatchesCalculator) {
+  // ((f1 * 2 + sample) - linemax(f1)) >> 1
+  Calculator calculator;
+  calculator.Push(*buffer);
+  calculator.Push(2.0);
+  calculator.Multiply();
+  calculator.Push(samples);
+  calculator.Add();
+  calculator.Push(*buffer);
+  calculator.MaximumLine();
+  calculator.Subtract();
+  calculator.Push(1.0);
+  calculator.RightShift();
+  QVector<double> expected = calculator.Pop(true);
+
+  CalculatorProgram program;
+  program.pushInput(0);
+  program.pushConstant(2.0);
+  program.pushOperator(CalculatorProgram::Multiply);
+  program.pushInput(1);
+  program.pushOperator(CalculatorProgram::Add);
+  program.pushInput(0);
+  program.pushOperator(CalculatorProgram::MaximumLine);
+  program.pushOperator(CalculatorProgram::Subtract);
+  program.pushConstant(1.0);
+  program.pushOperator(CalculatorProgram::RightShift);
+  ASSERT_TRUE(program.isValid());
+
+  program.setInput(0, buffer->DoubleBuffer(), buffer->size(), true);
+  program.setInput(1, samples.constData(), samples.size());
+  QVector<double> results = program.evaluate();
+
+  ASSERT_EQ(results.size(), expected.size());
+  for (int i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i], expected[i]) << "sample " << i + 1;
+  }
+  EXPECT_EQ(results[0], Null);
+  EXPECT_EQ(results[4], Null);
+  EXPECT_EQ(results[5], Lrs);
+}
+
+
+TEST_F(CalculatorProgramBuffer, MatchesCalculatorFunctions) {
+  // min(sqrt(f1), cos(sample)) + (f1 >= 0) - (sample % 3) * log(abs(f1))
+  Calculator calculator;
+  calculator.Push(*buffer);
+  calculator.SquareRoot();
+  calculator.Push(samples);
+  calculator.Cosine();
+  calculator.MinimumPixel();
+  calculator.Push(*buffer);
+  calculator.Push(0.0);
+  calculator.GreaterThanOrEqual();
+  calculator.Add();
+  calculator.Push(samples);
+  calculator.Push(3.0);
+  calculator.Modulus();
+  calculator.Push(*buffer);
+  calculator.AbsoluteValue();
+  calculator.Log();
+  calculator.Multiply();
+  calculator.Subtract();
+  QVector<double> expected = calculator.Pop(true);
+
+  CalculatorProgram program;
+  program.pushInput(0);
+  program.pushOperator(CalculatorProgram::SquareRoot);
+  program.pushInput(1);
+  program.pushOperator(CalculatorProgram::Cosine);
+  program.pushOperator(CalculatorProgram::MinimumPixel);
+  program.pushInput(0);
+  program.pushConstant(0.0);
+  program.pushOperator(CalculatorProgram::GreaterThanOrEqual);
+  program.pushOperator(CalculatorProgram::Add);
+  program.pushInput(1);
+  program.pushConstant(3.0);
+  program.pushOperator(CalculatorProgram::Modulus);
+  program.pushInput(0);
+  program.pushOperator(CalculatorProgram::AbsoluteValue);
+  program.pushOperator(CalculatorProgram::Log);
+  program.pushOperator(CalculatorProgram::Multiply);
+  program.pushOperator(CalculatorProgram::Subtract);
+  ASSERT_TRUE(program.isValid());
+
+  program.setInput(0, buffer->DoubleBuffer(), buffer->size(), true);
+  program.setInput(1, samples.constData(), samples.size());
+  QVector<double> results = program.evaluate();
+
+  ASSERT_EQ(results.size(), expected.size());
+  for (int i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i], expected[i]) << "sample " << i + 1;
+  }
+}
+
+
+TEST(CalculatorProgramTests, ScalarEquation) {
+  CalculatorProgram program;
+  program.pushInput(0);
+  program.pushConstant(2.0);
+  program.pushOperator(CalculatorProgram::Exponent);
+  program.pushInput(1);
+  program.pushOperator(CalculatorProgram::Negative);
+  program.pushOperator(CalculatorProgram::Add);
+  program.setInput(0, 3.0);
+  program.setInput(1, 4.0);
+
+  QVector<double> results = program.evaluate();
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0], 5.0);
+
+  program.setInput(0, 1.0);
+  results = program.evaluate();
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0], -3.0);
+}
+
+
+TEST(CalculatorProgramTests, IncompleteEquation) {
+  CalculatorProgram program;
+  program.pushConstant(1.0);
+  program.pushOperator(CalculatorProgram::Add);
+  EXPECT_FALSE(program.isValid());
+
+  program.clear();
+  program.pushConstant(1.0);
+  program.pushConstant(2.0);
+  EXPECT_FALSE(program.isValid());
+
+  QString message = "The calculator program is not a complete equation";
+  try {
+    program.evaluate();
+    FAIL() << "Expected an exception";
+  }
+  catch(IException &e) {
+    EXPECT_THAT(e.toString().toStdString(), ::testing::HasSubstr(message.toStdString()));
+  }
+}
+
+
+TEST(CalculatorProgramTests, DifferingSizes) {
+  QVector<double> first(10, 1.0);
+  QVector<double> second(11, 2.0);
+
+  CalculatorProgram program;
+  program.pushInput(0);
+  program.pushInput(1);
+  program.pushOperator(CalculatorProgram::Add);
+  program.setInput(0, first.constData(), first.size());
+  program.setInput(1, second.constData(), second.size());
+
+  QString message = "cannot operate on vectors of differing sizes";
+  try {
+    program.evaluate();
+    FAIL() << "Expected an exception";
+  }
+  catch(IException &e) {
+    EXPECT_THAT(e.toString().toStdString(), ::testing::HasSubstr(message.toStdString()));
+  }
+}
+
+
+/**
+ * Provides the values of a single variable to an InlineCalculator.
+ */
+class SingleVariablePool : public CalculatorVariablePool {
+  public:
+    SingleVariablePool(const QString &name, const QVector<double> &values) :
+        m_name(name), m_values(values) {
+    }
+
+    bool exists(const QString &variable) const override {
+      return (variable == m_name);
+    }
+
+    QVector<double> value(const QString &variable, const int &index = 0) const override {
+      return (m_values);
+    }
+
+  private:
+    QString m_name;
+    QVector<double> m_values;
+};
+
+
+TEST(CalculatorProgramTests, InlineCalculatorVariables) {
+  QVector<double> values;
+  for (int i = 0; i < 300; i++) {
+    values.push_back(i);
+  }
+  SingleVariablePool pool("x", values);
+
+  InlineCalculator calculator("max(x * 2, 100) - fmod(x, 7) + pi");
+  QVector<double> results = calculator.evaluate(&pool);
+
+  ASSERT_EQ(results.size(), values.size());
+  for (int i = 0; i < values.size(); i++) {
+    EXPECT_DOUBLE_EQ(results[i], std::max(values[i] * 2, 100.0) - fmod(values[i], 7) + M_PI);
+  }
+
+  SingleVariablePool missing("y", values);
+  try {
+    calculator.evaluate(&missing);
+    FAIL() << "Expected an exception";
+  }
+  catch(IException &e) {
+    EXPECT_THAT(e.toString().toStdString(),
+                ::testing::HasSubstr("Could not find variable [x] in variable pool."));
+  }
+}
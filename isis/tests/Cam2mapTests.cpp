@@ -3,9 +3,11 @@
 
 #include "cam2map.h"
 
+#include "Camera.h"
 #include "Cube.h"
 #include "CubeAttribute.h"
 #include "IException.h"
+#include "IString.h"
 #include "PixelType.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
@@ -492,3 +494,166 @@ TEST_F(DefaultCube, FunctionalTestCam2mapReverseMock) {
   EXPECT_CALL(rs, EndProcess).Times(AtLeast(1));
   cam2map(testCube, userMap, userGrp, rs, ui, &log);
 }
+
+namespace {
+  /**
+   * A quadratic output to input transform that fails past a sample, which
+   * the approximation must reproduce everywhere.
+   */
+  class QuadraticTransform : public Transform {
+    public:
+      QuadraticTransform(double maxSample) : m_maxSample(maxSample) {}
+
+      int OutputSamples() const {
+        return 600;
+      }
+
+      int OutputLines() const {
+        return 500;
+      }
+
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine) {
+        if (outSample > m_maxSample) {
+          return false;
+        }
+        inSample = 3.0 + 0.8 * outSample + 0.0001 * outSample * outSample + 0.05 * outLine;
+        inLine = 7.0 + 0.9 * outLine - 0.0002 * outSample * outLine;
+        return true;
+      }
+
+    private:
+      double m_maxSample;
+  };
+}
+
+TEST(Cam2map, ApproximateXformUnitTestCam2map) {
+  QuadraticTransform exact(450.0);
+  cam2mapApproximate approximation(new QuadraticTransform(450.0), 2000, 2000, 0.01);
+
+  EXPECT_EQ(approximation.OutputSamples(), 600);
+  EXPECT_EQ(approximation.OutputLines(), 500);
+
+  for (int line = 1; line <= 500; line += 7) {
+    for (int sample = 1; sample <= 600; sample += 3) {
+      double exactSample, exactLine;
+      double inSample, inLine;
+      bool exactValid = exact.Xform(exactSample, exactLine, sample, line);
+      ASSERT_EQ(approximation.Xform(inSample, inLine, sample, line), exactValid)
+          << "Sample " << sample << ", line " << line;
+      if (exactValid) {
+        EXPECT_NEAR(inSample, exactSample, 1e-8);
+        EXPECT_NEAR(inLine, exactLine, 1e-8);
+      }
+    }
+  }
+
+  PvlGroup statistics = approximation.statistics();
+  EXPECT_EQ(statistics.name(), "Approximation");
+  EXPECT_DOUBLE_EQ(toDouble(statistics["Tolerance"][0]), 0.01);
+  EXPECT_LT(toDouble(statistics["MaximumSpotCheckError"][0]), 1e-8);
+  EXPECT_GT(toInt(statistics["InterpolatedCells"][0]), 0);
+  EXPECT_GT(toInt(statistics["ExactCells"][0]), 0);
+  EXPECT_GT(toInt(statistics["ExactEvaluations"][0]), 0);
+}
+
+TEST_F(LineScannerCube, FunctionalTestCam2mapLineScanApproximateMock) {
+  std::istringstream labelStrm(R"(
+    Group = Mapping
+      ProjectionName     = Sinusoidal
+      CenterLongitude    = 338.43365399713
+      TargetName         = MOON
+      EquatorialRadius   = 1737400.0 <meters>
+      PolarRadius        = 1737400.0 <meters>
+      LatitudeType       = Planetocentric
+      LongitudeDirection = PositiveEast
+      LongitudeDomain    = 360
+      MinimumLatitude    = 11.463745149835
+      MaximumLatitude    = 11.476785565832
+      MinimumLongitude   = 337.81781569041
+      MaximumLongitude   = 339.04949230384
+      UpperLeftCornerX   = -18307.842628129 <meters>
+      UpperLeftCornerY   = 348018.60964676 <meters>
+      PixelResolution    = 8.926300647552 <meters/pixel>
+      Scale              = 3397.0792180819 <pixels/degree>
+    End_Group
+  )");
+
+  Pvl userMap;
+  labelStrm >> userMap;
+  PvlGroup &userGrp = userMap.findGroup("Mapping", Pvl::Traverse);
+
+  QVector<QString> args = {"to=" + tempDir.path() + "/level2.cub", "matchmap=yes",
+                           "approximate=yes", "tolerance=0.05"};
+
+  UserInterface ui(APP_XML, args);
+
+  Pvl log;
+  MockProcessRubberSheet rs;
+  FileName fn(tempDir.path() + "/level2.cub");
+  CubeAttributeOutput outputAttr(fn);
+  Cube outputCube;
+  outputCube.setDimensions(1, 1, 1);
+  outputCube.create(fn.expanded(), outputAttr);
+  outputCube.reopen("rw");
+
+  EXPECT_CALL(rs, SetInputCube(testCube, 0)).Times(AtLeast(1));
+  EXPECT_CALL(rs, SetOutputCube).Times(AtLeast(1)).WillOnce(Return(&outputCube));
+  EXPECT_CALL(rs, processPatchTransform).Times(0);
+  EXPECT_CALL(rs, StartProcess).Times(AtLeast(1));
+  EXPECT_CALL(rs, EndProcess).Times(AtLeast(1));
+
+  cam2map(testCube, userMap, userGrp, rs, ui, &log);
+
+  ASSERT_TRUE(log.hasGroup("Approximation"));
+  PvlGroup &approximation = log.findGroup("Approximation");
+  EXPECT_DOUBLE_EQ(toDouble(approximation["Tolerance"][0]), 0.05);
+  EXPECT_LE(toDouble(approximation["MaximumSpotCheckError"][0]), 0.05);
+}
+
+namespace {
+  void cam2mapWithCamera(Cube *cube, QString outPath, QString warpAlgorithm) {
+    std::istringstream labelStrm(R"(
+      Group = Mapping
+        ProjectionName     = Sinusoidal
+        CenterLongitude    = 256.0 <degrees>
+        TargetName         = MARS
+        EquatorialRadius   = 3396190.0 <meters>
+        PolarRadius        = 3376200.0 <meters>
+        LatitudeType       = Planetocentric
+        LongitudeDirection = PositiveEast
+        LongitudeDomain    = 360 <degrees>
+      End_Group
+    )");
+
+    Pvl userMap;
+    labelStrm >> userMap;
+    PvlGroup &userGrp = userMap.findGroup("Mapping", Pvl::Traverse);
+
+    QVector<QString> args = {"to=" + outPath, "pixres=mpp", "resolution=200",
+                             "defaultrange=camera", "warpalgorithm=" + warpAlgorithm};
+    UserInterface ui(APP_XML, args);
+
+    Pvl log;
+    cam2map(cube, userMap, userGrp, ui, &log);
+  }
+}
+
+TEST_F(ThreadedRubberSheetCube, FunctionalTestCam2mapThreaded) {
+  // The clones of this camera are evaluated without the NAIF lock
+  ASSERT_TRUE(testCube->camera()->evaluatesWithoutNaif());
+
+  QString warpAlgorithms[2] = {"reversepatch", "forwardpatch"};
+  for (int i = 0; i < 2; i++) {
+    QString serialPath = tempDir.path() + "/serial" + warpAlgorithms[i] + ".cub";
+    QString threadedPath = tempDir.path() + "/threaded" + warpAlgorithms[i] + ".cub";
+
+    setRubberSheetTransforms("Serial");
+    cam2mapWithCamera(testCube, serialPath, warpAlgorithms[i]);
+
+    setRubberSheetTransforms("Threaded");
+    cam2mapWithCamera(testCube, threadedPath, warpAlgorithms[i]);
+
+    compareCubes(serialPath, threadedPath);
+  }
+}
@@ -12,10 +12,12 @@
 #include "Cube.h"
 #include "FileName.h"
 #include "LineManager.h"
+#include "Preference.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "PvlKeyword.h"
 #include "PvlObject.h"
+#include "SpecialPixel.h"
 #include "Table.h"
 #include "TableField.h"
 #include "TableRecord.h"
@@ -988,4 +990,61 @@ namespace Isis {
     testCube.reset();
   }
 
+
+  void ThreadedRubberSheetCube::SetUp() {
+    DefaultCube::SetUp();
+
+    PvlGroup &performance = Preference::Preferences(true).findGroup("Performance");
+    if (performance.hasKeyword("RubberSheetTransforms")) {
+      originalTransforms = performance["RubberSheetTransforms"][0];
+    }
+  }
+
+
+  void ThreadedRubberSheetCube::TearDown() {
+    PvlGroup &performance = Preference::Preferences(true).findGroup("Performance");
+    if (originalTransforms.isEmpty()) {
+      if (performance.hasKeyword("RubberSheetTransforms")) {
+        performance.deleteKeyword("RubberSheetTransforms");
+      }
+    }
+    else {
+      setRubberSheetTransforms(originalTransforms);
+    }
+
+    DefaultCube::TearDown();
+  }
+
+
+  void ThreadedRubberSheetCube::setRubberSheetTransforms(QString value) {
+    Preference::Preferences(true).findGroup("Performance")
+        .addKeyword(PvlKeyword("RubberSheetTransforms", value), PvlContainer::Replace);
+  }
+
+
+  void ThreadedRubberSheetCube::compareCubes(QString serialPath, QString threadedPath) {
+    Cube serialCube(serialPath);
+    Cube threadedCube(threadedPath);
+    ASSERT_EQ(serialCube.sampleCount(), threadedCube.sampleCount());
+    ASSERT_EQ(serialCube.lineCount(), threadedCube.lineCount());
+    ASSERT_EQ(serialCube.bandCount(), threadedCube.bandCount());
+
+    LineManager serialLine(serialCube);
+    LineManager threadedLine(threadedCube);
+    int validPixels = 0;
+    for (serialLine.begin(), threadedLine.begin(); !serialLine.end(); serialLine++, threadedLine++) {
+      serialCube.read(serialLine);
+      threadedCube.read(threadedLine);
+      for (int i = 0; i < serialLine.size(); i++) {
+        ASSERT_EQ(serialLine[i], threadedLine[i])
+            << "Line " << serialLine.Line() << ", band " << serialLine.Band()
+            << ", sample " << i + 1;
+        if (!IsSpecial(serialLine[i])) {
+          validPixels++;
+        }
+      }
+    }
+    EXPECT_GT(validPixels, 0);
+  }
+
 }
\ No newline at end of file
@@ -178,6 +178,20 @@ namespace Isis {
       void TearDown() override;
   };
 
+  /**
+   * The DefaultCube for comparing Serial and Threaded ProcessRubberSheet
+   * outputs. TearDown restores the RubberSheetTransforms preference.
+   */
+  class ThreadedRubberSheetCube : public DefaultCube {
+    protected:
+      QString originalTransforms;
+
+      void SetUp() override;
+      void TearDown() override;
+      void setRubberSheetTransforms(QString value);
+      void compareCubes(QString serialPath, QString threadedPath);
+  };
+
 }
 
 #endif
\ No newline at end of file
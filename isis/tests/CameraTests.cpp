@@ -1,5 +1,10 @@
+#include <functional>
 #include <iostream>
+#include <QPair>
 #include <QTemporaryFile>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
 
 
 #include "Cube.h"
@@ -12,6 +17,10 @@
 #include "TestUtilities.h"
 #include "FileName.h"
 #include "Camera.h"
+#include "Distance.h"
+#include "ShapeModel.h"
+#include "SpecialPixel.h"
+#include "Target.h"
 #include "CameraFixtures.h"
 
 using namespace Isis;
@@ -37,3 +46,94 @@ TEST_F(DemCube, CameraObliqueResolution) {
     EXPECT_NEAR(c->ObliqueDetectorResolution(false), 19.2788, 1e-4);
     EXPECT_NEAR(c->ObliqueDetectorResolution(), 19.3449, 1e-4);
 }
+
+
+TEST_F(DemCube, CameraClone) {
+  Camera *cam = testCube->camera();
+  cam->SetBand(1);
+
+  Camera *clone = cam->clone(*testCube);
+  ASSERT_NE(clone, cam);
+  EXPECT_EQ(clone->Band(), cam->Band());
+  EXPECT_EQ(clone->target()->shape()->name(), cam->target()->shape()->name());
+
+  ASSERT_TRUE(cam->SetImage(600, 500));
+  double latitude = cam->UniversalLatitude();
+  double longitude = cam->UniversalLongitude();
+  double radius = cam->LocalRadius().meters();
+
+  // Moving the clone does not move the original
+  ASSERT_TRUE(clone->SetImage(1, 1));
+  EXPECT_DOUBLE_EQ(cam->UniversalLatitude(), latitude);
+  EXPECT_DOUBLE_EQ(cam->UniversalLongitude(), longitude);
+
+  ASSERT_TRUE(clone->SetImage(600, 500));
+  EXPECT_DOUBLE_EQ(clone->UniversalLatitude(), latitude);
+  EXPECT_DOUBLE_EQ(clone->UniversalLongitude(), longitude);
+  EXPECT_DOUBLE_EQ(clone->LocalRadius().meters(), radius);
+
+  ASSERT_TRUE(clone->SetUniversalGround(latitude, longitude));
+  EXPECT_NEAR(clone->Sample(), 600, 1e-3);
+  EXPECT_NEAR(clone->Line(), 500, 1e-3);
+
+  delete clone;
+}
+
+
+// Clones of a camera with cached SPICE and a DEM are evaluated on several threads at once, without
+// the NAIF mutex, and must give what the original camera gives when evaluated serially
+TEST_F(DemCube, CameraClonesOnThreads) {
+  Camera *cam = testCube->camera();
+  ASSERT_TRUE(cam->evaluatesWithoutNaif());
+
+  QVector< QPair<double, double> > imagePoints;
+  for (int line = 1; line <= testCube->lineCount(); line += 97) {
+    for (int sample = 1; sample <= testCube->sampleCount(); sample += 89) {
+      imagePoints.append(qMakePair(sample + 0.25, line + 0.75));
+    }
+  }
+
+  QVector<double> expected;
+  for (const QPair<double, double> &imagePoint : imagePoints) {
+    if (cam->SetImage(imagePoint.first, imagePoint.second)) {
+      expected << cam->UniversalLatitude() << cam->UniversalLongitude()
+               << cam->LocalRadius().meters() << cam->IncidenceAngle();
+    }
+    else {
+      expected << Null << Null << Null << Null;
+    }
+  }
+
+  const int threads = 4;
+  QList<Camera *> clones;
+  for (int i = 0; i < threads; i++) {
+    clones.append(cam->clone(*testCube));
+  }
+
+  int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(threads, maxThreads));
+  QList< QVector<double> > results = QtConcurrent::blockingMapped< QList< QVector<double> > >(
+      clones, std::function<QVector<double>(Camera *const &)>([&](Camera *const &clone) {
+        QVector<double> values;
+        for (const QPair<double, double> &imagePoint : imagePoints) {
+          if (clone->SetImage(imagePoint.first, imagePoint.second)) {
+            values << clone->UniversalLatitude() << clone->UniversalLongitude()
+                   << clone->LocalRadius().meters() << clone->IncidenceAngle();
+          }
+          else {
+            values << Null << Null << Null << Null;
+          }
+        }
+        return values;
+      }));
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+  qDeleteAll(clones);
+
+  ASSERT_EQ(results.size(), threads);
+  for (int i = 0; i < threads; i++) {
+    ASSERT_EQ(results[i].size(), expected.size());
+    for (int j = 0; j < expected.size(); j++) {
+      EXPECT_DOUBLE_EQ(results[i][j], expected[j]) << "Clone " << i << ", value " << j;
+    }
+  }
+}
@@ -0,0 +1,72 @@
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlNetVersioner.h"
+#include "ControlPoint.h"
+#include "FileName.h"
+
+#include "NetworkFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+TEST_F(ThreeImageNetwork, ControlNetVersionerStreamPoints) {
+  QString binaryPath = tempDir.path() + "/streamed.net";
+  QString pvlPath = tempDir.path() + "/streamed.pvl";
+  network->Write(binaryPath);
+  network->Write(pvlPath, true);
+
+  QList<QString> expectedIds = network->GetPointIds();
+  ASSERT_GT(expectedIds.size(), 1);
+
+  foreach (QString netPath, QList<QString>() << binaryPath << pvlPath) {
+    QList<QString> streamedIds;
+    int streamedMeasures = 0;
+    ControlNetVersioner streamer(FileName(netPath),
+                                 [&](const ControlPoint &point) {
+                                   streamedIds.append(point.GetId());
+                                   streamedMeasures += point.GetNumMeasures();
+                                   return true;
+                                 });
+
+    EXPECT_EQ(streamedIds, expectedIds) << netPath.toStdString();
+    EXPECT_EQ(streamedMeasures, network->GetNumMeasures()) << netPath.toStdString();
+    EXPECT_EQ(streamer.numPoints(), 0);
+    EXPECT_EQ(streamer.netId(), network->GetNetworkId());
+
+    QList<QString> firstId;
+    ControlNetVersioner stopped(FileName(netPath),
+                                [&](const ControlPoint &point) {
+                                  firstId.append(point.GetId());
+                                  return false;
+                                });
+
+    ASSERT_EQ(firstId.size(), 1);
+    EXPECT_EQ(firstId.first(), expectedIds.first());
+  }
+}
+
+
+TEST_F(ThreeImageNetwork, ControlNetVersionerSharesMeasureStrings) {
+  QString netPath = tempDir.path() + "/shared.net";
+  network->Write(netPath);
+
+  ControlNet readNet(netPath);
+  ASSERT_EQ(readNet.GetNumMeasures(), network->GetNumMeasures());
+
+  // Each reading thread keeps its own copy of a serial number
+  foreach (QString serial, readNet.GetCubeSerials()) {
+    QList<ControlMeasure *> measures = readNet.GetMeasuresInCube(serial);
+    QSet<const QChar *> serialBuffers;
+    for (int i = 0; i < measures.size(); i++) {
+      EXPECT_EQ(measures[i]->GetCubeSerialNumber(), serial);
+      serialBuffers.insert(measures[i]->GetCubeSerialNumber().constData());
+    }
+    EXPECT_LE(serialBuffers.size(), QThreadPool::globalInstance()->maxThreadCount());
+  }
+}
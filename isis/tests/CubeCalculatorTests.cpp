@@ -0,0 +1,56 @@
+#include <QVector>
+
+#include "Buffer.h"
+#include "Camera.h"
+#include "CubeCalculator.h"
+#include "CubeInfixToPostfix.h"
+#include "LineManager.h"
+
+#include "CameraFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+// The center angle and a per pixel angle of the same camera in one equation, with the
+// per pixel angle used twice
+TEST_F(DefaultCube, CubeCalculatorCameraBackplanes) {
+  QVector<Cube *> cubes;
+  cubes.push_back(testCube);
+
+  CubeInfixToPostfix infixToPostfix;
+  CubeCalculator difference;
+  difference.prepareCalculations(infixToPostfix.convert("pha(f1) - phac(f1)"), cubes, testCube);
+  CubeCalculator twice;
+  twice.prepareCalculations(infixToPostfix.convert("pha(f1) + pha(f1)"), cubes, testCube);
+
+  Camera *cam = testCube->camera();
+  ASSERT_TRUE(cam->SetImage(testCube->sampleCount() / 2.0 + 0.5,
+                            testCube->lineCount() / 2.0 + 0.5));
+  double centerPhase = cam->PhaseAngle();
+
+  LineManager line(*testCube);
+  QVector<Buffer *> cubeData;
+  cubeData.push_back(&line);
+
+  int validPixels = 0;
+  for (int lineNumber = 1; lineNumber <= 3; lineNumber++) {
+    line.SetLine(lineNumber);
+    testCube->read(line);
+    QVector<double> differences = difference.runCalculations(cubeData, lineNumber, 1);
+    QVector<double> sums = twice.runCalculations(cubeData, lineNumber, 1);
+    ASSERT_EQ(differences.size(), testCube->sampleCount());
+    ASSERT_EQ(sums.size(), testCube->sampleCount());
+
+    for (int i = 0; i < testCube->sampleCount(); i++) {
+      if (cam->SetImage(i + 1, lineNumber)) {
+        validPixels++;
+        EXPECT_NEAR(differences[i], cam->PhaseAngle() - centerPhase, 1e-10)
+            << "Line " << lineNumber << ", sample " << i + 1;
+        EXPECT_NEAR(sums[i], 2.0 * cam->PhaseAngle(), 1e-10)
+            << "Line " << lineNumber << ", sample " << i + 1;
+      }
+    }
+  }
+  EXPECT_GT(validPixels, 0);
+}
@@ -1,5 +1,8 @@
+#include <QFileInfo>
 #include <QTemporaryFile>
 #include <QString>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 #include <iostream>
 
 #include <nlohmann/json.hpp>
@@ -7,7 +10,13 @@ using json = nlohmann::json;
 
 #include "Blob.h"
 #include "Cube.h"
+#include "Brick.h"
 #include "Camera.h"
+#include "Histogram.h"
+#include "LineManager.h"
+#include "Preference.h"
+#include "Statistics.h"
+#include "TileManager.h"
 
 #include "CubeFixtures.h"
 #include "TestUtilities.h"
@@ -239,3 +248,313 @@ TEST_F(SmallCube, TestCubeHasBlob) {
   EXPECT_TRUE(testCube->hasBlob("TestBlob", "SomeBlob"));
   EXPECT_FALSE(testCube->hasBlob("SomeOtherTestBlob", "SomeBlob"));
 }
+
+TEST_F(SmallCube, TestCubeMappedReadsMatchFileReads) {
+  QString path = testCube->fileName();
+  testCube->close();
+
+  PvlGroup &performance = Preference::Preferences(true).findGroup("Performance");
+  performance.addKeyword(PvlKeyword("CubeReadMapping", "Never"), PvlContainer::Replace);
+
+  Cube fileCube(path, "r");
+  LineManager fileLine(fileCube);
+  std::vector<double> expected;
+  for (fileLine.begin(); !fileLine.end(); fileLine++) {
+    fileCube.read(fileLine);
+    for (int i = 0; i < fileLine.size(); i++) {
+      expected.push_back(fileLine[i]);
+    }
+  }
+  fileCube.close();
+
+  performance.addKeyword(PvlKeyword("CubeReadMapping", "ReadOnly"), PvlContainer::Replace);
+
+  Cube mappedCube(path, "r");
+  LineManager mappedLine(mappedCube);
+  int index = 0;
+  for (mappedLine.begin(); !mappedLine.end(); mappedLine++) {
+    mappedCube.read(mappedLine);
+    for (int i = 0; i < mappedLine.size(); i++) {
+      EXPECT_EQ(mappedLine[i], expected[index++]);
+    }
+  }
+  EXPECT_EQ(index, (int) expected.size());
+
+  // Reads that do not line up with the chunks take a different code path
+  TileManager mappedTile(mappedCube, 3, 3);
+  mappedTile.SetTile(5, 2);
+  mappedCube.read(mappedTile);
+  for (int i = 0; i < mappedTile.size(); i++) {
+    int sample = mappedTile.Sample(i);
+    int line = mappedTile.Line(i);
+    int band = mappedTile.Band(i);
+    if (sample <= 10 && line <= 10) {
+      EXPECT_EQ(mappedTile[i], expected[(band - 1) * 100 + (line - 1) * 10 + (sample - 1)]);
+    }
+  }
+  mappedCube.close();
+}
+
+TEST_F(TempTestingFiles, TestCubeCompressedTileFormat) {
+  QString path = tempDir.path() + "/compressed.cub";
+  auto expectedDn = [](int sample, int line, int band) {
+    return (line > 100) ? Null : (double)(sample + line * band);
+  };
+
+  Cube compressedCube;
+  compressedCube.setDimensions(300, 300, 2);
+  compressedCube.setFormat(Cube::CompressedTile);
+  compressedCube.create(path);
+
+  LineManager writeLine(compressedCube);
+  for (writeLine.begin(); !writeLine.end(); writeLine++) {
+    for (int i = 0; i < writeLine.size(); i++) {
+      writeLine[i] = expectedDn(i + 1, writeLine.Line(), writeLine.Band());
+    }
+    compressedCube.write(writeLine);
+  }
+  compressedCube.close();
+
+  Cube readCube(path, "r");
+  EXPECT_EQ(readCube.format(), Cube::CompressedTile);
+  PvlObject &core = readCube.label()->findObject("IsisCube").findObject("Core");
+  EXPECT_EQ(core["Format"][0].toStdString(), "CompressedTile");
+  EXPECT_EQ(core["Compression"][0].toStdString(), "Zlib");
+
+  // Two thirds of the cube is NULL and takes no space
+  EXPECT_LT(QFileInfo(path).size(), 300 * 300 * 2 * 4 / 3);
+
+  Brick readBrick(readCube, 37, 29, 1);
+  for (readBrick.begin(); !readBrick.end(); readBrick++) {
+    readCube.read(readBrick);
+    for (int i = 0; i < readBrick.size(); i++) {
+      if (readBrick.Sample(i) <= 300 && readBrick.Line(i) <= 300) {
+        EXPECT_EQ(readBrick[i],
+                  expectedDn(readBrick.Sample(i), readBrick.Line(i), readBrick.Band(i)));
+      }
+    }
+  }
+  readCube.close();
+
+  // Overwriting NULL and non-NULL tiles moves their data around
+  Cube updateCube(path, "rw");
+  LineManager updateLine(updateCube);
+  updateLine.SetLine(1, 1);
+  for (int i = 0; i < updateLine.size(); i++) {
+    updateLine[i] = Null;
+  }
+  updateCube.write(updateLine);
+  updateLine.SetLine(250, 2);
+  for (int i = 0; i < updateLine.size(); i++) {
+    updateLine[i] = i;
+  }
+  updateCube.write(updateLine);
+  updateCube.close();
+
+  Cube updatedCube(path, "r");
+  LineManager checkLine(updatedCube);
+  for (checkLine.begin(); !checkLine.end(); checkLine++) {
+    updatedCube.read(checkLine);
+    for (int i = 0; i < checkLine.size(); i++) {
+      double expected = expectedDn(i + 1, checkLine.Line(), checkLine.Band());
+      if (checkLine.Line() == 1 && checkLine.Band() == 1) {
+        expected = Null;
+      }
+      else if (checkLine.Line() == 250 && checkLine.Band() == 2) {
+        expected = i;
+      }
+      EXPECT_EQ(checkLine[i], expected);
+    }
+  }
+  updatedCube.close();
+}
+
+TEST_F(LargeCube, TestCubeStatisticsAndHistogram) {
+  Statistics expectedStats;
+  long double expectedSum = 0.0;
+  long double expectedSumSquare = 0.0;
+  LineManager line(*testCube);
+  for (int i = 1; i <= testCube->lineCount(); i++) {
+    line.SetLine(i, 2);
+    testCube->read(line);
+    expectedStats.AddData(line.DoubleBuffer(), line.size());
+    for (int j = 0; j < line.size(); j++) {
+      expectedSum += line[j];
+      expectedSumSquare += (long double)line[j] * line[j];
+    }
+  }
+
+  Statistics *stats = testCube->statistics(2);
+  EXPECT_EQ(stats->Sum(), (double)expectedSum);
+  EXPECT_EQ(stats->SumSquare(), (double)expectedSumSquare);
+  EXPECT_EQ(stats->Minimum(), expectedStats.Minimum());
+  EXPECT_EQ(stats->Maximum(), expectedStats.Maximum());
+  EXPECT_EQ(stats->TotalPixels(), expectedStats.TotalPixels());
+  EXPECT_EQ(stats->ValidPixels(), expectedStats.ValidPixels());
+
+  // The parts do not depend on the number of threads, so neither do the sums
+  int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(1);
+  Statistics *serialStats = testCube->statistics(0);
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(4, maxThreads));
+  Statistics *parallelStats = testCube->statistics(0);
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+  EXPECT_EQ(parallelStats->Sum(), serialStats->Sum());
+  EXPECT_EQ(parallelStats->SumSquare(), serialStats->SumSquare());
+  EXPECT_EQ(parallelStats->StandardDeviation(), serialStats->StandardDeviation());
+  delete serialStats;
+  delete parallelStats;
+  delete stats;
+
+  Statistics *allStats = testCube->statistics(0);
+  EXPECT_EQ(allStats->TotalPixels(), 1000 * 1000 * 10);
+  EXPECT_EQ(allStats->Minimum(), 0.0);
+  EXPECT_EQ(allStats->Maximum(), 9999.0);
+  delete allStats;
+
+  // Each line of band 2 is a single value from 1000 to 1999
+  Histogram *hist = testCube->histogram(2);
+  EXPECT_EQ(hist->ValidPixels(), 1000 * 1000);
+  EXPECT_EQ(hist->Minimum(), 1000.0);
+  EXPECT_EQ(hist->Maximum(), 1999.0);
+  BigInt binnedPixels = 0;
+  for (int i = 0; i < hist->Bins(); i++) {
+    binnedPixels += hist->BinCount(i);
+  }
+  EXPECT_EQ(binnedPixels, 1000 * 1000);
+  EXPECT_NEAR(hist->Median(), 1499.5, 1.0);
+  delete hist;
+}
+
+TEST_F(LargeCube, TestCubeConcurrentReads) {
+  QString path = testCube->fileName();
+  testCube->close();
+
+  Cube readOnlyCube(path, "r");
+  ASSERT_TRUE(readOnlyCube.isReadOnly());
+
+  int samples = readOnlyCube.sampleCount();
+  int lines = readOnlyCube.lineCount();
+  int bands = readOnlyCube.bandCount();
+
+  LineManager serialLine(readOnlyCube);
+  std::vector<double> expected;
+  for (serialLine.begin(); !serialLine.end(); serialLine++) {
+    readOnlyCube.read(serialLine);
+    for (int i = 0; i < serialLine.size(); i++) {
+      expected.push_back(serialLine[i]);
+    }
+  }
+  readOnlyCube.clearIoCache();
+
+  // Bricks that straddle chunk boundaries from many threads at once
+  QList<int> brickNumbers;
+  Brick brickShape(readOnlyCube, 37, 29, 1);
+  for (int i = 1; i <= brickShape.Bricks(); i++) {
+    brickNumbers.append(i);
+  }
+
+  QList<int> mismatches = QtConcurrent::blockingMapped< QList<int> >(brickNumbers,
+      std::function<int(const int &)>([&](const int &brickNumber) {
+        Brick brick(readOnlyCube, 37, 29, 1);
+        brick.SetBrick(brickNumber);
+        readOnlyCube.read(brick);
+
+        int mismatchCount = 0;
+        for (int i = 0; i < brick.size(); i++) {
+          int sample = brick.Sample(i);
+          int line = brick.Line(i);
+          int band = brick.Band(i);
+          if (sample <= samples && line <= lines && band <= bands) {
+            double truth = expected[((BigInt)band - 1) * samples * lines +
+                                    ((BigInt)line - 1) * samples + (sample - 1)];
+            if (brick[i] != truth) {
+              mismatchCount++;
+            }
+          }
+        }
+        return mismatchCount;
+      }));
+
+  for (int mismatchCount : mismatches) {
+    EXPECT_EQ(mismatchCount, 0);
+  }
+  readOnlyCube.close();
+}
+
+TEST_F(SmallCube, TestCubeOverviews) {
+  EXPECT_FALSE(testCube->hasOverview(2));
+  EXPECT_ANY_THROW(testCube->addOverview(1));
+
+  testCube->addOverview(3);
+  EXPECT_ANY_THROW(testCube->addOverview(3));
+  EXPECT_EQ(testCube->overviewSampleCount(3), 4);
+  EXPECT_EQ(testCube->overviewLineCount(3), 4);
+
+  Brick overview(4, 4, 1, testCube->pixelType());
+  for (int band = 1; band <= testCube->bandCount(); band++) {
+    overview.SetBasePosition(1, 1, band);
+    for (int i = 0; i < overview.size(); i++) {
+      overview[i] = -(band * 100 + i);
+    }
+    testCube->write(overview, 3);
+  }
+
+  // Blobs written after the overview must not overwrite it
+  Blob testBlob("TestBlob", "SomeBlob");
+  testCube->write(testBlob);
+
+  QString path = testCube->fileName();
+  testCube->close();
+
+  Cube cube(path);
+  EXPECT_TRUE(cube.hasOverview(3));
+  EXPECT_ANY_THROW(cube.overviewSampleCount(2));
+  for (int band = 1; band <= cube.bandCount(); band++) {
+    overview.SetBasePosition(1, 1, band);
+    cube.read(overview, 3);
+    for (int i = 0; i < overview.size(); i++) {
+      EXPECT_EQ(overview[i], -(band * 100 + i));
+    }
+  }
+
+  Brick fullResolution(10, 1, 1, cube.pixelType());
+  fullResolution.SetBasePosition(1, 10, 10);
+  cube.read(fullResolution);
+  EXPECT_EQ(fullResolution[9], 999.0);
+
+  EXPECT_ANY_THROW(cube.deleteOverviews());
+  cube.reopen("rw");
+  QString overviewStartByte = cube.label()->findObject("Overview")["StartByte"][0];
+  qint64 fileBytes = QFileInfo(path).size();
+  cube.deleteOverviews();
+  EXPECT_TRUE(cube.overviewReductionFactors().isEmpty());
+  EXPECT_TRUE(cube.hasBlob("TestBlob", "SomeBlob"));
+
+  // A rebuilt overview reuses the space before the blob and starts out zero
+  cube.addOverview(3);
+  EXPECT_EQ(cube.label()->findObject("Overview")["StartByte"][0], overviewStartByte);
+  EXPECT_EQ(QFileInfo(path).size(), fileBytes);
+  overview.SetBasePosition(1, 1, 1);
+  cube.read(overview, 3);
+  for (int i = 0; i < overview.size(); i++) {
+    EXPECT_EQ(overview[i], 0.0);
+  }
+
+  // Writing the cube's DNs makes the overviews stale
+  cube.write(fullResolution);
+  EXPECT_FALSE(cube.hasOverview(3));
+}
+
+TEST_F(SmallCube, TestCubeOverviewsTruncated) {
+  QString path = testCube->fileName();
+  qint64 fileBytes = QFileInfo(path).size();
+
+  testCube->addOverview(2);
+  testCube->addOverview(4);
+  EXPECT_GT(QFileInfo(path).size(), fileBytes);
+
+  // Overviews at the end of the data file are truncated
+  testCube->deleteOverviews();
+  EXPECT_EQ(QFileInfo(path).size(), fileBytes);
+}
@@ -0,0 +1,152 @@
+#include <fstream>
+#include <vector>
+
+#include "Camera.h"
+#include "CameraFixtures.h"
+#include "Cube.h"
+#include "DemShape.h"
+#include "Distance.h"
+#include "IException.h"
+#include "Interpolator.h"
+#include "Latitude.h"
+#include "LineManager.h"
+#include "Longitude.h"
+#include "Portal.h"
+#include "Preference.h"
+#include "Projection.h"
+#include "Pvl.h"
+#include "ShapeModel.h"
+#include "SpecialPixel.h"
+#include "SurfacePoint.h"
+#include "Target.h"
+#include "TempFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+// The DEM spans several of the tiles DemShape caches and has a hole of NULLs
+TEST_F(TempTestingFiles, DemShapeLocalRadiiMatchPortalReads) {
+  std::ifstream cubeLabel("data/defaultImage/demCube.pvl");
+  Pvl demLabel;
+  cubeLabel >> demLabel;
+  PvlObject &core = demLabel.findObject("IsisCube").findObject("Core");
+  core.findGroup("Dimensions")["Samples"] = "300";
+  core.findGroup("Dimensions")["Lines"] = "260";
+  core.findGroup("Pixels")["Type"] = "Real";
+
+  QString demPath = tempDir.path() + "/dem.cub";
+  Cube demCube;
+  demCube.fromLabel(demPath, demLabel, "rw");
+
+  LineManager line(demCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      int sample = i + 1;
+      if (sample > 120 && sample < 140 && line.Line() > 50 && line.Line() < 60) {
+        line[i] = Null;
+      }
+      else {
+        line[i] = 3396000.0 + 10.0 * sample + 0.5 * line.Line() * line.Line();
+      }
+    }
+    demCube.write(line);
+  }
+  demCube.reopen("r");
+
+  Pvl label;
+  PvlObject isisCube("IsisCube");
+  PvlGroup kernels("Kernels");
+  kernels += PvlKeyword("ShapeModel", demPath);
+  isisCube.addGroup(kernels);
+  label.addObject(isisCube);
+
+  Target target;
+  DemShape shape(&target, label);
+
+  Projection *proj = demCube.projection();
+  std::vector<double> latitudes;
+  std::vector<double> longitudes;
+  for (double sample = 0.7; sample < 302; sample += 9.37) {
+    for (double lineNumber = 0.9; lineNumber < 262; lineNumber += 7.83) {
+      ASSERT_TRUE(proj->SetWorld(sample, lineNumber));
+      latitudes.push_back(proj->UniversalLatitude());
+      longitudes.push_back(proj->UniversalLongitude());
+    }
+  }
+  latitudes.push_back(Null);
+  longitudes.push_back(78.5);
+
+  std::vector<double> radii = shape.localRadii(latitudes, longitudes);
+  ASSERT_EQ(radii.size(), latitudes.size());
+  EXPECT_EQ(radii.back(), Null);
+
+  Interpolator interp(Interpolator::BiLinearType);
+  Portal portal(interp.Samples(), interp.Lines(), demCube.pixelType(),
+                interp.HotSample(), interp.HotLine());
+  for (size_t i = 0; i < latitudes.size() - 1; i++) {
+    proj->SetUniversalGround(latitudes[i], longitudes[i]);
+    portal.SetPosition(proj->WorldX(), proj->WorldY(), 1);
+    demCube.read(portal);
+    double expected = interp.Interpolate(proj->WorldX(), proj->WorldY(), portal.DoubleBuffer());
+
+    if (IsSpecial(expected)) {
+      EXPECT_EQ(radii[i], Null);
+    }
+    else {
+      EXPECT_DOUBLE_EQ(radii[i], expected / 1000.0);
+    }
+
+    Distance radius = shape.localRadius(Latitude(latitudes[i], Angle::Degrees),
+                                        Longitude(longitudes[i], Angle::Degrees));
+    EXPECT_EQ(radius.kilometers(), radii[i]);
+  }
+
+  EXPECT_THROW(shape.localRadii(latitudes, std::vector<double>(1, 78.5)), IException);
+
+  // With the smallest cache only one tile is kept, so tiles are read again and again
+  PvlGroup &performance = Preference::Preferences(true).findGroup("Performance");
+  performance.addKeyword(PvlKeyword("DemTileCache", "0"), PvlContainer::Replace);
+  DemShape smallCacheShape(&target, label);
+  performance.addKeyword(PvlKeyword("DemTileCache", "2"), PvlContainer::Replace);
+
+  std::vector<double> smallCacheRadii = smallCacheShape.localRadii(latitudes, longitudes);
+  ASSERT_EQ(smallCacheRadii.size(), radii.size());
+  for (size_t i = 0; i < radii.size(); i++) {
+    EXPECT_EQ(smallCacheRadii[i], radii[i]);
+  }
+}
+
+
+TEST_F(DefaultCube, DemShapeIntersectSurfacesMatchesCamera) {
+  Camera *cam = testCube->camera();
+  ShapeModel *shape = cam->target()->shape();
+
+  std::vector< std::vector<double> > observerPositions;
+  std::vector< std::vector<double> > lookDirections;
+  std::vector<SurfacePoint> expected;
+  for (double sample = 1.0; sample <= cam->Samples(); sample += 150.5) {
+    for (double line = 1.0; line <= cam->Lines(); line += 150.5) {
+      ASSERT_TRUE(cam->SetImage(sample, line));
+      std::vector<double> observer(3);
+      cam->instrumentBodyFixedPosition(&observer[0]);
+      observerPositions.push_back(observer);
+      lookDirections.push_back(cam->lookDirectionBodyFixed());
+      expected.push_back(cam->GetSurfacePoint());
+    }
+  }
+
+  std::vector<SurfacePoint> intersections = shape->intersectSurfaces(observerPositions,
+                                                                     lookDirections);
+  ASSERT_EQ(intersections.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_TRUE(intersections[i].Valid());
+    EXPECT_NEAR(intersections[i].GetX().kilometers(), expected[i].GetX().kilometers(), 1e-8);
+    EXPECT_NEAR(intersections[i].GetY().kilometers(), expected[i].GetY().kilometers(), 1e-8);
+    EXPECT_NEAR(intersections[i].GetZ().kilometers(), expected[i].GetZ().kilometers(), 1e-8);
+  }
+  EXPECT_FALSE(shape->hasIntersection());
+
+  lookDirections.pop_back();
+  EXPECT_THROW(shape->intersectSurfaces(observerPositions, lookDirections), IException);
+}
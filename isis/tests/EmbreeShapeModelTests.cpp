@@ -0,0 +1,65 @@
+#include <vector>
+
+#include "EmbreeShapeModel.h"
+#include "EmbreeTargetManager.h"
+#include "IException.h"
+#include "SurfacePoint.h"
+#include "Target.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// More rays than one block of EmbreeTargetShape::intersectRays, so they are traced on several threads
+TEST(EmbreeShapeModelTests, BatchedIntersectionsMatchSingleRays) {
+  QString dskfile("$ISISTESTDATA/isis/src/base/unitTestData/hay_a_amica_5_itokawashape_v1_0_64q.bds");
+
+  Target target;
+  EmbreeShapeModel itokawaModel(&target, dskfile, EmbreeTargetManager::getInstance());
+
+  // Rays from each axis aimed across the body, some of them missing it
+  std::vector< std::vector<double> > observers;
+  std::vector< std::vector<double> > lookDirections;
+  for (int axis = 0; axis < 3; axis++) {
+    for (double u = -0.8; u <= 0.8; u += 0.1) {
+      for (double v = -0.8; v <= 0.8; v += 0.1) {
+        std::vector<double> observer(3, 0.0);
+        observer[axis] = 5.0;
+        std::vector<double> lookDirection(3, 0.0);
+        lookDirection[axis] = -5.0;
+        lookDirection[(axis + 1) % 3] = u;
+        lookDirection[(axis + 2) % 3] = v;
+        observers.push_back(observer);
+        lookDirections.push_back(lookDirection);
+      }
+    }
+  }
+  ASSERT_GT(observers.size(), 256u);
+
+  std::vector<SurfacePoint> intersections =
+      itokawaModel.intersectSurfaces(observers, lookDirections);
+  ASSERT_EQ(intersections.size(), observers.size());
+  EXPECT_FALSE(itokawaModel.hasIntersection());
+
+  int hits = 0;
+  int misses = 0;
+  for (size_t i = 0; i < observers.size(); i++) {
+    bool hit = itokawaModel.intersectSurface(observers[i], lookDirections[i]);
+    ASSERT_EQ(intersections[i].Valid(), hit) << "Ray " << i;
+    if (hit) {
+      hits++;
+      SurfacePoint *expected = itokawaModel.surfaceIntersection();
+      EXPECT_DOUBLE_EQ(intersections[i].GetX().kilometers(), expected->GetX().kilometers());
+      EXPECT_DOUBLE_EQ(intersections[i].GetY().kilometers(), expected->GetY().kilometers());
+      EXPECT_DOUBLE_EQ(intersections[i].GetZ().kilometers(), expected->GetZ().kilometers());
+    }
+    else {
+      misses++;
+    }
+  }
+  EXPECT_GT(hits, 0);
+  EXPECT_GT(misses, 0);
+
+  EXPECT_THROW(itokawaModel.intersectSurfaces(observers, std::vector< std::vector<double> >(1)),
+               IException);
+}
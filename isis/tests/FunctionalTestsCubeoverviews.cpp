@@ -0,0 +1,86 @@
+#include <QString>
+
+#include "Brick.h"
+#include "Cube.h"
+#include "CubeFixtures.h"
+
+#include "cubeoverviews.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/cubeoverviews.xml").expanded();
+
+TEST_F(SmallCube, FunctionalTestCubeoverviewsDefault) {
+  QString cubePath = testCube->fileName();
+  QVector<QString> args = {"from=" + cubePath, "minimumsize=2"};
+  UserInterface options(APP_XML, args);
+  cubeoverviews(testCube, options);
+  testCube->close();
+
+  Cube cube(cubePath);
+  ASSERT_EQ(cube.overviewReductionFactors(), QList<int>({2, 4}));
+  EXPECT_EQ(cube.overviewSampleCount(2), 5);
+  EXPECT_EQ(cube.overviewLineCount(2), 5);
+  EXPECT_EQ(cube.overviewSampleCount(4), 3);
+  EXPECT_EQ(cube.overviewLineCount(4), 3);
+
+  // The fixture's DN at (sample, line, band) is 100 * (band - 1) + 10 * (line - 1) + sample - 1
+  Brick overview2(5, 5, 1, cube.pixelType());
+  for (int band = 1; band <= cube.bandCount(); band++) {
+    overview2.SetBasePosition(1, 1, band);
+    cube.read(overview2, 2);
+    for (int line = 0; line < 5; line++) {
+      for (int sample = 0; sample < 5; sample++) {
+        EXPECT_DOUBLE_EQ(overview2[line * 5 + sample],
+                         100 * (band - 1) + 20 * line + 2 * sample + 5.5);
+      }
+    }
+  }
+
+  // The last sample and line of the coarser overview only average one pixel
+  Brick overview4(3, 3, 1, cube.pixelType());
+  overview4.SetBasePosition(1, 1, 1);
+  cube.read(overview4, 4);
+  EXPECT_DOUBLE_EQ(overview4[0], 16.5);
+  EXPECT_DOUBLE_EQ(overview4[1], 20.5);
+  EXPECT_DOUBLE_EQ(overview4[2], 23.5);
+  EXPECT_DOUBLE_EQ(overview4[6], 86.5);
+  EXPECT_DOUBLE_EQ(overview4[8], 93.5);
+
+  // The full resolution data is untouched
+  Brick fullResolution(1, 1, 1, cube.pixelType());
+  fullResolution.SetBasePosition(10, 10, 10);
+  cube.read(fullResolution);
+  EXPECT_DOUBLE_EQ(fullResolution[0], 999.0);
+}
+
+
+TEST_F(SmallCube, FunctionalTestCubeoverviewsRebuild) {
+  QVector<QString> args = {"from=" + testCube->fileName(), "minimumsize=2"};
+  UserInterface options(APP_XML, args);
+  cubeoverviews(testCube, options);
+
+  QVector<QString> rebuildArgs = {"from=" + testCube->fileName(), "minimumsize=5"};
+  UserInterface rebuildOptions(APP_XML, rebuildArgs);
+  cubeoverviews(testCube, rebuildOptions);
+
+  EXPECT_EQ(testCube->overviewReductionFactors(), QList<int>({2}));
+  EXPECT_FALSE(testCube->hasOverview(4));
+  EXPECT_EQ(testCube->label()->findObject("Overview").findKeyword("Samples")[0], "5");
+}
+
+
+TEST_F(SmallCube, FunctionalTestCubeoverviewsTooSmall) {
+  QVector<QString> args = {"from=" + testCube->fileName(), "minimumsize=6"};
+  UserInterface options(APP_XML, args);
+
+  try {
+    cubeoverviews(testCube, options);
+    FAIL() << "Expected an exception for a cube smaller than the minimum overview size";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("too small to have overviews"));
+  }
+}
@@ -0,0 +1,75 @@
+#include <cmath>
+
+#include <QString>
+#include <QVector>
+
+#include "Camera.h"
+#include "CameraFixtures.h"
+#include "Cube.h"
+#include "LineManager.h"
+#include "Pvl.h"
+#include "SpecialPixel.h"
+#include "photomet.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/photomet.xml").expanded();
+
+TEST_F(DefaultCube, FunctionalTestPhotometAngleSpacing) {
+  resizeCube(150, 60, 1);
+  testCube->reopen("r");
+
+  // Trim at the incidence angle of the center so the trim pass nulls part of the image
+  Camera *cam = testCube->camera();
+  ASSERT_TRUE(cam->SetImage(75.0, 30.0));
+  QString maxIncidence = QString::number(cam->IncidenceAngle());
+
+  QString exactPath = tempDir.path() + "/photometExact.cub";
+  QString sampledPath = tempDir.path() + "/photometSampled.cub";
+  QVector<QString> exactArgs = {"from=" + testCube->fileName(), "to=" + exactPath,
+                                "phtname=lunarlambert", "l=0.5", "normname=albedo",
+                                "incref=30.0", "thresh=30.0", "albedo=0.0690507",
+                                "maxincidence=" + maxIncidence, "anglespacing=1"};
+  QVector<QString> sampledArgs = exactArgs;
+  sampledArgs.last() = "anglespacing=16";
+
+  UserInterface exactOptions(APP_XML, exactArgs);
+  UserInterface sampledOptions(APP_XML, sampledArgs);
+  Pvl log;
+  photomet(exactOptions, &log);
+  photomet(sampledOptions, &log);
+
+  Cube exactCube(exactPath);
+  Cube sampledCube(sampledPath);
+  LineManager exactLine(exactCube);
+  LineManager sampledLine(sampledCube);
+  int validPixels = 0;
+  int trimmedPixels = 0;
+  int mismatches = 0;
+  for (int line = 1; line <= exactCube.lineCount(); line++) {
+    exactLine.SetLine(line);
+    sampledLine.SetLine(line);
+    exactCube.read(exactLine);
+    sampledCube.read(sampledLine);
+    for (int i = 0; i < exactLine.size(); i++) {
+      if (IsSpecial(exactLine[i]) != IsSpecial(sampledLine[i])) {
+        // Only pixels on the trim boundary may fall on either side of it
+        mismatches++;
+      }
+      else if (IsSpecial(exactLine[i])) {
+        EXPECT_EQ(exactLine[i], sampledLine[i]) << "Line " << line << ", sample " << i + 1;
+        trimmedPixels++;
+      }
+      else {
+        EXPECT_NEAR(sampledLine[i], exactLine[i], 1.0e-4 * fabs(exactLine[i]))
+            << "Line " << line << ", sample " << i + 1;
+        validPixels++;
+      }
+    }
+  }
+  EXPECT_GT(validPixels, 0);
+  EXPECT_GT(trimmedPixels, 0);
+  EXPECT_LE(mismatches, 2 * exactCube.lineCount());
+}
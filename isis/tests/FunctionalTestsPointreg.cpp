@@ -1,10 +1,15 @@
+#include <QThreadPool>
+
 #include "pointreg.h"
 
 #include "NetworkFixtures.h"
 #include "TestUtilities.h"
 #include "UserInterface.h"
+#include "ControlMeasure.h"
 #include "ControlNet.h"
+#include "ControlPoint.h"
 #include "LineManager.h"
+#include "Preference.h"
 
 #include "gmock/gmock.h"
 
@@ -386,3 +391,80 @@ TEST_F(ThreeImageNetwork, FunctionalTestPointregValidationSkipped) {
   EXPECT_TRUE(falsePos.size() == 140);  // 140 is the size of the empty table due to column names
 }
 
+
+TEST_F(ThreeImageNetwork, FunctionalTestPointregThreaded) {
+  QTemporaryDir prefix;
+  PvlGroup &performance = Preference::Preferences(true).findGroup("Performance");
+
+  // Register on at least two threads so the threaded path is taken
+  int maxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(2, maxThreadCount));
+
+  QMap<QString, Pvl> logs;
+  QStringList modes = { "Serial", "Threaded" };
+  foreach (QString mode, modes) {
+    QVector<QString> args = { "fromlist=" + cubeListFile,
+                              "cnet=" + networkFile,
+                              "deffile=data/threeImageNetwork/autoRegTemplate.def",
+                              "flatfile=" + prefix.path() + "/flatfile" + mode + ".csv",
+                              "onet=" + prefix.path() + "/outNet" + mode + ".net",
+                              "validate=after",
+                              "falsepositives=" + prefix.path() + "/falsePos" + mode + ".csv",
+                              "revert=yes", "shift=0.1",
+                              "points=all" };
+    UserInterface options(APP_XML, args);
+
+    performance.addKeyword(PvlKeyword("PointRegistration", mode), PvlContainer::Replace);
+    try {
+      pointreg(options, &logs[mode]);
+    }
+    catch (IException &e) {
+      performance.addKeyword(PvlKeyword("PointRegistration", "Serial"), PvlContainer::Replace);
+      QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+      FAIL() << e.toString().toStdString().c_str() << std::endl;
+    }
+  }
+  performance.addKeyword(PvlKeyword("PointRegistration", "Serial"), PvlContainer::Replace);
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+
+  QStringList groups = { "Points", "Measures", "AutoRegStatistics", "ValidationStatistics" };
+  foreach (QString group, groups) {
+    PvlGroup serialGroup = logs["Serial"].findGroup(group);
+    PvlGroup threadedGroup = logs["Threaded"].findGroup(group);
+    ASSERT_EQ(serialGroup.keywords(), threadedGroup.keywords()) << group.toStdString();
+    for (int k = 0; k < serialGroup.keywords(); k++) {
+      EXPECT_EQ(serialGroup[k][0].toStdString(), threadedGroup[k][0].toStdString())
+          << group.toStdString() << " " << serialGroup[k].name().toStdString();
+    }
+  }
+
+  QStringList files = { "flatfile", "falsePos" };
+  foreach (QString file, files) {
+    QFile serialFile(prefix.path() + "/" + file + "Serial.csv");
+    QFile threadedFile(prefix.path() + "/" + file + "Threaded.csv");
+    ASSERT_TRUE(serialFile.open(QIODevice::ReadOnly));
+    ASSERT_TRUE(threadedFile.open(QIODevice::ReadOnly));
+    EXPECT_EQ(serialFile.readAll(), threadedFile.readAll()) << file.toStdString();
+  }
+
+  ControlNet serialNet(prefix.path() + "/outNetSerial.net");
+  ControlNet threadedNet(prefix.path() + "/outNetThreaded.net");
+  ASSERT_EQ(serialNet.GetNumPoints(), threadedNet.GetNumPoints());
+  for (int p = 0; p < serialNet.GetNumPoints(); p++) {
+    ControlPoint *serialPoint = serialNet.GetPoint(p);
+    ControlPoint *threadedPoint = threadedNet.GetPoint(p);
+    EXPECT_EQ(serialPoint->GetId().toStdString(), threadedPoint->GetId().toStdString());
+    EXPECT_EQ(serialPoint->IsIgnored(), threadedPoint->IsIgnored());
+    ASSERT_EQ(serialPoint->GetNumMeasures(), threadedPoint->GetNumMeasures());
+    for (int m = 0; m < serialPoint->GetNumMeasures(); m++) {
+      ControlMeasure *serialMeasure = serialPoint->GetMeasure(m);
+      ControlMeasure *threadedMeasure = threadedPoint->GetMeasure(m);
+      EXPECT_EQ(serialMeasure->GetCubeSerialNumber().toStdString(),
+                threadedMeasure->GetCubeSerialNumber().toStdString());
+      EXPECT_EQ(serialMeasure->GetType(), threadedMeasure->GetType());
+      EXPECT_EQ(serialMeasure->IsIgnored(), threadedMeasure->IsIgnored());
+      EXPECT_EQ(serialMeasure->GetSample(), threadedMeasure->GetSample());
+      EXPECT_EQ(serialMeasure->GetLine(), threadedMeasure->GetLine());
+    }
+  }
+}
@@ -0,0 +1,128 @@
+#include <cmath>
+
+#include "AutoReg.h"
+#include "AutoRegFactory.h"
+#include "Chip.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  Pvl registrationPvl(QString algorithm) {
+    PvlGroup alg("Algorithm");
+    alg += PvlKeyword("Name", algorithm);
+    alg += PvlKeyword("Tolerance", "0.3");
+    alg += PvlKeyword("SubpixelAccuracy", "True");
+
+    PvlGroup pchip("PatternChip");
+    pchip += PvlKeyword("Samples", "15");
+    pchip += PvlKeyword("Lines", "15");
+    pchip += PvlKeyword("ValidPercent", "50");
+
+    PvlGroup schip("SearchChip");
+    schip += PvlKeyword("Samples", "35");
+    schip += PvlKeyword("Lines", "35");
+    schip += PvlKeyword("ValidPercent", "50");
+
+    PvlObject o("AutoRegistration");
+    o.addGroup(alg);
+    o.addGroup(pchip);
+    o.addGroup(schip);
+
+    Pvl pvl;
+    pvl.addObject(o);
+    return pvl;
+  }
+
+
+  double texture(int x, int y) {
+    return 100.0 + 20.0 * sin(0.37 * x) + 15.0 * cos(0.23 * y) +
+           3.0 * ((x * 7 + y * 13) % 11) + 0.5 * x;
+  }
+
+
+  // Fills the chips of the registration with the pattern offset in the search chip
+  void loadChips(AutoReg *ar, bool withNulls) {
+    Chip *search = ar->SearchChip();
+    for (int line = 1; line <= search->Lines(); line++) {
+      for (int samp = 1; samp <= search->Samples(); samp++) {
+        search->SetValue(samp, line, texture(samp, line));
+      }
+    }
+
+    Chip *pattern = ar->PatternChip();
+    for (int line = 1; line <= pattern->Lines(); line++) {
+      for (int samp = 1; samp <= pattern->Samples(); samp++) {
+        pattern->SetValue(samp, line, texture(samp + 13, line + 8) + 0.1 * ((samp * line) % 3));
+      }
+    }
+
+    if (withNulls) {
+      for (int i = 1; i <= 6; i++) {
+        search->SetValue(5 * i, 4 + i, Isis::Null);
+        search->SetValue(12, 3 * i + 2, Isis::Lrs);
+      }
+      pattern->SetValue(2, 3, Isis::Null);
+      pattern->SetValue(9, 14, Isis::Hrs);
+    }
+  }
+
+
+  void compareRegistrations(bool withNulls) {
+    Pvl correlationPvl = registrationPvl("MaximumCorrelation");
+    Pvl nccPvl = registrationPvl("NormalizedCrossCorrelation");
+    AutoReg *correlation = AutoRegFactory::Create(correlationPvl);
+    AutoReg *ncc = AutoRegFactory::Create(nccPvl);
+
+    loadChips(correlation, withNulls);
+    loadChips(ncc, withNulls);
+
+    AutoReg::RegisterStatus correlationStatus = correlation->Register();
+    AutoReg::RegisterStatus nccStatus = ncc->Register();
+
+    EXPECT_EQ(ncc->AlgorithmName(), "NormalizedCrossCorrelation");
+    EXPECT_EQ(nccStatus, correlationStatus);
+    EXPECT_NEAR(ncc->ChipSample(), correlation->ChipSample(), 1e-8);
+    EXPECT_NEAR(ncc->ChipLine(), correlation->ChipLine(), 1e-8);
+    EXPECT_NEAR(ncc->GoodnessOfFit(), correlation->GoodnessOfFit(), 1e-10);
+
+    Chip *correlationFit = correlation->FitChip();
+    Chip *nccFit = ncc->FitChip();
+    ASSERT_EQ(nccFit->Samples(), correlationFit->Samples());
+    ASSERT_EQ(nccFit->Lines(), correlationFit->Lines());
+    int fits = 0;
+    for (int line = 1; line <= nccFit->Lines(); line++) {
+      for (int samp = 1; samp <= nccFit->Samples(); samp++) {
+        double expected = correlationFit->GetValue(samp, line);
+        double actual = nccFit->GetValue(samp, line);
+        if (expected == Isis::Null) {
+          EXPECT_EQ(actual, Isis::Null) << "Sample " << samp << ", line " << line;
+        }
+        else {
+          EXPECT_NEAR(actual, expected, 1e-10) << "Sample " << samp << ", line " << line;
+          fits++;
+        }
+      }
+    }
+    EXPECT_GT(fits, 0);
+
+    delete correlation;
+    delete ncc;
+  }
+}
+
+
+TEST(NormalizedCrossCorrelation, MatchesMaximumCorrelation) {
+  compareRegistrations(false);
+}
+
+
+TEST(NormalizedCrossCorrelation, MatchesMaximumCorrelationWithSpecialPixels) {
+  compareRegistrations(true);
+}
@@ -0,0 +1,161 @@
+#include <cmath>
+
+#include "IException.h"
+#include "Photometry.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+class PhotometryLunarLambert : public ::testing::Test {
+  protected:
+    Pvl pvl;
+
+    void SetUp() override {
+      PvlGroup photoAlgorithm("Algorithm");
+      photoAlgorithm += PvlKeyword("Name", "LunarLambert");
+      photoAlgorithm += PvlKeyword("L", "0.5");
+      PvlObject photoModel("PhotometricModel");
+      photoModel.addGroup(photoAlgorithm);
+      pvl.addObject(photoModel);
+
+      PvlGroup normAlgorithm("Algorithm");
+      normAlgorithm += PvlKeyword("Name", "Albedo");
+      normAlgorithm += PvlKeyword("Incref", "30.0");
+      normAlgorithm += PvlKeyword("Albedo", "0.0690507");
+      normAlgorithm += PvlKeyword("Thresh", "30.0");
+      PvlObject normModel("NormalizationModel");
+      normModel.addGroup(normAlgorithm);
+      pvl.addObject(normModel);
+    }
+};
+
+
+TEST_F(PhotometryLunarLambert, LookupTable) {
+  Photometry exact(pvl);
+  Photometry table(pvl);
+  EXPECT_FALSE(table.HasLookupTable());
+
+  table.CreateLookupTable(2.0, 80.0, 80.0, 1.0e-3);
+  ASSERT_TRUE(table.HasLookupTable());
+  EXPECT_EQ(table.LookupTableCells(), 90 * 40 * 40);
+  EXPECT_LT(table.LookupTableExactCells(), table.LookupTableCells());
+
+  double angles[4][3] = {{30.3, 41.7, 12.9},
+                         {65.1, 55.2, 20.4},
+                         {12.0, 10.0, 5.0},
+                         {101.4, 75.3, 40.8}};
+  for (int i = 0; i < 4; i++) {
+    double pha = angles[i][0];
+    double inc = angles[i][1];
+    double ema = angles[i][2];
+    double expected, lookup, mult, base;
+    exact.Compute(pha, inc, ema, inc, ema, 0.12, expected, mult, base);
+    table.Compute(pha, inc, ema, inc, ema, 0.12, lookup, mult, base);
+    EXPECT_FALSE(IsSpecial(expected));
+    EXPECT_NEAR(lookup, expected, 1.0e-3) << "angles " << pha << " " << inc << " " << ema;
+  }
+
+  // Angles outside of the table and dem angles are computed exactly
+  double expected, lookup, mult, base;
+  exact.Compute(40.0, 30.0, 85.0, 30.0, 85.0, 0.12, expected, mult, base);
+  table.Compute(40.0, 30.0, 85.0, 30.0, 85.0, 0.12, lookup, mult, base);
+  EXPECT_EQ(lookup, expected);
+
+  exact.Compute(40.3, 30.1, 20.2, 35.7, 15.1, 0.12, expected, mult, base);
+  table.Compute(40.3, 30.1, 20.2, 35.7, 15.1, 0.12, lookup, mult, base);
+  EXPECT_EQ(lookup, expected);
+
+  table.ClearLookupTable();
+  EXPECT_FALSE(table.HasLookupTable());
+}
+
+
+TEST_F(PhotometryLunarLambert, LookupTableSpacing) {
+  Photometry photometry(pvl);
+  try {
+    photometry.CreateLookupTable(0.0, 90.0, 90.0, 1.0e-4);
+    FAIL() << "Expected an exception";
+  }
+  catch(IException &e) {
+    EXPECT_THAT(e.toString().toStdString(),
+                ::testing::HasSubstr("must be greater than zero"));
+  }
+
+  try {
+    photometry.CreateLookupTable(0.01, 90.0, 90.0, 1.0e-4);
+    FAIL() << "Expected an exception";
+  }
+  catch(IException &e) {
+    EXPECT_THAT(e.toString().toStdString(), ::testing::HasSubstr("is too small"));
+  }
+}
+
+
+TEST(PhotometryTests, LookupTableNonlinearModel) {
+  Pvl pvl;
+  PvlGroup photoAlgorithm("Algorithm");
+  photoAlgorithm += PvlKeyword("Name", "Lambert");
+  PvlObject photoModel("PhotometricModel");
+  photoModel.addGroup(photoAlgorithm);
+  pvl.addObject(photoModel);
+
+  PvlGroup atmosAlgorithm("Algorithm");
+  atmosAlgorithm += PvlKeyword("Name", "Anisotropic1");
+  atmosAlgorithm += PvlKeyword("Bha", "0.85");
+  atmosAlgorithm += PvlKeyword("Tau", "0.28");
+  atmosAlgorithm += PvlKeyword("Wha", "0.95");
+  atmosAlgorithm += PvlKeyword("Hga", "0.68");
+  atmosAlgorithm += PvlKeyword("Tauref", "0.0");
+  atmosAlgorithm += PvlKeyword("Hnorm", "0.003");
+  PvlObject atmosModel("AtmosphericModel");
+  atmosModel.addGroup(atmosAlgorithm);
+  pvl.addObject(atmosModel);
+
+  PvlGroup normAlgorithm("Algorithm");
+  normAlgorithm += PvlKeyword("Name", "AlbedoAtm");
+  normAlgorithm += PvlKeyword("Incref", "0.0");
+  normAlgorithm += PvlKeyword("Thresh", "30.0");
+  PvlObject normModel("NormalizationModel");
+  normModel.addGroup(normAlgorithm);
+  pvl.addObject(normModel);
+
+  Photometry exact(pvl);
+  Photometry table(pvl);
+
+  // The albedo is not a line through its values at any two DNs
+  double zero, one, half, mult, base;
+  exact.Compute(30.0, 40.0, 20.0, 40.0, 20.0, 0.0, zero, mult, base);
+  exact.Compute(30.0, 40.0, 20.0, 40.0, 20.0, 1.0, one, mult, base);
+  exact.Compute(30.0, 40.0, 20.0, 40.0, 20.0, 0.5, half, mult, base);
+  EXPECT_GT(fabs(half - (zero + one) / 2.0), 1.0e-6);
+
+  // The angle terms are tabulated and the albedo is computed from them for each DN
+  table.CreateLookupTable(2.0, 80.0, 80.0, 1.0e-4);
+  ASSERT_TRUE(table.HasLookupTable());
+  EXPECT_EQ(table.LookupTableCells(), 90 * 40 * 40);
+  EXPECT_LT(table.LookupTableExactCells(), table.LookupTableCells());
+
+  double angles[4][3] = {{30.3, 41.7, 12.9},
+                         {65.1, 55.2, 20.4},
+                         {12.0, 10.0, 5.0},
+                         {101.4, 75.3, 40.8}};
+  double dns[5] = {0.02, 0.08, 0.12, 0.35, 0.9};
+  for (int i = 0; i < 4; i++) {
+    double pha = angles[i][0];
+    double inc = angles[i][1];
+    double ema = angles[i][2];
+    for (int d = 0; d < 5; d++) {
+      double expected, lookup;
+      exact.Compute(pha, inc, ema, inc, ema, dns[d], expected, mult, base);
+      table.Compute(pha, inc, ema, inc, ema, dns[d], lookup, mult, base);
+      EXPECT_FALSE(IsSpecial(expected));
+      EXPECT_NEAR(lookup, expected, 1.0e-3)
+          << "angles " << pha << " " << inc << " " << ema << ", dn " << dns[d];
+    }
+  }
+}
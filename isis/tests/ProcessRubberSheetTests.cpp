@@ -0,0 +1,103 @@
+#include <QString>
+
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "Interpolator.h"
+#include "ProcessRubberSheet.h"
+#include "Transform.h"
+
+#include "CameraFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  /**
+   * A cloneable transform that magnifies the input cube by a constant
+   * factor. In reverse mode Xform goes from output to input pixels, as
+   * StartProcess expects; otherwise it goes from input to output pixels,
+   * as processPatchTransform expects.
+   */
+  class MagnifyTransform : public Transform {
+    public:
+      MagnifyTransform(double scale, int samples, int lines, bool reverse) :
+          m_scale(scale), m_samples(samples), m_lines(lines), m_reverse(reverse) {
+      }
+
+      int OutputSamples() const {
+        return m_samples;
+      }
+
+      int OutputLines() const {
+        return m_lines;
+      }
+
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine) {
+        if (m_reverse) {
+          inSample = 0.5 + (outSample - 0.5) / m_scale;
+          inLine = 0.5 + (outLine - 0.5) / m_scale;
+        }
+        else {
+          inSample = 0.5 + (outSample - 0.5) * m_scale;
+          inLine = 0.5 + (outLine - 0.5) * m_scale;
+        }
+        return true;
+      }
+
+      Transform *clone() const {
+        return new MagnifyTransform(m_scale, m_samples, m_lines, m_reverse);
+      }
+
+    private:
+      double m_scale;
+      int m_samples;
+      int m_lines;
+      bool m_reverse;
+  };
+
+
+  void rubberSheet(Cube *inCube, QString outPath, bool patches) {
+    ProcessRubberSheet process;
+    process.SetInputCube(inCube);
+    CubeAttributeOutput att;
+    process.SetOutputCube(outPath, att, 250, 250, inCube->bandCount());
+
+    Interpolator interp(Interpolator::BiLinearType);
+    MagnifyTransform trans(25.0, 250, 250, !patches);
+    if (patches) {
+      process.processPatchTransform(trans, interp);
+    }
+    else {
+      process.StartProcess(trans, interp);
+    }
+    process.EndProcess();
+  }
+}
+
+
+TEST_F(ThreadedRubberSheetCube, ProcessRubberSheetThreadedTiles) {
+  resizeCube(10, 10, 3);
+
+  setRubberSheetTransforms("Serial");
+  rubberSheet(testCube, tempDir.path() + "/serialTiles.cub", false);
+
+  setRubberSheetTransforms("Threaded");
+  rubberSheet(testCube, tempDir.path() + "/threadedTiles.cub", false);
+
+  compareCubes(tempDir.path() + "/serialTiles.cub", tempDir.path() + "/threadedTiles.cub");
+}
+
+
+TEST_F(ThreadedRubberSheetCube, ProcessRubberSheetThreadedPatches) {
+  resizeCube(10, 10, 3);
+
+  setRubberSheetTransforms("Serial");
+  rubberSheet(testCube, tempDir.path() + "/serialPatches.cub", true);
+
+  setRubberSheetTransforms("Threaded");
+  rubberSheet(testCube, tempDir.path() + "/threadedPatches.cub", true);
+
+  compareCubes(tempDir.path() + "/serialPatches.cub", tempDir.path() + "/threadedPatches.cub");
+}
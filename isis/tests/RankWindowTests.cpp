@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <vector>
+
+#include <QString>
+
+#include "Buffer.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "ProcessByBoxcar.h"
+#include "RankWindow.h"
+#include "SpecialPixel.h"
+
+#include "TempFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  double low = 2.0;
+  double high = 14.0;
+
+  void sortedMedian(Buffer &in, double &v) {
+    std::vector<double> boxdata;
+    for (int i = 0; i < in.size(); i++) {
+      if (!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
+        boxdata.push_back(in[i]);
+      }
+    }
+    if (boxdata.empty()) {
+      v = in[(in.size() - 1) / 2];
+      return;
+    }
+    std::sort(boxdata.begin(), boxdata.end());
+    v = boxdata[(boxdata.size() - 1) / 2];
+  }
+
+  void windowMedian(RankWindow &window, double &v) {
+    v = (window.count() == 0) ? window.center() : window.median();
+  }
+
+
+  void boxcarMedian(Cube *inCube, QString outPath, int samples, int lines, bool ranked) {
+    ProcessByBoxcar process;
+    process.SetInputCube(inCube);
+    CubeAttributeOutput att;
+    process.SetOutputCube(outPath, att, inCube->sampleCount(), inCube->lineCount(),
+                          inCube->bandCount());
+    process.SetBoxcarSize(samples, lines);
+    if (ranked) {
+      process.StartProcess(windowMedian, low, high);
+    }
+    else {
+      process.StartProcess(sortedMedian);
+    }
+    process.EndProcess();
+  }
+}
+
+
+TEST(RankWindowTests, MatchesSortedBoxcar) {
+  // A strip with repeated values, special pixels and values outside of the valid range
+  int samples = 13;
+  int lines = 9;
+  std::vector<double> data(samples * lines);
+  for (int i = 0; i < samples * lines; i++) {
+    if (i % 11 == 0) {
+      data[i] = Null;
+    }
+    else if (i % 13 == 0) {
+      data[i] = Hrs;
+    }
+    else {
+      data[i] = (i * 7 % 19) / 2.0;
+    }
+  }
+
+  for (int boxSamples = 1; boxSamples <= 6; boxSamples++) {
+    for (int boxLines = 1; boxLines <= 5; boxLines++) {
+      RankWindow window(boxSamples, boxLines, 1.0, 8.5);
+      window.setStrip(data.data(), samples, lines, 1);
+
+      for (int line = 1; line <= lines; line++) {
+        window.moveTo(line);
+        for (int sample = 1; sample <= samples; sample++) {
+          if (sample > 1) {
+            window.next();
+          }
+          ASSERT_EQ(window.sample(), sample);
+          ASSERT_EQ(window.line(), line);
+
+          // Gather the boxcar the way a BoxcarManager positions it
+          std::vector<double> boxdata;
+          double center = Null;
+          int index = 0;
+          for (int j = 0; j < boxLines; j++) {
+            for (int i = 0; i < boxSamples; i++, index++) {
+              int s = sample - (boxSamples - 1) / 2 + i;
+              int l = line - (boxLines - 1) / 2 + j;
+              double value = Null;
+              if (s >= 1 && s <= samples && l >= 1 && l <= lines) {
+                value = data[(l - 1) * samples + s - 1];
+              }
+              if (index == (boxSamples * boxLines - 1) / 2) {
+                center = value;
+              }
+              if (!IsSpecial(value) && value >= 1.0 && value <= 8.5) {
+                boxdata.push_back(value);
+              }
+            }
+          }
+          std::sort(boxdata.begin(), boxdata.end());
+
+          ASSERT_EQ(window.center(), center);
+          ASSERT_EQ(window.count(), (int) boxdata.size());
+          for (int rank = 0; rank < (int) boxdata.size(); rank++) {
+            ASSERT_EQ(window.value(rank), boxdata[rank])
+                << "box " << boxSamples << "x" << boxLines << ", sample " << sample
+                << ", line " << line << ", rank " << rank;
+          }
+          if (boxdata.empty()) {
+            EXPECT_EQ(window.median(), Null);
+          }
+          else {
+            EXPECT_EQ(window.median(), boxdata[(boxdata.size() - 1) / 2]);
+          }
+        }
+      }
+    }
+  }
+}
+
+
+TEST(RankWindowTests, MoveToAnyLine) {
+  // Moving from part way along a line to an earlier line must leave nothing of the old window
+  int samples = 9;
+  int lines = 7;
+  std::vector<double> data(samples * lines);
+  for (int i = 0; i < samples * lines; i++) {
+    data[i] = (i % 5 == 0) ? Null : (i * 5 % 23);
+  }
+
+  RankWindow window(3, 3, 0.0, 20.0);
+  window.setStrip(data.data(), samples, lines, 1);
+  for (int line = lines; line >= 1; line--) {
+    window.moveTo(line);
+    for (int sample = 2; sample <= line; sample++) {
+      window.next();
+    }
+
+    RankWindow expected(3, 3, 0.0, 20.0);
+    expected.setStrip(data.data(), samples, lines, 1);
+    expected.moveTo(line);
+    for (int sample = 2; sample <= line; sample++) {
+      expected.next();
+    }
+
+    ASSERT_EQ(window.count(), expected.count()) << "Line " << line;
+    for (int rank = 0; rank < expected.count(); rank++) {
+      EXPECT_EQ(window.value(rank), expected.value(rank)) << "Line " << line << ", rank " << rank;
+    }
+  }
+}
+
+
+TEST(RankWindowTests, RankOutsideWindow) {
+  std::vector<double> data = {1.0, 2.0, 3.0};
+  RankWindow window(3, 1, -DBL_MAX, DBL_MAX);
+  window.setStrip(data.data(), 3, 1, 1);
+  window.moveTo(1);
+  EXPECT_EQ(window.count(), 2);
+
+  try {
+    window.value(2);
+    FAIL() << "Expected an exception";
+  }
+  catch(IException &e) {
+    EXPECT_THAT(e.toString().toStdString(),
+                ::testing::HasSubstr("The rank [2] is outside of the [2] valid pixels"));
+  }
+}
+
+
+TEST_F(TempTestingFiles, RankWindowMatchesProcessByBoxcar) {
+  // Tall enough to be filtered in several strips of lines
+  Cube inCube;
+  inCube.setDimensions(23, 150, 2);
+  inCube.create(tempDir.path() + "/rankInput.cub");
+  LineManager inLine(inCube);
+  for (inLine.begin(); !inLine.end(); inLine++) {
+    for (int i = 0; i < inLine.size(); i++) {
+      int value = (inLine.Line() * 37 + i * 11 + inLine.Band() * 5) % 17;
+      inLine[i] = (value == 3) ? Null : (value == 5) ? Lis : value;
+    }
+    inCube.write(inLine);
+  }
+
+  int sizes[3][2] = {{3, 3}, {4, 6}, {7, 41}};
+  for (int i = 0; i < 3; i++) {
+    QString sortedPath = tempDir.path() + "/sorted" + QString::number(i) + ".cub";
+    QString rankedPath = tempDir.path() + "/ranked" + QString::number(i) + ".cub";
+    boxcarMedian(&inCube, sortedPath, sizes[i][0], sizes[i][1], false);
+    boxcarMedian(&inCube, rankedPath, sizes[i][0], sizes[i][1], true);
+
+    Cube sortedCube(sortedPath);
+    Cube rankedCube(rankedPath);
+    LineManager sortedLine(sortedCube);
+    LineManager rankedLine(rankedCube);
+    for (sortedLine.begin(), rankedLine.begin(); !sortedLine.end(); sortedLine++, rankedLine++) {
+      sortedCube.read(sortedLine);
+      rankedCube.read(rankedLine);
+      for (int j = 0; j < sortedLine.size(); j++) {
+        ASSERT_EQ(sortedLine[j], rankedLine[j])
+            << "Box " << sizes[i][0] << "x" << sizes[i][1] << ", line " << sortedLine.Line()
+            << ", band " << sortedLine.Band() << ", sample " << j + 1;
+      }
+    }
+  }
+}
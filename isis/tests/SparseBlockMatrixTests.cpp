@@ -0,0 +1,176 @@
+#include <QByteArray>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMapIterator>
+
+#include "LinearAlgebra.h"
+#include "SparseBlockMatrix.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+TEST(SparseBlockMatrix, BlocksInIndexOrder) {
+  SparseBlockColumnMatrix column;
+  column.insertMatrixBlock(7, 3, 3);
+  column.insertMatrixBlock(2, 3, 3);
+  column.insertMatrixBlock(5, 3, 3);
+  column.insertMatrixBlock(2, 6, 6);
+
+  ASSERT_EQ(column.size(), 3);
+  EXPECT_EQ(column.value(2)->size1(), 3);
+  EXPECT_TRUE(column.contains(5));
+  EXPECT_FALSE(column.contains(4));
+  EXPECT_EQ(column.value(4), nullptr);
+  EXPECT_EQ(column.size(), 3);
+
+  QList<int> keys;
+  SparseBlockMapIterator it(column);
+  while ( it.hasNext() ) {
+    it.next();
+    keys.append(it.key());
+  }
+  EXPECT_EQ(keys, QList<int>({2, 5, 7}));
+
+  keys.clear();
+  it.toBack();
+  while ( it.hasPrevious() ) {
+    EXPECT_EQ(it.peekPrevious().key(), it.previous().key());
+    keys.append(it.key());
+  }
+  EXPECT_EQ(keys, QList<int>({7, 5, 2}));
+}
+
+
+TEST(SparseBlockMatrix, SubscriptInsertsNullBlock) {
+  SparseBlockRowMatrix row;
+  row.insertMatrixBlock(1, 3, 6);
+  row.insertMatrixBlock(3, 3, 6);
+
+  EXPECT_EQ(row[2], nullptr);
+  EXPECT_EQ(row.size(), 3);
+  EXPECT_EQ(row.getLeadingColumnsForBlock(3), 6);
+  EXPECT_EQ(row.size(), 4);
+
+  const SparseBlockRowMatrix &constRow = row;
+  EXPECT_EQ(constRow[4], nullptr);
+  EXPECT_EQ(row.size(), 4);
+}
+
+
+TEST(SparseBlockMatrix, CopyAndStream) {
+  SparseBlockMatrix matrix;
+  matrix.setNumberOfColumns(3);
+  for (int column = 0; column < 3; column++) {
+    matrix.at(column)->setStartColumn(2 * column);
+    for (int row = 0; row <= column; row++) {
+      matrix.insertMatrixBlock(column, row, 2, 2);
+      LinearAlgebra::Matrix *block = matrix.getBlock(column, row);
+      for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+          (*block)(i, j) = 10 * column + row + 0.25 * i + 0.5 * j;
+        }
+      }
+    }
+  }
+
+  SparseBlockColumnMatrix copy(*matrix.at(2));
+  ASSERT_EQ(copy.size(), 3);
+  EXPECT_EQ(copy.startColumn(), 4);
+  EXPECT_NE(copy.value(1), matrix.getBlock(2, 1));
+  EXPECT_EQ((*copy.value(1))(1, 1), 21.75);
+
+  QByteArray bytes;
+  {
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out << matrix;
+  }
+  SparseBlockMatrix streamed;
+  QDataStream in(&bytes, QIODevice::ReadOnly);
+  in >> streamed;
+
+  ASSERT_EQ(streamed.size(), 3);
+  EXPECT_EQ(streamed.numberOfBlocks(), 6);
+  for (int column = 0; column < 3; column++) {
+    for (int row = 0; row <= column; row++) {
+      LinearAlgebra::Matrix *block = streamed.getBlock(column, row);
+      ASSERT_NE(block, nullptr);
+      EXPECT_EQ((*block)(1, 0), 10 * column + row + 0.25);
+    }
+  }
+
+  matrix.zeroBlocks();
+  EXPECT_EQ((*matrix.getBlock(2, 1))(1, 1), 0.0);
+  EXPECT_EQ(matrix.numberOfBlocks(), 6);
+}
+
+
+// Zeroes, accumulates into and looks up the blocks of a banded normal equations matrix the way
+// each bundle iteration does, and records the time next to the same work on QMap columns.
+TEST(SparseBlockMatrix, BandedNormalsTiming) {
+  const int columns = 2000;
+  const int bandwidth = 12;
+  const int blockSize = 6;
+  const int passes = 5;
+
+  SparseBlockMatrix sparse;
+  sparse.setNumberOfColumns(columns);
+  QList< QMap<int, LinearAlgebra::Matrix *> > mapped;
+  for (int column = 0; column < columns; column++) {
+    QMap<int, LinearAlgebra::Matrix *> mappedColumn;
+    for (int row = qMax(0, column - bandwidth); row <= column; row++) {
+      sparse.insertMatrixBlock(column, row, blockSize, blockSize);
+      mappedColumn.insert(row, new LinearAlgebra::Matrix(blockSize, blockSize));
+    }
+    mapped.append(mappedColumn);
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  double sparseSum = 0.0;
+  for (int pass = 0; pass < passes; pass++) {
+    sparse.zeroBlocks();
+    for (int column = 0; column < columns; column++) {
+      SparseBlockMapIterator it(*sparse.at(column));
+      while ( it.hasNext() ) {
+        it.next();
+        (*it.value())(0, 0) += it.key();
+      }
+      for (int row = qMax(0, column - bandwidth); row <= column; row++) {
+        sparseSum += (*sparse.at(column)->value(row))(0, 0);
+      }
+    }
+  }
+  qint64 sparseTime = timer.nsecsElapsed();
+
+  timer.restart();
+  double mappedSum = 0.0;
+  for (int pass = 0; pass < passes; pass++) {
+    for (int column = 0; column < columns; column++) {
+      QMapIterator<int, LinearAlgebra::Matrix *> it(mapped[column]);
+      while ( it.hasNext() ) {
+        it.next();
+        it.value()->clear();
+      }
+      it.toFront();
+      while ( it.hasNext() ) {
+        it.next();
+        (*it.value())(0, 0) += it.key();
+      }
+      for (int row = qMax(0, column - bandwidth); row <= column; row++) {
+        mappedSum += (*mapped[column].value(row))(0, 0);
+      }
+    }
+  }
+  qint64 mappedTime = timer.nsecsElapsed();
+
+  for (int column = 0; column < columns; column++) {
+    qDeleteAll(mapped[column]);
+  }
+
+  RecordProperty("SparseBlockMapMicroseconds", (int)(sparseTime / 1000));
+  RecordProperty("QMapMicroseconds", (int)(mappedTime / 1000));
+  EXPECT_EQ(sparseSum, mappedSum);
+  EXPECT_EQ(sparse.numberOfBlocks(), mapped.size() * (bandwidth + 1) - bandwidth * (bandwidth + 1) / 2);
+}
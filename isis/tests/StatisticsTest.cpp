@@ -15,6 +15,10 @@
 
 #include <float.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace Isis;
@@ -203,6 +207,114 @@ TEST(Statistics,ValidRange) {
 
 
 
+TEST(Statistics, ArrayMatchesSingleValues) {
+    // Adding an array takes a faster path for runs of valid pixels; it has to
+    //   give exactly the same results as adding the values one at a time.
+    std::vector<double> data;
+    for (int i = 0; i < 1003; i++) {
+      switch (i % 17) {
+        case 3: data.push_back(Null); break;
+        case 5: data.push_back(Hrs); break;
+        case 7: data.push_back(Lis); break;
+        case 11: data.push_back((i % 2) ? 0.0 : -0.0); break;
+        default: data.push_back(sin(i * 0.37) * 1000.0 / (i % 13 + 1));
+      }
+    }
+
+    for (int range = 0; range < 2; range++) {
+      Statistics arrayStats;
+      Statistics singleStats;
+      if (range) {
+        arrayStats.SetValidRange(-50.0, 300.0);
+        singleStats.SetValidRange(-50.0, 300.0);
+      }
+
+      // Uneven pieces so that arrays start and end in the middle of blocks
+      for (unsigned int start = 0; start < data.size(); start += 101) {
+        unsigned int count = std::min(101u, (unsigned int) data.size() - start);
+        arrayStats.AddData(data.data() + start, count);
+      }
+      for (double value : data) {
+        singleStats.AddData(value);
+      }
+
+      EXPECT_EQ(arrayStats.Sum(), singleStats.Sum());
+      EXPECT_EQ(arrayStats.SumSquare(), singleStats.SumSquare());
+      EXPECT_EQ(arrayStats.Minimum(), singleStats.Minimum());
+      EXPECT_EQ(std::signbit(arrayStats.Minimum()), std::signbit(singleStats.Minimum()));
+      EXPECT_EQ(arrayStats.Maximum(), singleStats.Maximum());
+      EXPECT_EQ(arrayStats.TotalPixels(), singleStats.TotalPixels());
+      EXPECT_EQ(arrayStats.ValidPixels(), singleStats.ValidPixels());
+      EXPECT_EQ(arrayStats.NullPixels(), singleStats.NullPixels());
+      EXPECT_EQ(arrayStats.HrsPixels(), singleStats.HrsPixels());
+      EXPECT_EQ(arrayStats.LisPixels(), singleStats.LisPixels());
+      EXPECT_EQ(arrayStats.OverRangePixels(), singleStats.OverRangePixels());
+      EXPECT_EQ(arrayStats.UnderRangePixels(), singleStats.UnderRangePixels());
+    }
+
+    // A zero maximum is the first zero added, as when adding one at a time
+    double zeros[] = {-5.0, -0.0, -2.0, 0.0, -1.0};
+    Statistics zeroStats;
+    zeroStats.AddData(zeros, 5);
+    EXPECT_EQ(zeroStats.Maximum(), 0.0);
+    EXPECT_TRUE(std::signbit(zeroStats.Maximum()));
+}
+
+TEST(Statistics, Merge) {
+    double a[] = {1.0, Null, 3.0, 8.0, His};
+    double b[] = {-2.0, Lrs, 12.0, 5.0};
+
+    Statistics all;
+    all.SetValidRange(-1.0, 10.0);
+    all.AddData(a, 5);
+    all.AddData(b, 4);
+
+    Statistics first;
+    first.SetValidRange(-1.0, 10.0);
+    first.AddData(a, 5);
+    Statistics second;
+    second.SetValidRange(-1.0, 10.0);
+    second.AddData(b, 4);
+    first.merge(second);
+
+    EXPECT_DOUBLE_EQ(first.Sum(), all.Sum());
+    EXPECT_DOUBLE_EQ(first.SumSquare(), all.SumSquare());
+    EXPECT_DOUBLE_EQ(first.Variance(), all.Variance());
+    EXPECT_DOUBLE_EQ(first.Minimum(), 1.0);
+    EXPECT_DOUBLE_EQ(first.Maximum(), 8.0);
+    EXPECT_EQ(first.TotalPixels(), 9);
+    EXPECT_EQ(first.ValidPixels(), 4);
+    EXPECT_EQ(first.NullPixels(), 1);
+    EXPECT_EQ(first.HisPixels(), 1);
+    EXPECT_EQ(first.LrsPixels(), 1);
+    EXPECT_EQ(first.OverRangePixels(), 1);
+    EXPECT_EQ(first.UnderRangePixels(), 1);
+
+    Statistics otherRange;
+    otherRange.SetValidRange(0.0, 10.0);
+    EXPECT_THROW(first.merge(otherRange), IException);
+}
+
+TEST(Statistics, MergeCompensated) {
+    // Adding 1.0 to 1e16 rounds back to 1e16, so only a compensated merge keeps the ones
+    Statistics merged;
+    merged.AddData(1.0e16);
+    Statistics one;
+    one.AddData(1.0);
+    for (int i = 0; i < 10; i++) {
+      merged.merge(one);
+    }
+
+    EXPECT_EQ(merged.Sum(), 1.0e16 + 10.0);
+    EXPECT_EQ(merged.ValidPixels(), 11);
+    EXPECT_EQ(merged.Average(), (1.0e16 + 10.0) / 11.0);
+
+    Statistics copy(merged);
+    EXPECT_EQ(copy.Sum(), merged.Sum());
+    merged.Reset();
+    EXPECT_EQ(merged.Sum(), 0.0);
+}
+
 TEST(Statistics,XMLReadWrite) {
 
     Statistics s;